@@ -1,47 +1,47 @@
-#include "affichage.h";
+#include "affichage.h"
 
 
-void CommandesPresentes(Commandes* commandes) {
+void CommandesPresentes(const Sortie* s, Commandes* commandes) {
 	for (int i = 0; i < commandes->nbElements; ++i) {
-		Commande* commande = commandes->elements[i];
-		if (strcmp(commande->nom_commande, "KI") == 0){
-			printf("KI (B->R) ");
+		Commande* commande = &commandes->elements[i];
+		if (strcmp(commande->nom_commande.texte, "KI") == 0){
+			imprimer(s, "KI (B->R) ");
 		}
-		else if (strcmp(commande->nom_commande, "LO") == 0) {
-			printf("LO (B<-R) ");
+		else if (strcmp(commande->nom_commande.texte, "LO") == 0) {
+			imprimer(s, "LO (B<-R) ");
 		}
-		else if (strcmp(commande->nom_commande, "SO") == 0) {
-			printf("SO (B<->R) ");
+		else if (strcmp(commande->nom_commande.texte, "SO") == 0) {
+			imprimer(s, "SO (B<->R) ");
 		}
-		else if (strcmp(commande->nom_commande, "NI") == 0) {
-			printf("NI (B ^) ");
+		else if (strcmp(commande->nom_commande.texte, "NI") == 0) {
+			imprimer(s, "NI (B ^) ");
 		}
-		else if (strcmp(commande->nom_commande, "MA") == 0) {
-			printf("MA (R ^) ");
+		else if (strcmp(commande->nom_commande.texte, "MA") == 0) {
+			imprimer(s, "MA (R ^) ");
 		}
 
 		if (i != commandes->nbElements - 1) {
-			printf("| ");
+			imprimer(s, "| ");
 		}
 	}
-	printf("\n\n");
+	imprimer(s, "\n\n");
 }
-void ordreExistePas() {
-	printf("Ordre n'existe pas\n\n");
+void ordreExistePas(const Sortie* s) {
+	imprimer(s, "Ordre n'existe pas\n\n");
 }
 
-void ordreErreur() {
-	printf("Impossible d'executer\n\n");
+void ordreErreur(const Sortie* s) {
+	imprimer(s, "Impossible d'executer\n\n");
 }
 
-void ordreIncorect(Joueur* j) {
-	printf("La sequence ne conduit pas a la situation attendue -- %s ne peut plus jouer durant ce tour\n\n", j->nom);
+void ordreIncorect(const Sortie* s, Joueur* j) {
+	imprimer(s, "La sequence ne conduit pas a la situation attendue -- %s ne peut plus jouer durant ce tour\n\n", j->nom.texte);
 }
 
-void joueurPeutPasJouer(Joueur* j) {
-	printf("%s ne peut pas jouer\n", j->nom);
+void joueurPeutPasJouer(const Sortie* s, Joueur* j) {
+	imprimer(s, "%s ne peut pas jouer\n", j->nom.texte);
 }
-void afficherPodiums(Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium* target_r) {
+void afficherPodiums(const Sortie* s, Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium* target_r) {
 	int max = maxTaillePodiums(b, r, target_b, target_r);
 
 	int max_bleu = trouverAnimalPlusLongue(a, b, 0);
@@ -54,53 +54,49 @@ void afficherPodiums(Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium*
 		
 		
 		if (niveau < b->nbElements) {
-			int* p = obtenir(b, niveau);
-			Animal* an = obtenirAnimal(a, *p);
-			printf("%-*s", max_bleu+2, an->nom_animal);
+			Animal* an = obtenirAnimal(a, b->elements[niveau]);
+			imprimer(s, "%-*s", max_bleu+2, an->nom_animal.texte);
 			
 		}
 		else {
-			printf("%-*s", max_bleu+2, "");
+			imprimer(s, "%-*s", max_bleu+2, "");
 		}
 
 		
 
 		
 		if (r && niveau < r->nbElements) {
-			int* p = (int*)obtenir(r, niveau);
-			Animal* an = (p ? obtenirAnimal(a, *p) : NULL);
-			printf("%-*s", max_rouge+6, an->nom_animal );
+			Animal* an = obtenirAnimal(a, r->elements[niveau]);
+			imprimer(s, "%-*s", max_rouge+6, an->nom_animal.texte );
 		}
 		else {
-			printf("%-*s",max_rouge+6, "");
+			imprimer(s, "%-*s",max_rouge+6, "");
 		}
 
 		
 
 		
 		if (target_b && niveau < target_b->nbElements) {
-			int* p = (int*)obtenir(target_b, niveau);
-			Animal* an = (p ? obtenirAnimal(a, *p) : NULL);
-			printf("%-*s", max_target_bleu+2, an->nom_animal);
+			Animal* an = obtenirAnimal(a, target_b->elements[niveau]);
+			imprimer(s, "%-*s", max_target_bleu+2, an->nom_animal.texte);
 		}
 		else {
-			printf("%-*s", max_target_bleu+2, "");
+			imprimer(s, "%-*s", max_target_bleu+2, "");
 		}
 
 		
 
 		if (target_r && niveau < target_r->nbElements) {
-			int* p = (int*)obtenir(target_r, niveau);
-			Animal* an = (p ? obtenirAnimal(a, *p) : NULL);
-			printf("%-*s", max_target_rouge+2, an->nom_animal);
+			Animal* an = obtenirAnimal(a, target_r->elements[niveau]);
+			imprimer(s, "%-*s", max_target_rouge+2, an->nom_animal.texte);
 		}
 		else {
-			printf("%-*s", max_target_rouge+2, "");
+			imprimer(s, "%-*s", max_target_rouge+2, "");
 		}
 
-		printf("\n");
+		imprimer(s, "\n");
 	}
-	printf(
+	imprimer(s,
 		"%-*s%-*s%-*s%-*s%-*s\n",
 		max_bleu + 2, "----",
 		max_rouge + 2, "----",
@@ -108,7 +104,7 @@ void afficherPodiums(Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium*
 		max_target_bleu + 2, "----",
 		max_target_rouge + 2, "----"
 	);
-	printf("%-*s%-*s%-*s%-*s\n",
+	imprimer(s, "%-*s%-*s%-*s%-*s\n",
 		max_bleu + 2, "BLEU",
 		max_rouge + 6, "ROUGE",
 		max_target_bleu + 2, "BLEU",
@@ -116,24 +112,86 @@ void afficherPodiums(Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium*
 	
 }
 
-void gagnerPoint(char* j, int situation) {
+void gagnerPoint(const Sortie* s, const char* j, int situation) {
 	if (situation == 0) {
-		printf("%s gagne un point\n", j);
+		imprimer(s, "%s gagne un point\n", j);
 	}
 	else {
-		printf("%s gagne un point car lui seul peut encore jouer durant ce tour\n", j);
+		imprimer(s, "%s gagne un point car lui seul peut encore jouer durant ce tour\n", j);
 	}
 }
 
+void afficherRang(const Sortie* s, Joueur* j, Joueurs* joueurs) {
+	imprimer(s, "%s est %d/%d au classement (%d points)\n\n", j->nom.texte, rangJoueur(joueurs, j), (int)joueurs->nbElements, j->points);
+}
+void afficherResultats(const Sortie* s, Joueurs* joueurs) {
+	for (int i = 0; i < joueurs->nbElements; ++i) {
+		Joueur* j = obtenirJoueur(joueurs, i);
+		imprimer(s, "%s %d\n", j->nom.texte, j->points);
+	}
+	imprimer(s, "\n\n");
+}
+
+void afficherLatences(const Sortie* s, Joueurs* joueurs) {
+	for (int i = 0; i < joueurs->nbElements; ++i) {
+		Joueur* j = obtenirJoueur(joueurs, i);
+		unsigned long long moyenne = j->nb_coups ? j->latence_totale / j->nb_coups : 0;
+		imprimer(s, "%s : %d coups, %llu ms en moyenne, dernier en %llu ms\n",
+			j->nom.texte, j->nb_coups, moyenne, (unsigned long long)j->derniere_latence);
+	}
+	imprimer(s, "\n");
+}
+
+void afficherCentiles(const Sortie* s, const char* nom, const Histogramme* h) {
+	double moyenne = h->nb ? (double)h->somme / (double)h->nb / 1000.0 : 0.0;
+	imprimer(s, "%s : %llu mesures, moyenne %.1f us, p50 %.1f us, p99 %.1f us, p99.9 %.1f us, max %.1f us\n",
+		nom, (unsigned long long)h->nb, moyenne,
+		(double)centileHistogramme(h, 50.0) / 1000.0, (double)centileHistogramme(h, 99.0) / 1000.0,
+		(double)centileHistogramme(h, 99.9) / 1000.0, (double)h->max / 1000.0);
+}
+
+void afficherMemoire(const Sortie* s) {
+	BilanMemoire total = { 0, 0, 0 };
+	for (int i = 0; i < NB_SOUS_SYSTEMES; ++i) {
+		BilanMemoire b = bilanMemoire((SousSysteme)i);
+		imprimer(s, "Memoire %s : %lld octets (pic %lld), %lld allocations\n",
+			nomSousSysteme((SousSysteme)i), (long long)b.vivants, (long long)b.pic, (long long)b.nb_allocations);
+		total.vivants += b.vivants;
+		total.pic += b.pic;
+		total.nb_allocations += b.nb_allocations;
+	}
+	/* les pics ne sont pas simultanés : leur somme majore le pic total */
+	imprimer(s, "Memoire totale : %lld octets (pics cumules %lld), %lld allocations\n\n",
+		(long long)total.vivants, (long long)total.pic, (long long)total.nb_allocations);
+}
+
+void afficherStatistiquesCache(const Sortie* s, const StatistiquesCache* stats) {
+	double taux = stats->consultations ? 100.0 * (double)stats->succes / (double)stats->consultations : 0.0;
+	imprimer(s, "Cache : %llu consultations, %llu succes (%.1f %%), %llu evictions, %lld entrees, %llu octets\n",
+		(unsigned long long)stats->consultations, (unsigned long long)stats->succes, taux,
+		(unsigned long long)stats->evictions, (long long)stats->nb_entrees, (unsigned long long)stats->octets);
+}
+
+void tempsEcoule(const Sortie* s) {
+	imprimer(s, "Temps ecoule -- nouvelles cartes\n\n");
+}
+
+void lancementErrorCommande(const Sortie* s) {
+	imprimer(s, "A lancement du code, on n'a pas pu indentifier la commande\n");
+}
+
+void pasAssesDesJoueurs(const Sortie* s) {
+	imprimer(s, "!!Verifier le nombre des joueurs!!\n");
+}
 
-void lancementErrorCommande() {
-	printf("A lancement du code, on n'a pas pu indentifier la commande\n");
+void joueurJouePas(const Sortie* s) {
+	imprimer(s, "Il n'existe pas de joueur avec ce nom ):\n");
 }
 
-void pasAssesDesJoueurs() {
-	printf("!!Verifier le nombre des joueurs!!\n");
+void salleInexistante(const Sortie* s, int salle) {
+	imprimer(s, "La salle %d n'existe pas\n", salle);
 }
 
-void joueurJouePas() {
-	printf("Il n'existe pas de joueur avec ce nom ):\n");
+void salleDejaOuverte(const Sortie* s, int salle) {
+	imprimer(s, "La salle %d est deja ouverte\n", salle);
 }
\ No newline at end of file
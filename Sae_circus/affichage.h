@@ -2,74 +2,147 @@
 /**
  * @file affichage.h
  * @brief Fonctions d’affichage pour le jeu (commandes, podiums, résultats).
+ *
+ * Toutes les fonctions écrivent sur la sortie `s` fournie (voir `sortie.h`).
  */
 
 #pragma once
+#include "cache.h"
 #include "config.h"
+#include "sortie.h"
+#include "histogramme.h"
+#include "memoire.h"
 
 /**
  * @brief Affiche la liste des commandes présentes sous forme compacte.
+ * @param s Sortie sur laquelle écrire.
  * @param commandes Conteneur des commandes à afficher.
  */
-void CommandesPresentes(Commandes* commandes);
+void CommandesPresentes(const Sortie* s, Commandes* commandes);
 
 /**
  * @brief Affiche un message indiquant qu’un ordre n’existe pas.
+ * @param s Sortie sur laquelle écrire.
  */
-void ordreExistePas(void);
+void ordreExistePas(const Sortie* s);
 
 /**
  * @brief Affiche un message indiquant qu’un ordre ne peut pas être exécuté.
+ * @param s Sortie sur laquelle écrire.
  */
-void ordreErreur(void);
+void ordreErreur(const Sortie* s);
 
 /**
  * @brief Indique qu’une séquence ne mène pas à la situation attendue et que le joueur ne peut plus jouer durant ce tour.
+ * @param s Sortie sur laquelle écrire.
  * @param j Joueur concerné.
  */
-void ordreIncorect(Joueur* j);
+void ordreIncorect(const Sortie* s, Joueur* j);
 
 /**
- * @brief Indique que le joueur ne peut pas jouer (version basée sur le nom).
- * @param j Nom du joueur (chaîne C).
+ * @brief Indique que le joueur ne peut pas jouer.
+ * @param s Sortie sur laquelle écrire.
+ * @param j Joueur concerné.
  */
-void joueurPeutPasJouer(char* j);
+void joueurPeutPasJouer(const Sortie* s, Joueur* j);
 
 /**
  * @brief Affiche en colonnes la disposition des podiums (Bleu/Rouge) et des cibles (Bleu/Rouge).
+ * @param s        Sortie sur laquelle écrire.
  * @param a        Référentiel des animaux (pour les noms).
  * @param b        Podium Bleu courant.
  * @param r        Podium Rouge courant.
  * @param target_b Podium Bleu objectif.
  * @param target_r Podium Rouge objectif.
  */
-void afficherPodiums(Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium* target_r);
+void afficherPodiums(const Sortie* s, Animaux* a, Podium* b, Podium* r, Podium* target_b, Podium* target_r);
 
 /**
  * @brief Affiche l’attribution d’un point à un joueur.
+ * @param s         Sortie sur laquelle écrire.
  * @param j         Nom du joueur (chaîne C).
  * @param situation Indicateur de situation (0 : point normal ; autre : point car lui seul peut encore jouer).
  */
-void gagnerPoint(char* j, int situation);
+void gagnerPoint(const Sortie* s, const char* j, int situation);
+
+/**
+ * @brief Affiche le rang d’un joueur dans le classement après un point.
+ * @param s       Sortie sur laquelle écrire.
+ * @param j       Joueur concerné.
+ * @param joueurs Ensemble des joueurs (classement).
+ */
+void afficherRang(const Sortie* s, Joueur* j, Joueurs* joueurs);
 
 /**
- * @brief Affiche les résultats (scores) pour l’ensemble des joueurs.
+ * @brief Affiche les résultats (scores) pour l’ensemble des joueurs, dans l’ordre du classement.
+ * @param s Sortie sur laquelle écrire.
  * @param joueurs Ensemble des joueurs.
  */
-void afficherResultats(Joueurs* joueurs);
+void afficherResultats(const Sortie* s, Joueurs* joueurs);
+
+/**
+ * @brief Affiche, pour chaque joueur, le nombre de coups et les temps de réponse.
+ * @param s Sortie sur laquelle écrire.
+ * @param joueurs Ensemble des joueurs.
+ */
+void afficherLatences(const Sortie* s, Joueurs* joueurs);
+
+/**
+ * @brief Affiche le nombre de mesures, la moyenne, les centiles p50, p99 et p99,9 et le maximum d’un histogramme (en µs).
+ * @param s Sortie sur laquelle écrire.
+ * @param nom Nom de la mesure.
+ * @param h Histogramme de latences (ns).
+ */
+void afficherCentiles(const Sortie* s, const char* nom, const Histogramme* h);
+
+/**
+ * @brief Affiche, pour chaque sous-système puis au total, les octets vivants, leur pic et le nombre d’allocations.
+ * @param s Sortie sur laquelle écrire.
+ */
+void afficherMemoire(const Sortie* s);
+
+/**
+ * @brief Affiche les compteurs d’un cache de résultats (taux de succès, mémoire).
+ * @param s Sortie sur laquelle écrire.
+ * @param stats Compteurs du cache.
+ */
+void afficherStatistiquesCache(const Sortie* s, const StatistiquesCache* stats);
+
+/**
+ * @brief Indique que le délai du tour est écoulé et que les cartes sont redistribuées.
+ * @param s Sortie sur laquelle écrire.
+ */
+void tempsEcoule(const Sortie* s);
 
 /**
  * @brief Affiche un message d’erreur lors de l’identification de la commande au lancement.
+ * @param s Sortie sur laquelle écrire.
  */
-void lancementErrorCommande(void);
+void lancementErrorCommande(const Sortie* s);
 
 /**
  * @brief Affiche un message si le nombre de joueurs est insuffisant.
+ * @param s Sortie sur laquelle écrire.
  */
-void pasAssesDesJoueurs(void);
+void pasAssesDesJoueurs(const Sortie* s);
 
 /**
  * @brief Indique qu’aucun joueur correspondant au nom fourni n’existe.
+ * @param s Sortie sur laquelle écrire.
  */
-void joueurJouePas(void);
+void joueurJouePas(const Sortie* s);
 
+
+/**
+ * @brief Indique qu’aucune salle ne porte l’identifiant fourni (mode serveur).
+ * @param s Sortie sur laquelle écrire.
+ * @param salle Identifiant demandé.
+ */
+void salleInexistante(const Sortie* s, int salle);
+
+/**
+ * @brief Indique qu’une salle portant cet identifiant est déjà ouverte (mode serveur).
+ * @param s Sortie sur laquelle écrire.
+ * @param salle Identifiant demandé.
+ */
+void salleDejaOuverte(const Sortie* s, int salle);
@@ -0,0 +1,54 @@
+#include <assert.h>
+#include <time.h>
+
+#include "aleatoire.h"
+
+
+static uint64_t splitmix64(uint64_t* x) {
+	uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+static uint64_t rotl(uint64_t x, int k) {
+	return (x << k) | (x >> (64 - k));
+}
+
+void initAleatoire(Aleatoire* a, uint64_t graine) {
+	for (int i = 0; i < 4; ++i) {
+		a->s[i] = splitmix64(&graine);
+	}
+}
+
+uint64_t aleatoireSuivant(Aleatoire* a) {
+	uint64_t* s = a->s;
+	uint64_t resultat = rotl(s[1] * 5, 7) * 9;
+	uint64_t t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return resultat;
+}
+
+uint64_t aleatoireBorne(Aleatoire* a, uint64_t n) {
+	assert(n > 0);
+	uint64_t seuil = (0 - n) % n;
+	uint64_t x;
+	do {
+		x = aleatoireSuivant(a);
+	} while (x < seuil);
+	return x % n;
+}
+
+uint64_t graineHorloge(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	uint64_t graine = ((uint64_t)ts.tv_sec << 32) ^ (uint64_t)ts.tv_nsec;
+	return splitmix64(&graine);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file aleatoire.h
+ * @brief Générateur pseudo-aléatoire rapide et reproductible, propre à chaque partie.
+ *
+ * Le générateur est un xoshiro256** initialisé par splitmix64 à partir d’une graine
+ * 64 bits. Son état est stocké dans la partie : deux parties ne partagent rien,
+ * et une même graine rejoue exactement la même suite de cartes.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief État du générateur.
+ */
+typedef struct {
+    uint64_t s[4];
+} Aleatoire;
+
+/**
+ * @brief Initialise le générateur à partir d’une graine.
+ *
+ * @param[out] a Générateur à initialiser.
+ * @param[in] graine Graine 64 bits (toute valeur est acceptée, y compris 0).
+ */
+void initAleatoire(Aleatoire* a, uint64_t graine);
+
+/**
+ * @brief Retourne le prochain entier 64 bits de la suite.
+ *
+ * @param[in,out] a Générateur.
+ * @return Un entier uniformément distribué sur 64 bits.
+ */
+uint64_t aleatoireSuivant(Aleatoire* a);
+
+/**
+ * @brief Tire un entier uniformément dans `[0, n - 1]`, sans biais de modulo.
+ *
+ * Les tirages situés sous le seuil `2^64 mod n` sont rejetés, ce qui rend
+ * toutes les valeurs équiprobables quelle que soit `n`.
+ *
+ * @param[in,out] a Générateur.
+ * @param[in] n Borne exclusive.
+ * @return Un entier dans `[0, n - 1]`.
+ * @pre `n > 0`.
+ */
+uint64_t aleatoireBorne(Aleatoire* a, uint64_t n);
+
+/**
+ * @brief Construit une graine à partir de l’horloge.
+ *
+ * @return Une graine variant d’un lancement à l’autre.
+ */
+uint64_t graineHorloge(void);
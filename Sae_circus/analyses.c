@@ -0,0 +1,181 @@
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "analyses.h"
+#include "trace.h"
+
+
+/* ajoute du texte formaté à la ligne en construction ; `*reste` suit la place libre */
+static void ajouterTexte(char** curseur, size_t* reste, const char* format, ...) {
+	va_list args;
+	va_start(args, format);
+	int n = vsnprintf(*curseur, *reste, format, args);
+	va_end(args);
+	if (n < 0) return;
+	size_t ecrit = (size_t)n < *reste ? (size_t)n : *reste - 1;
+	*curseur += ecrit;
+	*reste -= ecrit;
+}
+
+static void ajouterPodiumJson(char** curseur, size_t* reste, const uint8_t* animaux, int nb) {
+	ajouterTexte(curseur, reste, "[");
+	for (int i = 0; i < nb; ++i) {
+		ajouterTexte(curseur, reste, i ? ",%d" : "%d", animaux[i]);
+	}
+	ajouterTexte(curseur, reste, "]");
+}
+
+/* le nom d’un joueur est libre : guillemets, barres obliques inverses et caractères de contrôle sont échappés */
+static void ajouterChaineJson(char** curseur, size_t* reste, const char* texte) {
+	ajouterTexte(curseur, reste, "\"");
+	for (const char* c = texte; *c; ++c) {
+		unsigned char u = (unsigned char)*c;
+		if (u == '"' || u == '\\') ajouterTexte(curseur, reste, "\\%c", u);
+		else if (u < 0x20) ajouterTexte(curseur, reste, "\\u%04x", u);
+		else ajouterTexte(curseur, reste, "%c", u);
+	}
+	ajouterTexte(curseur, reste, "\"");
+}
+
+int ecrireBilanJson(const BilanTour* bilan, Tampon* ligne) {
+	static const char* const fins[] = { "gagne", "dernier", "delai" };
+	/* tailles bornées : podiums, nom échappé (6 octets par caractère au pire) et instants tiennent largement */
+	char texte[2048];
+	char* curseur = texte;
+	size_t reste = sizeof(texte);
+
+	ajouterTexte(&curseur, &reste, "{\"partie\":%d,\"tour\":%llu,\"carte\":%d,\"cible\":%d,",
+		bilan->partie, (unsigned long long)bilan->tour, bilan->carte, bilan->cible);
+	if (bilan->nb_animaux > 0) {
+		ajouterTexte(&curseur, &reste, "\"depart\":{\"b\":");
+		ajouterPodiumJson(&curseur, &reste, bilan->depart_b, bilan->nb_depart_b);
+		ajouterTexte(&curseur, &reste, ",\"r\":");
+		ajouterPodiumJson(&curseur, &reste, bilan->depart_r, bilan->nb_depart_r);
+		ajouterTexte(&curseur, &reste, "},\"arrivee\":{\"b\":");
+		ajouterPodiumJson(&curseur, &reste, bilan->arrivee_b, bilan->nb_arrivee_b);
+		ajouterTexte(&curseur, &reste, ",\"r\":");
+		ajouterPodiumJson(&curseur, &reste, bilan->arrivee_r, bilan->nb_arrivee_r);
+		ajouterTexte(&curseur, &reste, "},");
+	}
+	else {
+		ajouterTexte(&curseur, &reste, "\"depart\":null,\"arrivee\":null,");
+	}
+	if (bilan->distance >= 0) ajouterTexte(&curseur, &reste, "\"distance\":%d,", bilan->distance);
+	else ajouterTexte(&curseur, &reste, "\"distance\":null,");
+	ajouterTexte(&curseur, &reste, "\"fin\":\"%s\",\"gagnant\":", fins[bilan->fin]);
+	if (bilan->gagnant[0]) ajouterChaineJson(&curseur, &reste, bilan->gagnant);
+	else ajouterTexte(&curseur, &reste, "null");
+	if (bilan->longueur >= 0) ajouterTexte(&curseur, &reste, ",\"longueur\":%d", bilan->longueur);
+	else ajouterTexte(&curseur, &reste, ",\"longueur\":null");
+	ajouterTexte(&curseur, &reste, ",\"duree_ms\":%llu,\"echecs\":%d,\"echecs_ms\":[",
+		(unsigned long long)bilan->duree_ms, bilan->nb_echecs);
+	int nb = bilan->nb_echecs < MAX_ECHECS_ANALYSE ? bilan->nb_echecs : MAX_ECHECS_ANALYSE;
+	for (int i = 0; i < nb; ++i) {
+		ajouterTexte(&curseur, &reste, i ? ",%u" : "%u", (unsigned)bilan->echecs_ms[i]);
+	}
+	ajouterTexte(&curseur, &reste, "]}\n");
+	return ajouterTampon(ligne, texte, (size_t)(curseur - texte));
+}
+
+static int boucleAnalyses(void* arg) {
+	Analyses* a = (Analyses*)arg;
+	nommerFilTrace("analyses");
+	BilanTour* lot = a->lot;
+	Tampon texte;
+	initTampon(&texte);
+
+	mtx_lock(&a->verrou);
+	for (;;) {
+		while (!a->arret && a->nb == 0) {
+			cnd_wait(&a->signal, &a->verrou);
+		}
+		if (a->nb == 0) break;
+		/* le lot est copié hors de la file : les parties publient pendant la mise en forme */
+		int nb = 0;
+		while (a->nb > 0) {
+			lot[nb++] = a->file[a->tete];
+			a->tete = (a->tete + 1) % a->capacite;
+			--a->nb;
+		}
+		mtx_unlock(&a->verrou);
+
+		debutTrace("ecriture analyses");
+		texte.taille = 0;
+		int ok = 1;
+		for (int i = 0; i < nb && ok; ++i) {
+			ok = ecrireBilanJson(&lot[i], &texte);
+		}
+		ok = ok && fwrite(texte.donnees, 1, texte.taille, a->fichier) == texte.taille && fflush(a->fichier) == 0;
+		finTrace("ecriture analyses");
+
+		mtx_lock(&a->verrou);
+		if (ok) a->nb_ecrits += (uint64_t)nb;
+		else a->erreur = 1;
+	}
+	mtx_unlock(&a->verrou);
+	detruireTampon(&texte);
+	return 0;
+}
+
+int ouvrirAnalyses(Analyses* a, const char* chemin, int capacite) {
+	a->file = (BilanTour*)malloc(sizeof(BilanTour) * (size_t)capacite);
+	a->lot = (BilanTour*)malloc(sizeof(BilanTour) * (size_t)capacite);
+	a->fichier = a->file && a->lot ? fopen(chemin, "ab") : NULL;
+	if (!a->fichier) {
+		free(a->file);
+		free(a->lot);
+		return 0;
+	}
+	a->capacite = capacite;
+	a->tete = 0;
+	a->nb = 0;
+	a->arret = 0;
+	a->erreur = 0;
+	a->nb_ecrits = 0;
+	a->nb_perdus = 0;
+	mtx_init(&a->verrou, mtx_plain);
+	cnd_init(&a->signal);
+	if (thrd_create(&a->fil, boucleAnalyses, a) != thrd_success) {
+		cnd_destroy(&a->signal);
+		mtx_destroy(&a->verrou);
+		fclose(a->fichier);
+		free(a->file);
+		free(a->lot);
+		return 0;
+	}
+	return 1;
+}
+
+int publierBilan(Analyses* a, const BilanTour* bilan) {
+	mtx_lock(&a->verrou);
+	if (a->nb == a->capacite) {
+		++a->nb_perdus;
+		mtx_unlock(&a->verrou);
+		return 0;
+	}
+	a->file[(a->tete + a->nb) % a->capacite] = *bilan;
+	int premier = a->nb++ == 0;
+	mtx_unlock(&a->verrou);
+	if (premier) cnd_signal(&a->signal);
+	return 1;
+}
+
+int fermerAnalyses(Analyses* a) {
+	mtx_lock(&a->verrou);
+	a->arret = 1;
+	mtx_unlock(&a->verrou);
+	cnd_broadcast(&a->signal);
+	thrd_join(a->fil, NULL);
+
+	int ok = !a->erreur;
+	if (fclose(a->fichier) != 0) ok = 0;
+	a->fichier = NULL;
+	free(a->file);
+	free(a->lot);
+	a->file = NULL;
+	a->lot = NULL;
+	cnd_destroy(&a->signal);
+	mtx_destroy(&a->verrou);
+	return ok;
+}
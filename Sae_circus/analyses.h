@@ -0,0 +1,121 @@
+/**
+ * @file analyses.h
+ * @brief Flux d’analyses des tours, un enregistrement JSON par ligne (JSONL).
+ *
+ * À la fin de chaque tour, la partie publie un bilan de taille fixe : cartes de
+ * départ et cible, distance optimale, gagnant, longueur de la séquence gagnante,
+ * tentatives échouées et leurs instants. La publication copie le bilan dans une
+ * file bornée, sous un verrou tenu le temps de la copie ; un fil d’écriture le
+ * met en forme et l’écrit ensuite. Quand la file est pleine, le bilan est perdu
+ * et compté : les analyses ne ralentissent jamais la partie.
+ *
+ * Exemple de ligne :
+ * `{"partie":0,"tour":3,"carte":12,"cible":40,"depart":{"b":[0,2],"r":[1]},"arrivee":{"b":[1],"r":[0,2]},`
+ * `"distance":4,"fin":"gagne","gagnant":"alice","longueur":5,"duree_ms":1234,"echecs":2,"echecs_ms":[300,800]}`
+ *
+ * Les animaux sont désignés par leur indice dans la configuration. `distance` vaut
+ * `null` si la table des distances n’a pas pu être allouée ou si la cible est
+ * hors d’atteinte ; `gagnant` et `longueur` valent `null` pour un tour
+ * écoulé. Seuls les `MAX_ECHECS_ANALYSE` premiers échecs ont leur instant.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <threads.h>
+#include "etat.h"
+#include "sortie.h"
+
+enum {
+    CAPACITE_ANALYSES_DEFAUT = 1024, /**< Bilans en attente d’écriture, par défaut. */
+    MAX_ECHECS_ANALYSE = 16,         /**< Échecs dont l’instant est conservé. */
+    LONGUEUR_NOM_ANALYSE = 48        /**< Taille du nom du gagnant, zéro final compris (tronqué au-delà). */
+};
+
+/**
+ * @brief Fin d’un tour.
+ */
+typedef enum {
+    FIN_GAGNE,    /**< Un joueur a atteint la cible. */
+    FIN_DERNIER,  /**< Tous les autres joueurs ont échoué : le dernier marque sans jouer (s’il n’est pas bloqué). */
+    FIN_DELAI     /**< Temps écoulé, personne ne marque. */
+} FinTour;
+
+/**
+ * @brief Bilan d’un tour.
+ */
+typedef struct {
+    int partie;                /**< Identifiant de la partie (salle du serveur). */
+    uint64_t tour;             /**< Numéro du tour dans la partie. */
+    int carte;                 /**< Indice de la carte de départ dans le paquet. */
+    int cible;                 /**< Indice de la carte cible. */
+    int nb_animaux;            /**< Animaux décrits par les podiums ci-dessous, `0` au-delà de `MAX_ANIMAUX_CLE`. */
+    uint8_t depart_b[MAX_ANIMAUX_CLE], depart_r[MAX_ANIMAUX_CLE];
+    uint8_t arrivee_b[MAX_ANIMAUX_CLE], arrivee_r[MAX_ANIMAUX_CLE];
+    uint8_t nb_depart_b, nb_depart_r, nb_arrivee_b, nb_arrivee_r;
+    int distance;              /**< Distance optimale du départ à la cible (minorant si la table des distances est incomplète), `-1` si inconnue ou infinie. */
+    FinTour fin;
+    char gagnant[LONGUEUR_NOM_ANALYSE]; /**< Nom du gagnant, vide pour un tour écoulé. */
+    int longueur;              /**< Commandes de la séquence gagnante, `-1` sans séquence. */
+    uint64_t debut_ms;         /**< Heure de la distribution (ms, horloge monotone). */
+    uint64_t duree_ms;         /**< Durée du tour. */
+    int nb_echecs;             /**< Tentatives refusées ou échouées. */
+    uint32_t echecs_ms[MAX_ECHECS_ANALYSE]; /**< Instants des premiers échecs depuis la distribution (ms). */
+} BilanTour;
+
+/**
+ * @brief Fichier d’analyses, sa file bornée et son fil d’écriture.
+ */
+typedef struct {
+    FILE* fichier;
+    thrd_t fil;
+    mtx_t verrou;          /**< Protège la file, `arret` et les compteurs. */
+    cnd_t signal;          /**< Signalé à l’arrivée d’un bilan dans une file vide et à la fermeture. */
+    BilanTour* file;       /**< File circulaire de `capacite` bilans. */
+    BilanTour* lot;        /**< Bilans retirés de la file, en cours d’écriture (fil d’écriture). */
+    int capacite;
+    int tete;              /**< Indice du plus ancien bilan en attente. */
+    int nb;                /**< Bilans en attente. */
+    int arret;
+    int erreur;            /**< `1` si une écriture a échoué. */
+    uint64_t nb_ecrits;    /**< Bilans écrits. */
+    uint64_t nb_perdus;    /**< Bilans perdus, la file étant pleine. */
+} Analyses;
+
+/**
+ * @brief Ouvre (ou crée) le fichier d’analyses en ajout et démarre son fil d’écriture.
+ *
+ * @param[out] a Analyses.
+ * @param[in] chemin Fichier JSONL.
+ * @param[in] capacite Nombre maximal de bilans en attente d’écriture.
+ * @return `1` si l’ouverture réussit, `0` sinon (rien n’est alors à libérer).
+ * @pre `capacite >= 1`.
+ */
+int ouvrirAnalyses(Analyses* a, const char* chemin, int capacite);
+
+/**
+ * @brief Publie le bilan d’un tour sans attendre son écriture.
+ *
+ * @param[in,out] a Analyses.
+ * @param[in] bilan Bilan, copié.
+ * @return `1` si le bilan est en attente d’écriture, `0` s’il est perdu (file pleine).
+ */
+int publierBilan(Analyses* a, const BilanTour* bilan);
+
+/**
+ * @brief Met en forme un bilan sur une ligne JSON, saut de ligne compris.
+ *
+ * @param[in] bilan Bilan.
+ * @param[out] ligne Tampon recevant la ligne (à la suite de son contenu).
+ * @return `1` si la ligne est ajoutée, `0` en cas de manque de mémoire.
+ */
+int ecrireBilanJson(const BilanTour* bilan, Tampon* ligne);
+
+/**
+ * @brief Écrit les bilans en attente, arrête le fil et ferme le fichier.
+ *
+ * @param[in,out] a Analyses ouvertes.
+ * @return `1` si toutes les écritures ont réussi, `0` sinon.
+ */
+int fermerAnalyses(Analyses* a);
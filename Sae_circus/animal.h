@@ -2,7 +2,7 @@
  * @file animal.h
  * @brief Types et opérations pour gérer des animaux et un conteneur d’animaux.
  *
- * Ce module définit le type `Animal`, le type `Animaux` (basé sur `Vecteur`)
+ * Ce module définit le type `Animal`, le type `Animaux` (vecteur typé d’`Animal`)
  * et les fonctions permettant de créer, stocker, accéder et mélanger des animaux.
  */
 
@@ -13,28 +13,34 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "vecteur.h"
+#include "vecteurtype.h"
+#include "aleatoire.h"
+#include "noms.h"
 
 /**
  * @brief Représente un animal par son nom.
  */
 typedef struct {
-    char* nom_animal; /**< Chaîne C contenant le nom de l’animal. */
+    Nom nom_animal; /**< Nom interné de l’animal. */
 } Animal;
 
+VECTEUR_DEF(VecteurAnimal, Animal)
+
 /**
- * @brief Conteneur d’animaux basé sur un vecteur dynamique.
+ * @brief Conteneur d’animaux, stockés par valeur.
  */
-typedef Vecteur Animaux;
+typedef VecteurAnimal Animaux;
 
 /**
- * @brief Crée un animal en copiant son nom.
+ * @brief Initialise un animal en internant son nom.
  *
+ * @param[out] a Animal à initialiser.
  * @param[in] nom Chaîne C représentant le nom de l’animal.
- * @return Un pointeur vers un `Animal` initialisé, ou `NULL` en cas d’erreur.
- * @pre `nom` n’est pas `NULL`.
+ * @param[in,out] noms Réserve où le nom est interné.
+ * @return `1` si l’opération réussit, `0` sinon.
+ * @pre `a` et `nom` ne sont pas `NULL`.
  */
-Animal* creerAnimal(const char* nom);
+int creerAnimal(Animal* a, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Initialise un conteneur d’animaux.
@@ -51,10 +57,11 @@ int initAnimaux(Animaux* animaux, int capacite);
  *
  * @param[in,out] animaux Conteneur d’animaux.
  * @param[in] nom Nom de l’animal à ajouter.
+ * @param[in,out] noms Réserve où le nom est interné.
  * @return `1` si l’ajout a réussi, `0` sinon.
  * @pre `animaux` est initialisé et `nom` n’est pas `NULL`.
  */
-int ajouterAnimal(Animaux* animaux, const char* nom);
+int ajouterAnimal(Animaux* animaux, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Accède à un animal du conteneur par son indice.
@@ -70,8 +77,9 @@ Animal* obtenirAnimal(const Animaux* animaux, int i);
  * @brief Génère une permutation aléatoire des indices d’animaux.
  *
  * @param[in] n_animaux Nombre d’animaux.
+ * @param[in,out] alea Générateur de la partie.
  * @return Un tableau d’entiers de taille `n_animaux` contenant une permutation
  *         des indices, ou `NULL` en cas d’erreur.
  * @pre `n_animaux > 0`.
  */
-int* shuffleAnimaux(int n_animaux);
+int* shuffleAnimaux(int n_animaux, Aleatoire* alea);
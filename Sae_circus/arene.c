@@ -0,0 +1,98 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "arene.h"
+
+
+enum { ALIGNEMENT_ARENE = 16 };
+
+static size_t aligner(size_t n) {
+	return (n + ALIGNEMENT_ARENE - 1) & ~(size_t)(ALIGNEMENT_ARENE - 1);
+}
+
+void initArene(Arene* a, size_t taille_bloc) {
+	a->bloc = NULL;
+	a->taille_bloc = taille_bloc;
+	a->sous_systeme = MEMOIRE_AUTRE;
+	memset(a->distribues, 0, sizeof(a->distribues));
+}
+
+static BlocArene* nouveauBloc(size_t taille) {
+	/* l’en-tête et les données sont dans le même malloc */
+	size_t entete = aligner(sizeof(BlocArene));
+	char* brut = (char*)allouerMemoire(MEMOIRE_ARENES, entete + taille);
+	if (!brut) return NULL;
+	BlocArene* b = (BlocArene*)brut;
+	b->suivant = NULL;
+	b->taille = taille;
+	b->utilise = 0;
+	b->donnees = brut + entete;
+	return b;
+}
+
+/* la zone passe du reste de l’arène au sous-système courant */
+static void compterZone(Arene* a, size_t taille) {
+	compterLiberation(MEMOIRE_ARENES, taille);
+	compterAllocation(a->sous_systeme, taille);
+	a->distribues[a->sous_systeme] += taille;
+}
+
+void* allouerArene(Arene* a, size_t taille) {
+	taille = aligner(taille ? taille : 1);
+	BlocArene* b = a->bloc;
+
+	if (b == NULL || b->taille - b->utilise < taille) {
+		if (taille > a->taille_bloc / 4) {
+			/* grande demande : bloc dédié, inséré sous le bloc courant pour ne pas le gaspiller */
+			BlocArene* dedie = nouveauBloc(taille);
+			if (!dedie) return NULL;
+			dedie->utilise = taille;
+			compterZone(a, taille);
+			if (b) {
+				dedie->suivant = b->suivant;
+				b->suivant = dedie;
+			}
+			else {
+				a->bloc = dedie;
+			}
+			return dedie->donnees;
+		}
+		b = nouveauBloc(a->taille_bloc);
+		if (!b) return NULL;
+		b->suivant = a->bloc;
+		a->bloc = b;
+	}
+
+	void* p = b->donnees + b->utilise;
+	b->utilise += taille;
+	compterZone(a, taille);
+	return p;
+}
+
+char* copierChaineArene(Arene* a, const char* texte) {
+	size_t n = strlen(texte) + 1;
+	char* copie = (char*)allouerArene(a, n);
+	if (copie) memcpy(copie, texte, n);
+	return copie;
+}
+
+void detruireArene(Arene* a) {
+	size_t entete = aligner(sizeof(BlocArene));
+	size_t distribues = 0;
+	for (int s = 0; s < NB_SOUS_SYSTEMES; ++s) {
+		compterLiberation((SousSysteme)s, a->distribues[s]);
+		distribues += a->distribues[s];
+		a->distribues[s] = 0;
+	}
+	size_t reserves = 0;
+	BlocArene* b = a->bloc;
+	while (b) {
+		BlocArene* suivant = b->suivant;
+		reserves += entete + b->taille;
+		free(b);
+		b = suivant;
+	}
+	/* les zones distribuées ont quitté le reste de l’arène à leur allocation */
+	compterLiberation(MEMOIRE_ARENES, reserves - distribues);
+	a->bloc = NULL;
+}
@@ -0,0 +1,70 @@
+/**
+ * @file arene.h
+ * @brief Allocateur par zones (arène) pour les objets qui vivent aussi longtemps qu’une partie.
+ *
+ * Les allocations avancent simplement un pointeur dans de grands blocs ; il n’y a
+ * pas de libération individuelle. Toute la mémoire est rendue d’un coup par
+ * `detruireArene`, en un appel à `free` par bloc.
+ *
+ * Chaque zone distribuée est comptée au sous-système courant de l’arène
+ * (`sous_systeme`, voir `memoire.h`) ; le reste des blocs est compté à `MEMOIRE_ARENES`.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+#include "memoire.h"
+
+/**
+ * @brief Bloc de mémoire d’une arène.
+ */
+typedef struct BlocArene {
+    struct BlocArene* suivant; /**< Bloc alloué précédemment. */
+    size_t taille;             /**< Octets utilisables dans `donnees`. */
+    size_t utilise;            /**< Octets déjà distribués. */
+    char* donnees;             /**< Début de la zone utilisable (alignée). */
+} BlocArene;
+
+/**
+ * @brief Arène : liste de blocs dont seul le plus récent reçoit les allocations.
+ */
+typedef struct {
+    BlocArene* bloc;     /**< Bloc courant (ou `NULL`). */
+    size_t taille_bloc;  /**< Taille des blocs ordinaires. */
+    SousSysteme sous_systeme;            /**< Sous-système des prochaines allocations (`MEMOIRE_AUTRE` à l’initialisation). */
+    size_t distribues[NB_SOUS_SYSTEMES]; /**< Octets distribués à chaque sous-système. */
+} Arene;
+
+/**
+ * @brief Initialise une arène vide.
+ *
+ * @param[out] a Arène à initialiser.
+ * @param[in] taille_bloc Taille des blocs ordinaires (une demande plus grande reçoit son propre bloc).
+ */
+void initArene(Arene* a, size_t taille_bloc);
+
+/**
+ * @brief Alloue une zone alignée dans l’arène.
+ *
+ * @param[in,out] a Arène.
+ * @param[in] taille Nombre d’octets.
+ * @return Un pointeur aligné sur 16 octets, ou `NULL` en cas de manque de mémoire.
+ */
+void* allouerArene(Arene* a, size_t taille);
+
+/**
+ * @brief Copie une chaîne C dans l’arène.
+ *
+ * @param[in,out] a Arène.
+ * @param[in] texte Chaîne à copier.
+ * @return La copie, ou `NULL` en cas de manque de mémoire.
+ */
+char* copierChaineArene(Arene* a, const char* texte);
+
+/**
+ * @brief Libère tous les blocs de l’arène ; elle peut ensuite être réutilisée.
+ *
+ * @param[in,out] a Arène.
+ */
+void detruireArene(Arene* a);
@@ -0,0 +1,217 @@
+#include "cache.h"
+
+
+int initCache(CacheCompositions* cache, int64_t capacite) {
+	assert(capacite >= 1 && capacite <= INT32_MAX);
+	uint64_t nb_seaux = 1;
+	while (nb_seaux < (uint64_t)capacite) nb_seaux *= 2;
+
+	cache->entrees = (EntreeCache*)allouerMemoire(MEMOIRE_TABLES, sizeof(EntreeCache) * (size_t)capacite);
+	cache->seaux = (int32_t*)allouerMemoire(MEMOIRE_TABLES, sizeof(int32_t) * (size_t)nb_seaux);
+	if (!cache->entrees || !cache->seaux) {
+		libererMemoire(MEMOIRE_TABLES, cache->entrees, sizeof(EntreeCache) * (size_t)capacite);
+		libererMemoire(MEMOIRE_TABLES, cache->seaux, sizeof(int32_t) * (size_t)nb_seaux);
+		cache->entrees = NULL;
+		cache->seaux = NULL;
+		return 0;
+	}
+	memset(cache->entrees, 0, sizeof(EntreeCache) * (size_t)capacite);
+	for (uint64_t i = 0; i < nb_seaux; ++i) {
+		cache->seaux[i] = -1;
+	}
+	cache->capacite = capacite;
+	cache->masque = nb_seaux - 1;
+	cache->aiguille = 0;
+	memset(&cache->stats, 0, sizeof(cache->stats));
+	cache->stats.octets = sizeof(EntreeCache) * (size_t)capacite + sizeof(int32_t) * (size_t)nb_seaux;
+	return 1;
+}
+
+static size_t tailleCopie(const EntreeCache* e) {
+	return sizeof(Serie) * (size_t)e->nb_series + sizeof(Segment) * (size_t)e->nb_segments;
+}
+
+/* une copie vide occupe tout de même un octet */
+static size_t tailleZone(size_t taille) {
+	return taille > 0 ? taille : 1;
+}
+
+static void libererCopie(EntreeCache* e) {
+	libererMemoire(MEMOIRE_TABLES, e->series, tailleZone(sizeof(Serie) * (size_t)e->nb_series));
+	libererMemoire(MEMOIRE_TABLES, e->segments, tailleZone(sizeof(Segment) * (size_t)e->nb_segments));
+	e->series = NULL;
+	e->segments = NULL;
+}
+
+void detruireCache(CacheCompositions* cache) {
+	if (!cache->entrees) return;
+	for (int64_t i = 0; i < cache->capacite; ++i) {
+		libererCopie(&cache->entrees[i]);
+	}
+	libererMemoire(MEMOIRE_TABLES, cache->entrees, sizeof(EntreeCache) * (size_t)cache->capacite);
+	libererMemoire(MEMOIRE_TABLES, cache->seaux, sizeof(int32_t) * (size_t)(cache->masque + 1));
+	cache->entrees = NULL;
+	cache->seaux = NULL;
+}
+
+void viderCache(CacheCompositions* cache) {
+	if (!cache->entrees) return;
+	for (int64_t i = 0; i < cache->capacite; ++i) {
+		EntreeCache* e = &cache->entrees[i];
+		libererCopie(e);
+		memset(e, 0, sizeof(*e));
+	}
+	for (uint64_t i = 0; i <= cache->masque; ++i) {
+		cache->seaux[i] = -1;
+	}
+	cache->aiguille = 0;
+	cache->stats.nb_entrees = 0;
+	cache->stats.octets = sizeof(EntreeCache) * (size_t)cache->capacite + sizeof(int32_t) * (size_t)(cache->masque + 1);
+}
+
+uint64_t hacherLigneCompilee(const LigneCompilee* ligne) {
+	uint64_t h = (uint64_t)ligne->segments.nbElements;
+	for (int64_t i = 0; i < ligne->segments.nbElements; ++i) {
+		const Segment* s = &ligne->segments.elements[i];
+		h = hacherCleEtat(h ^ (uint64_t)s->longueur);
+		h = hacherCleEtat(h ^ (uint64_t)s->nb_series);
+	}
+	for (int64_t i = 0; i < ligne->series.nbElements; ++i) {
+		const Serie* s = &ligne->series.elements[i];
+		h = hacherCleEtat(h ^ ((uint64_t)s->nb << 3 | s->op));
+	}
+	return h;
+}
+
+static int memeLigne(const EntreeCache* e, const LigneCompilee* ligne) {
+	if (e->nb_series != ligne->series.nbElements || e->nb_segments != ligne->segments.nbElements) {
+		return 0;
+	}
+	for (int32_t i = 0; i < e->nb_series; ++i) {
+		if (e->series[i].op != ligne->series.elements[i].op || e->series[i].nb != ligne->series.elements[i].nb) {
+			return 0;
+		}
+	}
+	for (int32_t i = 0; i < e->nb_segments; ++i) {
+		const Segment* a = &e->segments[i];
+		const Segment* b = &ligne->segments.elements[i];
+		if (a->debut != b->debut || a->longueur != b->longueur || a->nb_series != b->nb_series) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+int consulterCache(CacheCompositions* cache, CleEtat depart, const LigneCompilee* ligne, uint64_t hachage,
+	CleEtat* finale, int64_t* echec) {
+	++cache->stats.consultations;
+	uint64_t seau = hacherCleEtat(depart ^ hachage) & cache->masque;
+	for (int32_t i = cache->seaux[seau]; i >= 0; i = cache->entrees[i].suivant) {
+		EntreeCache* e = &cache->entrees[i];
+		if (e->depart == depart && e->hachage == hachage && memeLigne(e, ligne)) {
+			e->reference = 1;
+			*finale = e->finale;
+			*echec = e->echec;
+			++cache->stats.succes;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/* retire une entrée occupée de son seau et libère sa copie */
+static void evincer(CacheCompositions* cache, int32_t indice) {
+	EntreeCache* e = &cache->entrees[indice];
+	int32_t* lien = &cache->seaux[hacherCleEtat(e->depart ^ e->hachage) & cache->masque];
+	while (*lien != indice) {
+		lien = &cache->entrees[*lien].suivant;
+	}
+	*lien = e->suivant;
+
+	cache->stats.octets -= tailleCopie(e);
+	--cache->stats.nb_entrees;
+	++cache->stats.evictions;
+	libererCopie(e);
+	e->occupee = 0;
+}
+
+/* avance l’aiguille jusqu’à une entrée libre ou non référencée */
+static int32_t choisirVictime(CacheCompositions* cache) {
+	for (;;) {
+		int32_t i = (int32_t)cache->aiguille;
+		EntreeCache* e = &cache->entrees[i];
+		if (++cache->aiguille == cache->capacite) cache->aiguille = 0;
+		if (!e->occupee) return i;
+		if (!e->reference) {
+			evincer(cache, i);
+			return i;
+		}
+		e->reference = 0;
+	}
+}
+
+void insererCache(CacheCompositions* cache, CleEtat depart, const LigneCompilee* ligne, uint64_t hachage,
+	CleEtat finale, int64_t echec) {
+	if (ligne->series.nbElements > MAX_SERIES_CACHE) return;
+
+	size_t taille_series = sizeof(Serie) * (size_t)ligne->series.nbElements;
+	size_t taille_segments = sizeof(Segment) * (size_t)ligne->segments.nbElements;
+	Serie* series = (Serie*)allouerMemoire(MEMOIRE_TABLES, tailleZone(taille_series));
+	Segment* segments = (Segment*)allouerMemoire(MEMOIRE_TABLES, tailleZone(taille_segments));
+	if (!series || !segments) {
+		libererMemoire(MEMOIRE_TABLES, series, tailleZone(taille_series));
+		libererMemoire(MEMOIRE_TABLES, segments, tailleZone(taille_segments));
+		return;
+	}
+	if (taille_series > 0) memcpy(series, ligne->series.elements, taille_series);
+	if (taille_segments > 0) memcpy(segments, ligne->segments.elements, taille_segments);
+
+	int32_t i = choisirVictime(cache);
+	EntreeCache* e = &cache->entrees[i];
+	uint64_t seau = hacherCleEtat(depart ^ hachage) & cache->masque;
+	e->depart = depart;
+	e->hachage = hachage;
+	e->series = series;
+	e->segments = segments;
+	e->nb_series = (int32_t)ligne->series.nbElements;
+	e->nb_segments = (int32_t)ligne->segments.nbElements;
+	e->finale = finale;
+	e->echec = echec;
+	e->occupee = 1;
+	/* une entrée neuve n’est protégée qu’après avoir servi une fois */
+	e->reference = 0;
+	e->suivant = cache->seaux[seau];
+	cache->seaux[seau] = i;
+
+	cache->stats.octets += tailleCopie(e);
+	++cache->stats.nb_entrees;
+	++cache->stats.insertions;
+}
+
+int executerLigneCache(CacheCompositions* cache, Commandes* commandes, const char* com, CleEtat* cle, int n) {
+	if (!cache) {
+		return executerLigneCle(commandes, com, cle, n);
+	}
+
+	LigneCompilee ligne;
+	if (!initLigneCompilee(&ligne)) {
+		return 2;
+	}
+	int compilation = compilerLigne(commandes, com, &ligne);
+	int resultat = 2;
+	if (compilation != 2) {
+		uint64_t hachage = hacherLigneCompilee(&ligne);
+		CleEtat finale;
+		int64_t echec;
+		if (!consulterCache(cache, *cle, &ligne, hachage, &finale, &echec)) {
+			finale = *cle;
+			echec = executerLigneCompilee(&finale, n, &ligne);
+			insererCache(cache, *cle, &ligne, hachage, finale, echec);
+		}
+		*cle = finale;
+		/* une commande impossible avant une commande inconnue l’emporte, comme dans la boucle naïve */
+		resultat = echec >= 0 ? 2 : compilation;
+	}
+	detruireLigneCompilee(&ligne);
+	return resultat;
+}
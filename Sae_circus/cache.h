@@ -0,0 +1,146 @@
+/**
+ * @file cache.h
+ * @brief Cache des résultats de chaînes de commandes compilées.
+ *
+ * Les joueurs soumettent souvent les mêmes chaînes, et les robots en essaient
+ * des variantes. Le cache associe à un couple (situation de départ, chaîne
+ * compilée) la situation atteinte et la position de la première commande
+ * impossible, ce qui évite de réexécuter une chaîne déjà évaluée.
+ *
+ * La chaîne compilée est recopiée dans l’entrée et comparée en entier : un
+ * hachage identique ne suffit pas à donner un résultat. Le nombre d’entrées est
+ * borné ; quand le cache est plein, l’entrée remplacée est choisie par
+ * l’algorithme de l’horloge (CLOCK) : l’aiguille parcourt les entrées et
+ * remplace la première qui n’a pas été consultée depuis son dernier passage.
+ *
+ * Un cache n’est pas protégé : il appartient à un seul thread (la boucle de jeu
+ * ou un travailleur du serveur, qui le partage entre ses salles).
+ */
+
+#pragma once
+
+#include "executeur.h"
+
+enum {
+    MAX_SERIES_CACHE = 256,     /**< Nombre de séries au-delà duquel une chaîne n’est pas mise en cache. */
+    TAILLE_CACHE_DEFAUT = 4096  /**< Nombre d’entrées du cache d’une boucle de jeu ou d’un travailleur. */
+};
+
+/**
+ * @brief Compteurs d’activité d’un cache.
+ */
+typedef struct {
+    uint64_t consultations;  /**< Nombre de recherches. */
+    uint64_t succes;         /**< Recherches ayant trouvé leur résultat. */
+    uint64_t insertions;     /**< Résultats ajoutés. */
+    uint64_t evictions;      /**< Entrées remplacées par l’horloge. */
+    int64_t nb_entrees;      /**< Entrées occupées. */
+    size_t octets;           /**< Mémoire occupée (table et copies des chaînes). */
+} StatistiquesCache;
+
+/**
+ * @brief Entrée du cache.
+ */
+typedef struct {
+    CleEtat depart;      /**< Situation de départ. */
+    uint64_t hachage;    /**< Hachage de la chaîne compilée. */
+    Serie* series;       /**< Copie des séries de la chaîne. */
+    Segment* segments;   /**< Copie des segments de la chaîne. */
+    int32_t nb_series;
+    int32_t nb_segments;
+    int32_t suivant;     /**< Entrée suivante du même seau, ou `-1`. */
+    uint8_t occupee;
+    uint8_t reference;   /**< Bit de l’horloge : `1` si consultée depuis le dernier passage de l’aiguille. */
+    CleEtat finale;      /**< Situation atteinte. */
+    int64_t echec;       /**< Indice de la première commande impossible, ou `-1`. */
+} EntreeCache;
+
+/**
+ * @brief Cache borné de résultats.
+ */
+typedef struct {
+    EntreeCache* entrees;  /**< Tableau de `capacite` entrées, parcouru par l’aiguille. */
+    int32_t* seaux;        /**< Première entrée de chaque seau, ou `-1`. */
+    int64_t capacite;
+    uint64_t masque;       /**< Nombre de seaux moins un (puissance de deux). */
+    int64_t aiguille;      /**< Position de l’aiguille de l’horloge. */
+    StatistiquesCache stats;
+} CacheCompositions;
+
+/**
+ * @brief Initialise un cache vide.
+ *
+ * @param[out] cache Cache à initialiser.
+ * @param[in] capacite Nombre maximal d’entrées.
+ * @return `1` si l’initialisation réussit, `0` sinon.
+ * @pre `1 <= capacite <= INT32_MAX`.
+ */
+int initCache(CacheCompositions* cache, int64_t capacite);
+
+/**
+ * @brief Libère un cache et toutes ses entrées.
+ *
+ * @param[in,out] cache Cache à libérer.
+ */
+void detruireCache(CacheCompositions* cache);
+
+/**
+ * @brief Supprime toutes les entrées d’un cache, par exemple quand les commandes changent.
+ *
+ * Les compteurs d’activité sont conservés.
+ *
+ * @param[in,out] cache Cache.
+ */
+void viderCache(CacheCompositions* cache);
+
+/**
+ * @brief Calcule le hachage d’une chaîne compilée.
+ *
+ * @param[in] ligne Chaîne compilée.
+ * @return Un hachage 64 bits des segments et des séries.
+ */
+uint64_t hacherLigneCompilee(const LigneCompilee* ligne);
+
+/**
+ * @brief Cherche le résultat d’une chaîne compilée à partir d’une situation.
+ *
+ * @param[in,out] cache Cache (compteurs et bit de l’horloge mis à jour).
+ * @param[in] depart Situation de départ.
+ * @param[in] ligne Chaîne compilée.
+ * @param[in] hachage `hacherLigneCompilee(ligne)`.
+ * @param[out] finale Situation atteinte, si le résultat est trouvé.
+ * @param[out] echec Indice de la première commande impossible ou `-1`, si le résultat est trouvé.
+ * @return `1` si le résultat est dans le cache, `0` sinon.
+ */
+int consulterCache(CacheCompositions* cache, CleEtat depart, const LigneCompilee* ligne, uint64_t hachage,
+    CleEtat* finale, int64_t* echec);
+
+/**
+ * @brief Ajoute le résultat d’une chaîne compilée.
+ *
+ * Le résultat n’est pas ajouté si la chaîne compte plus de `MAX_SERIES_CACHE`
+ * séries ou en cas de manque de mémoire.
+ *
+ * @param[in,out] cache Cache.
+ * @param[in] depart Situation de départ.
+ * @param[in] ligne Chaîne compilée.
+ * @param[in] hachage `hacherLigneCompilee(ligne)`.
+ * @param[in] finale Situation atteinte.
+ * @param[in] echec Indice de la première commande impossible, ou `-1`.
+ * @pre Le résultat n’est pas déjà dans le cache.
+ */
+void insererCache(CacheCompositions* cache, CleEtat depart, const LigneCompilee* ligne, uint64_t hachage,
+    CleEtat finale, int64_t echec);
+
+/**
+ * @brief Équivalent de `executerLigneCle` qui consulte et alimente un cache.
+ *
+ * @param[in,out] cache Cache, ou `NULL` pour exécuter sans cache.
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] com Chaîne de commandes.
+ * @param[in,out] cle Situation de départ, puis situation atteinte.
+ * @param[in] n Nombre d’animaux.
+ * @return Les mêmes codes que `executerLigneCommandes` (`1`, `0` ou `2`).
+ * @pre `n <= MAX_ANIMAUX_CLE`.
+ */
+int executerLigneCache(CacheCompositions* cache, Commandes* commandes, const char* com, CleEtat* cle, int n);
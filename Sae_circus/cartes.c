@@ -1,35 +1,61 @@
 
-#include "cartes.h"
+#include "paquet.h"
 
 
 static void swap_int(int* a, int* b) {
 	int t = *a; *a = *b; *b = t;
 }
-void genererToutesLesCartes(Animaux* animaux, Vecteur* cartes) {
-	int n = animaux->nbElements;
+int initCartes(Cartes* cartes, int n) {
+	cartes->largeur = n + 1;
+	cartes->projection = NULL;
+	cartes->taille_projection = 0;
+	return initPourVecteurInt(&cartes->valeurs, 0, MEMOIRE_PAQUET);
+}
+
+int64_t nbCartes(const Cartes* cartes) {
+	return cartes->valeurs.nbElements / cartes->largeur;
+}
+
+int* obtenirCarte(const Cartes* cartes, int64_t i) {
+	return obtenirVecteurInt(&cartes->valeurs, i * cartes->largeur);
+}
+
+void detruireCartes(Cartes* cartes) {
+	if (cartes->projection) {
+		libererProjectionPaquet(cartes);
+		return;
+	}
+	detruireVecteurInt(&cartes->valeurs);
+}
+
+void genererToutesLesCartes(Animaux* animaux, Cartes* cartes) {
+	int n = (int)animaux->nbElements;
+
+	int64_t total = n + 1;
+	for (int i = 2; i <= n; ++i) {
+		total *= i;
+	}
+	reserverVecteurInt(&cartes->valeurs, total * (n + 1));
 		
 	int* perm = (int*)malloc(sizeof(int) * n);
 	for (int i = 0; i < n; ++i) {
 		perm[i] = i;
 	}
 	heap_generer(n, perm, n, cartes);
+	free(perm);
 }
-void push_all_splits(int* perm, int n, Vecteur* cartes) {
+void push_all_splits(int* perm, int n, Cartes* cartes) {
 	for (int i = 0; i <= n; ++i) {
 		push_split_for_perm(perm, n, i, cartes);
 	}
 	
 }
-void push_split_for_perm(int* perm, int n, int split, Vecteur* cartes) {
-	int* arr = (int*)malloc(sizeof(int) * n + 1);
-	arr[0] = split;
-	for (int i = 0; i < n; ++i) {
-		arr[i + 1] = perm[i];
-	}
-	ajouter(cartes, arr);
+void push_split_for_perm(int* perm, int n, int split, Cartes* cartes) {
+	ajouterVecteurInt(&cartes->valeurs, split);
+	ajouterPlusieursVecteurInt(&cartes->valeurs, perm, n);
 
 }
-void heap_generer(int k, int* A, int n, Vecteur* cartes) {
+void heap_generer(int k, int* A, int n, Cartes* cartes) {
 	if (k == 1) {
 		return push_all_splits(A, n, cartes);
 	}
@@ -49,8 +75,8 @@ void heap_generer(int k, int* A, int n, Vecteur* cartes) {
 }
 
 
-int choisirRandomCarte(Vecteur* cartes) {
-	return rand() % cartes->nbElements;
+int choisirRandomCarte(const Cartes* cartes, Aleatoire* alea) {
+	return (int)aleatoireBorne(alea, (uint64_t)nbCartes(cartes));
 }
 
 void distrbuerAuxPodiums(int* arr,int n,  Podium* podium_b, Podium* podium_r) {
@@ -15,18 +15,66 @@
 
 #include "commandes.h"
 
+/**
+ * @brief Paquet de cartes stockées bout à bout dans un seul vecteur d’entiers.
+ *
+ * La carte `i` occupe `valeurs.elements[i * largeur]` à `valeurs.elements[(i + 1) * largeur - 1]`.
+ */
+typedef struct {
+    VecteurInt valeurs;  /**< Cartes mises bout à bout. */
+    int largeur;         /**< Nombre d’entiers par carte (n + 1). */
+    void* projection;        /**< Fichier de paquet projeté où sont les cartes (voir `paquet.h`), ou `NULL`. */
+    size_t taille_projection;
+} Cartes;
+
+/**
+ * @brief Initialise un paquet vide.
+ *
+ * @param[out] cartes Paquet à initialiser.
+ * @param[in] n Nombre d’animaux.
+ * @return `1` si l’initialisation réussit, `0` sinon.
+ */
+int initCartes(Cartes* cartes, int n);
+
+/**
+ * @brief Retourne le nombre de cartes du paquet.
+ *
+ * @param[in] cartes Paquet.
+ * @return Le nombre de cartes.
+ */
+int64_t nbCartes(const Cartes* cartes);
+
+/**
+ * @brief Accède à une carte du paquet.
+ *
+ * @param[in] cartes Paquet.
+ * @param[in] i Indice de la carte.
+ * @return L’adresse de la carte (`largeur` entiers).
+ * @pre `0 ≤ i < nbCartes(cartes)`.
+ */
+int* obtenirCarte(const Cartes* cartes, int64_t i);
+
+/**
+ * @brief Libère la mémoire d’un paquet, ou supprime sa projection.
+ *
+ * @param[in,out] cartes Paquet.
+ */
+void detruireCartes(Cartes* cartes);
+
 /**
  * @brief Génère toutes les cartes possibles pour les animaux fournis.
  *
  * Toutes les permutations des indices `[0..n-1]` sont générées, et pour chacune,
  * toutes les valeurs possibles de `split` (de 0 à n) sont utilisées pour créer
- * une carte ajoutée au vecteur `cartes`.
+ * une carte ajoutée au paquet `cartes`.
+ *
+ * La capacité du paquet est réservée en une fois (n! × (n+1) cartes de n+1 entiers).
  *
  * @param[in]  animaux Référentiel des animaux.
- * @param[out] cartes  Vecteur recevant des pointeurs `int*` vers les cartes générées.
- * @pre `animaux` et `cartes` doivent être initialisés.
+ * @param[out] cartes  Paquet recevant les cartes générées.
+ * @pre `animaux` et `cartes` doivent être initialisés, avec `cartes->largeur == n + 1`.
  */
-void genererToutesLesCartes(Animaux* animaux, Vecteur* cartes);
+void genererToutesLesCartes(Animaux* animaux, Cartes* cartes);
 
 /**
  * @brief Crée une carte à partir d’une permutation et d’un split, puis l’ajoute à `cartes`.
@@ -36,10 +84,10 @@ void genererToutesLesCartes(Animaux* animaux, Vecteur* cartes);
  * @param[in] perm   Permutation des indices d’animaux.
  * @param[in] n      Taille de la permutation.
  * @param[in] split  Position de séparation (0 ≤ split ≤ n).
- * @param[out] cartes Vecteur recevant la carte créée.
+ * @param[out] cartes Paquet recevant la carte créée.
  * @pre `perm` pointe vers au moins `n` éléments et `0 ≤ split ≤ n`.
  */
-void push_split_for_perm(int* perm, int n, int split, Vecteur* cartes);
+void push_split_for_perm(int* perm, int n, int split, Cartes* cartes);
 
 /**
  * @brief Ajoute à `cartes` toutes les cartes correspondant aux splits d’une permutation.
@@ -48,10 +96,10 @@ void push_split_for_perm(int* perm, int n, int split, Vecteur* cartes);
  *
  * @param[in] perm   Permutation des indices d’animaux.
  * @param[in] n      Taille de la permutation.
- * @param[out] cartes Vecteur recevant les cartes.
+ * @param[out] cartes Paquet recevant les cartes.
  * @pre `perm` pointe vers au moins `n` éléments.
  */
-void push_all_splits(int* perm, int n, Vecteur* cartes);
+void push_all_splits(int* perm, int n, Cartes* cartes);
 
 /**
  * @brief Génère toutes les permutations par l’algorithme de Heap et crée les cartes associées.
@@ -59,19 +107,22 @@ void push_all_splits(int* perm, int n, Vecteur* cartes);
  * @param[in] k  Paramètre de récursion de l’algorithme.
  * @param[in] A  Tableau contenant la permutation courante.
  * @param[in] n  Nombre total d’animaux.
- * @param[out] cartes Vecteur recevant les cartes.
+ * @param[out] cartes Paquet recevant les cartes.
  * @pre `A` pointe vers au moins `n` éléments.
  */
-void heap_generer(int k, int* A, int n, Vecteur* cartes);
+void heap_generer(int k, int* A, int n, Cartes* cartes);
 
 /**
  * @brief Sélectionne aléatoirement une carte parmi celles stockées dans `cartes`.
  *
- * @param[in] cartes Vecteur contenant des cartes.
- * @return Un indice valide dans l’intervalle `[0, cartes->nbElements - 1]`.
- * @pre `cartes->nbElements > 0`.
+ * Le tirage est uniforme sur tout le paquet, même au-delà de `RAND_MAX`.
+ *
+ * @param[in] cartes Paquet de cartes.
+ * @param[in,out] alea Générateur de la partie.
+ * @return Un indice valide dans l’intervalle `[0, nbCartes(cartes) - 1]`.
+ * @pre `nbCartes(cartes) > 0`.
  */
-int choisirRandomCarte(Vecteur* cartes);
+int choisirRandomCarte(const Cartes* cartes, Aleatoire* alea);
 
 /**
  * @brief Distribue les animaux d’une carte vers les podiums Bleu et Rouge.
@@ -1,16 +1,12 @@
 #include "commandes.h"
 
-Commande* creerCommande(const char* nom) {
-	Commande* c = (Commande*)malloc(sizeof(Commande));
-	
-	c->nom_commande = (char*)malloc(strlen(nom) + 1);
-	strcpy(c->nom_commande, nom);
-	return c;
+int creerCommande(Commande* c, const char* nom, PoolNoms* noms) {
+	return internerNom(noms, nom, &c->nom_commande);
 }
 
 
 int initCommandes(Commandes* commandes, int capacite) {
-	return initVecteur(commandes, capacite);
+	return initPourVecteurCommande(commandes, capacite, MEMOIRE_CONFIG);
 }
 
 static int isAllowedCommande(const char* nom) {
@@ -22,31 +18,24 @@ static int isAllowedCommande(const char* nom) {
 	return 0;
 }
 
-int ajouterCommande(Commandes* commandes, const char* nom) {
+int ajouterCommande(Commandes* commandes, const char* nom, PoolNoms* noms) {
 	if (!isAllowedCommande(nom)) return 0;
-	Commande* c = creerCommande(nom);
-	ajouter(commandes, c);
+	Commande c;
+	if (!creerCommande(&c, nom, noms)) return 0;
+	return ajouterVecteurCommande(commandes, c);
 }
 Commande* obtenirCommande(const Commandes* commandes, int i) {
-	return obtenir(commandes, i);
+	return obtenirVecteurCommande(commandes, i);
 }
 
 int ajouterHaut(Podium* p, int index_animal) {
-	int* it = (int*)malloc(sizeof(int));
-	*it = index_animal;
-	return ajouter(p, it);
+	return ajouterVecteurInt(p, index_animal);
 }
 int supprimerHaut(Podium* p, int* address_animal) {
 	if (p->nbElements == 0) {
 		return 0;
 	}
-	int index_last = p->nbElements - 1;
-	if (index_last < 0) return 0;
-	int* it = (int*)obtenir(p, index_last);
-
-	*address_animal = *it;
-	free(it);
-	supprimer(p, index_last);
+	*address_animal = p->elements[--p->nbElements];
 	return 1;
 	
 }
@@ -54,18 +43,18 @@ int supprimerBas(Podium* p, int* adress_animal) {
 	if (p->nbElements == 0) {
 		return 0;
 	}
-	int* it = (int*)obtenir(p, 0);
-	*adress_animal = *it;
-	free(it);
-	supprimer(p, 0);
+	*adress_animal = p->elements[0];
+	supprimerVecteurInt(p, 0);
 	return 1;
 
 }
 
 int verifierCommande(Commandes* commandes, char* commande) {
+	size_t longueur = strlen(commande);
+	uint32_t h = hacherNom(commande, longueur);
 	for (int i = 0; i < commandes->nbElements; ++i) {
 		Commande* c = obtenirCommande(commandes, i);
-		if (strcmp(c->nom_commande, commande)==0) {
+		if (nomEgal(&c->nom_commande, commande, longueur, h)) {
 			return 1;
 		}
 	}
@@ -136,11 +125,12 @@ int executerCommande(const char* nom, Podium* podium_b, Podium* podium_r) {
 }
 
 int executerLigneCommandes(Commandes* commandes, const char* com, Podium* podium_b, Podium* podium_r) {
-	if (strlen(com) % 2 != 0) {
+	size_t longueur = strlen(com);
+	if (longueur % 2 != 0) {
 		
 		return 2;
 	}
-	for (int i = 0; i < strlen(com); i += 2) {
+	for (size_t i = 0; i < longueur; i += 2) {
 		char commande[3];
 		commande[0] = com[i];
 		commande[1] = com[i + 1];
@@ -160,4 +150,38 @@ int executerLigneCommandes(Commandes* commandes, const char* com, Podium* podium
 		
 	}
 	return 1;
-}
\ No newline at end of file
+}
+
+static const char* const codes[NB_OPS] = { "KI", "LO", "SO", "NI", "MA" };
+
+int codeCommande(const char* nom) {
+	for (int i = 0; i < NB_OPS; ++i) {
+		if (nom[0] == codes[i][0] && nom[1] == codes[i][1]) return i;
+	}
+	return -1;
+}
+
+const char* nomCommande(int code) {
+	assert(code >= 0 && code < NB_OPS);
+	return codes[code];
+}
+
+int compilerSequence(Commandes* commandes, const char* com, Sequence* seq) {
+	size_t longueur = strlen(com);
+	viderSequence(seq);
+	if (longueur % 2 != 0) {
+		return 2;
+	}
+	if (!reserverSequence(seq, (int64_t)(longueur / 2))) {
+		return 2;
+	}
+	for (size_t i = 0; i < longueur; i += 2) {
+		char commande[3] = { com[i], com[i + 1], '\0' };
+		int code = codeCommande(commande);
+		if (code < 0 || !verifierCommande(commandes, commande)) {
+			return 0;
+		}
+		ajouterSequence(seq, (uint8_t)code);
+	}
+	return 1;
+}
@@ -2,7 +2,7 @@
  * @file commandes.h
  * @brief Définition du type Commande et gestion de l’exécution des commandes.
  *
- * Ce module définit le type `Commande`, le type `Commandes` (conteneur basé sur `Vecteur`)
+ * Ce module définit le type `Commande`, le type `Commandes` (vecteur typé de `Commande`)
  * et les opérations permettant de créer, stocker, vérifier et exécuter des commandes
  * sur deux podiums (Bleu et Rouge).
  *
@@ -18,22 +18,26 @@
  * @brief Représente une commande par son code abrégé.
  */
 typedef struct {
-    char* nom_commande;
+    Nom nom_commande; /**< Nom interné de la commande. */
 } Commande;
 
+VECTEUR_DEF(VecteurCommande, Commande)
+
 /**
- * @brief Conteneur de commandes.
+ * @brief Conteneur de commandes, stockées par valeur.
  */
-typedef Vecteur Commandes;
+typedef VecteurCommande Commandes;
 
 /**
- * @brief Crée une commande à partir de son nom.
+ * @brief Initialise une commande à partir de son nom.
  *
+ * @param[out] c Commande à initialiser.
  * @param[in] nom Code de la commande (ex. "KI").
- * @return Un pointeur vers une commande initialisée ou `NULL` en cas d’erreur.
- * @pre `nom` n’est pas `NULL`.
+ * @param[in,out] noms Réserve où le nom est interné.
+ * @return `1` si l’opération réussit, `0` sinon.
+ * @pre `c` et `nom` ne sont pas `NULL`.
  */
-Commande* creerCommande(const char* nom);
+int creerCommande(Commande* c, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Initialise un conteneur de commandes.
@@ -50,10 +54,11 @@ int initCommandes(Commandes* commandes, int capacite);
  *
  * @param[in,out] commandes Conteneur de commandes.
  * @param[in] nom Code de la commande à ajouter.
+ * @param[in,out] noms Réserve où le nom est interné.
  * @return `1` si l’ajout réussit, `0` sinon.
  * @pre `commandes` est initialisé et `nom` n’est pas `NULL`.
  */
-int ajouterCommande(Commandes* commandes, const char* nom);
+int ajouterCommande(Commandes* commandes, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Récupère une commande à partir de son indice.
@@ -136,3 +141,49 @@ int verifierCommande(Commandes* commandes, char* commande);
  * @pre `commandes` est initialisé et `com` n’est pas `NULL`.
  */
 int executerLigneCommandes(Commandes* commandes, const char* com, Podium* podium_b, Podium* podium_r);
+
+/**
+ * @brief Codes des commandes compilées.
+ */
+typedef enum {
+    OP_KI, /**< Haut Bleu -> Haut Rouge. */
+    OP_LO, /**< Haut Rouge -> Haut Bleu. */
+    OP_SO, /**< Échange des hauts. */
+    OP_NI, /**< Bas Bleu -> Haut Bleu. */
+    OP_MA, /**< Bas Rouge -> Haut Rouge. */
+    NB_OPS
+} CodeCommande;
+
+VECTEUR_DEF(Sequence, uint8_t)
+
+/**
+ * @brief Retourne le code d’une commande.
+ *
+ * @param[in] nom Code abrégé (ex. "KI"), sur deux caractères.
+ * @return Le `CodeCommande`, ou `-1` si le nom n’est pas une commande connue.
+ */
+int codeCommande(const char* nom);
+
+/**
+ * @brief Retourne le nom abrégé d’une commande compilée.
+ *
+ * @param[in] code Code de la commande (`CodeCommande`).
+ * @return Le nom sur deux caractères (ex. "KI").
+ * @pre `0 <= code < NB_OPS`.
+ */
+const char* nomCommande(int code);
+
+/**
+ * @brief Compile une chaîne de commandes en une suite de codes.
+ *
+ * La séquence est vidée puis remplie. Les codes de retour sont ceux de
+ * `executerLigneCommandes`, sans exécution : une séquence compilée n’échoue
+ * plus que si une commande est impossible dans la situation courante.
+ *
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] com Chaîne de commandes (ex. "KISO").
+ * @param[out] seq Séquence initialisée recevant les codes.
+ * @return `1` si la compilation réussit, `0` si une commande n’est pas autorisée,
+ *         `2` si la chaîne est de longueur impaire (ou en cas de manque de mémoire).
+ */
+int compilerSequence(Commandes* commandes, const char* com, Sequence* seq);
@@ -2,9 +2,16 @@
 
 #include <assert.h> 
 #include <stdlib.h> 
+#include <errno.h>
 
 
 #include "config.h"
+#include "minuterie.h"
+
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#endif
 
 
 enum { BUFFER_SIZE = 64 };
@@ -42,16 +49,114 @@ char* readFullLine(FILE* f) {
 }
 
 
+char* prochainMot(char** curseur) {
+	char* debut = *curseur + strspn(*curseur, " \t");
+	if (*debut == '\0') {
+		*curseur = debut;
+		return NULL;
+	}
+	char* fin = debut + strcspn(debut, " \t");
+	if (*fin != '\0') {
+		*fin++ = '\0';
+	}
+	*curseur = fin;
+	return debut;
+}
+
+void initLecteurLignes(LecteurLignes* l, FILE* f) {
+	l->flux = f;
+	l->fin = 0;
+	initTampon(&l->tampon);
+}
+
+void detruireLecteurLignes(LecteurLignes* l) {
+	detruireTampon(&l->tampon);
+}
+
+#ifdef _WIN32
+
+char* lireLigneAvant(LecteurLignes* l, int64_t delai, int* expire) {
+	(void)delai;
+	*expire = 0;
+	return readFullLine(l->flux);
+}
+
+#else
+
+/* Extrait une ligne complète du tampon, ou la dernière ligne sans \n en fin de flux. */
+static char* extraireLigne(LecteurLignes* l) {
+	char* fin = l->tampon.taille ? memchr(l->tampon.donnees, '\n', l->tampon.taille) : NULL;
+	size_t longueur;
+	if (fin) {
+		longueur = (size_t)(fin - l->tampon.donnees);
+	}
+	else if (l->fin && l->tampon.taille > 0) {
+		longueur = l->tampon.taille;
+	}
+	else {
+		return NULL;
+	}
+
+	/* sans mémoire, la ligne reste dans le tampon */
+	char* ligne = (char*)malloc(longueur + 1);
+	if (!ligne) return NULL;
+	memcpy(ligne, l->tampon.donnees, longueur);
+	ligne[longueur] = '\0';
+	consommerTampon(&l->tampon, fin ? longueur + 1 : longueur);
+	return ligne;
+}
+
+char* lireLigneAvant(LecteurLignes* l, int64_t delai, int* expire) {
+	char buffer[BUFFER_SIZE * 64];
+	uint64_t limite = delai >= 0 ? maintenantMs() + (uint64_t)delai : 0;
+	*expire = 0;
+
+	for (;;) {
+		char* ligne = extraireLigne(l);
+		if (ligne || l->fin) return ligne;
+
+		int attente = -1;
+		if (delai >= 0) {
+			uint64_t maintenant = maintenantMs();
+			if (maintenant >= limite) {
+				*expire = 1;
+				return NULL;
+			}
+			attente = (int)(limite - maintenant);
+		}
+
+		struct pollfd p = { fileno(l->flux), POLLIN, 0 };
+		int n = poll(&p, 1, attente);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			l->fin = 1;
+			continue;
+		}
+		if (n == 0) continue;
+
+		ssize_t lu = read(p.fd, buffer, sizeof(buffer));
+		if (lu > 0) {
+			ajouterTampon(&l->tampon, buffer, (size_t)lu);
+		}
+		else if (lu == 0 || errno != EINTR) {
+			l->fin = 1;
+		}
+	}
+}
+
+#endif
+
 char** splitLineAndCount(char* line, int* count) {
 	
 	char* tmp_ligne = strdup(line);
-	char* element = strtok(tmp_ligne, " \t");
+	char* curseur = tmp_ligne;
+	char* element = prochainMot(&curseur);
 	int n = 0;
 
 	while (element) {
 		++n;
 		
-		element = strtok(NULL, " \t");
+		element = prochainMot(&curseur);
 		
 	}
 	free(tmp_ligne);
@@ -60,7 +165,8 @@ char** splitLineAndCount(char* line, int* count) {
 	char** noms = (char**)malloc(n * sizeof(char*));
 	
 	tmp_ligne = strdup(line);
-	element = strtok(tmp_ligne, " \t");
+	curseur = tmp_ligne;
+	element = prochainMot(&curseur);
 	
 	for (int i = 0; i < n; ++i) {
 		
@@ -69,7 +175,7 @@ char** splitLineAndCount(char* line, int* count) {
 		strcpy(noms[i], element);
 		
 		
-		element = strtok(NULL, " \t");
+		element = prochainMot(&curseur);
 		
 	}
 	
@@ -80,60 +186,75 @@ char** splitLineAndCount(char* line, int* count) {
 
 
 
-int loadConfig(const char* fichier, Animaux* a, Commandes* c){
+void libererMots(char** mots, int count) {
+	for (int i = 0; i < count; ++i) {
+		free(mots[i]);
+	}
+	free(mots);
+}
+
+int loadConfig(const char* fichier, Animaux* a, Commandes* c, Arene* arene){
 	if (!fichier || !a || !c) return -1;
 
 	FILE* f = fopen(fichier, "r");
-	
+	if (!f) return -1;
 
+	/* les deux lignes sont lues d’abord pour dimensionner la réserve de noms */
+	char* ligne_animaux = readFullLine(f);
+	char* ligne_commandes = readFullLine(f);
+	fclose(f);
 
-	char* line = readFullLine(f);
-	if (line) {
-		int n = 0;
-		char** noms = splitLineAndCount(line, &n);
-		
-		initAnimaux(a, n);
-		for (int i = 0; i < n; ++i) {
-			ajouterAnimal(a, noms[i]);
+	size_t nb_octets = (ligne_animaux ? strlen(ligne_animaux) + 1 : 0)
+		+ (ligne_commandes ? strlen(ligne_commandes) + 1 : 0);
+	int n_animaux = 0;
+	int n_commandes = 0;
+	char** animaux = ligne_animaux ? splitLineAndCount(ligne_animaux, &n_animaux) : NULL;
+	char** commandes = ligne_commandes ? splitLineAndCount(ligne_commandes, &n_commandes) : NULL;
+
+	PoolNoms noms;
+	int resultat = initPoolNoms(&noms, nb_octets, (size_t)(n_animaux + n_commandes), arene) ? 0 : -1;
+
+	if (resultat == 0 && ligne_animaux) {
+		initAnimaux(a, n_animaux > 0 ? n_animaux : 1);
+		for (int i = 0; i < n_animaux && resultat == 0; ++i) {
+			if (!ajouterAnimal(a, animaux[i], &noms)) resultat = -1;
 		}
-		
-		free(line);
 	}
 
 	// +++++++++++++++++++++++++++++++++++++++++
 
-	line = readFullLine(f);
-	if (line) {
-		int n = 0;
-		char** noms = splitLineAndCount(line, &n);
-		
-		initCommandes(c, n);
-		
-		for (int i = 0; i < n; ++i) {
-			
-			if (!ajouterCommande(c, noms[i])) {
-				
-				return 1;
-			}
+	if (resultat == 0 && ligne_commandes) {
+		initCommandes(c, n_commandes > 0 ? n_commandes : 1);
+		for (int i = 0; i < n_commandes && resultat == 0; ++i) {
+			if (!ajouterCommande(c, commandes[i], &noms)) resultat = 1;
 		}
-		free(line);
-
 	}
 
 	//+++++++++++++++++++++++++++++++++++
 
-
-	fclose(f);
-	return 0;
+	libererMots(animaux, n_animaux);
+	libererMots(commandes, n_commandes);
+	free(ligne_animaux);
+	free(ligne_commandes);
+	return resultat;
 }
 
 
-int loadJoueurs(Joueurs* joueurs, int nb_joueurs, char** noms) {
-	
-	initJoueurs(joueurs, nb_joueurs);
+int loadJoueurs(Joueurs* joueurs, int nb_joueurs, char** noms, Arene* arene) {
+	size_t nb_octets = 0;
 	for (int i = 0; i < nb_joueurs; ++i) {
-		ajouterJoueur(joueurs, noms[i]);
+		nb_octets += strlen(noms[i]) + 1;
+	}
+	PoolNoms pool;
+	if (!initPoolNoms(&pool, nb_octets, (size_t)nb_joueurs, arene)) {
+		return -1;
+	}
+
+	initJoueurs(joueurs, nb_joueurs > 0 ? nb_joueurs : 1);
+	for (int i = 0; i < nb_joueurs; ++i) {
+		if (!ajouterJoueur(joueurs, noms[i], &pool)) {
+			return -1;
+		}
 	}
 	return 0;
 }
-
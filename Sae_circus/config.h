@@ -15,6 +15,7 @@
 
 #include <stdio.h>
 #include "cartes.h"
+#include "sortie.h"
 
 /**
  * @brief Initialise une structure de joueurs à partir d’une liste de noms.
@@ -22,10 +23,11 @@
  * @param[out] joueurs Conteneur de joueurs à initialiser.
  * @param[in] nb_joueurs Nombre de joueurs.
  * @param[in] noms Tableau de chaînes contenant les noms des joueurs.
+ * @param[in,out] arene Arène recevant les joueurs.
  * @return `0` si l’opération réussit, une valeur non nulle sinon.
  * @pre `joueurs` n’est pas `NULL`, `nb_joueurs >= 0` et `noms` n’est pas `NULL`.
  */
-int loadJoueurs(Joueurs* joueurs, int nb_joueurs, char** noms);
+int loadJoueurs(Joueurs* joueurs, int nb_joueurs, char** noms, Arene* arene);
 
 /**
  * @brief Charge la configuration du jeu depuis un fichier.
@@ -37,24 +39,47 @@ int loadJoueurs(Joueurs* joueurs, int nb_joueurs, char** noms);
  * @param[in] fichier Chemin du fichier de configuration.
  * @param[out] a Conteneur d’animaux.
  * @param[out] c Conteneur de commandes.
+ * @param[in,out] arene Arène recevant les animaux, les commandes et leurs noms.
  * @return
  *   - `0` si le chargement réussit,
  *   - `1` si une commande est invalide,
  *   - `-1` si les paramètres sont invalides.
  * @pre `fichier`, `a` et `c` ne sont pas `NULL`.
  */
-int loadConfig(const char* fichier, Animaux* a, Commandes* c);
+int loadConfig(const char* fichier, Animaux* a, Commandes* c, Arene* arene);
 
 /**
  * @brief Découpe une ligne en mots séparés par des espaces ou tabulations.
  *
  * @param[in] line Ligne à découper.
  * @param[out] count Nombre de mots trouvés.
- * @return Un tableau de chaînes alloué dynamiquement ou `NULL` en cas d’erreur.
+ * @return Un tableau de chaînes alloué dynamiquement ou `NULL` en cas d’erreur,
+ *         à libérer avec `libererMots`.
  * @pre `line` et `count` ne sont pas `NULL`.
  */
 char** splitLineAndCount(char* line, int* count);
 
+/**
+ * @brief Libère un tableau de mots retourné par `splitLineAndCount`.
+ *
+ * @param[in,out] mots Tableau de mots.
+ * @param[in] count Nombre de mots.
+ */
+void libererMots(char** mots, int count);
+
+/**
+ * @brief Extrait le prochain mot (séparé par des espaces ou tabulations) d’une ligne.
+ *
+ * Équivalent réentrant de `strtok` : l’état de découpage est porté par `curseur`,
+ * ce qui permet de découper des lignes en parallèle depuis plusieurs threads.
+ * Le séparateur suivant le mot est remplacé par `\0`.
+ *
+ * @param[in,out] curseur Position courante dans la ligne, avancée après le mot.
+ * @return Le mot trouvé, ou `NULL` s’il n’en reste plus.
+ * @pre `curseur` et `*curseur` ne sont pas `NULL`.
+ */
+char* prochainMot(char** curseur);
+
 /**
  * @brief Lit une ligne complète depuis un flux.
  *
@@ -64,6 +89,46 @@ char** splitLineAndCount(char* line, int* count);
  */
 char* readFullLine(FILE* f);
 
+/**
+ * @brief Lecteur de lignes avec délai d’attente, pour ne pas bloquer indéfiniment sur l’entrée.
+ *
+ * Le lecteur lit directement le descripteur du flux : il ne faut pas mélanger
+ * ses lectures avec celles de `readFullLine` sur le même flux.
+ */
+typedef struct {
+    FILE* flux;     /**< Flux lu. */
+    Tampon tampon;  /**< Octets lus mais pas encore rendus. */
+    int fin;        /**< Fin de flux atteinte. */
+} LecteurLignes;
+
+/**
+ * @brief Initialise un lecteur de lignes.
+ *
+ * @param[out] l Lecteur.
+ * @param[in] f Flux d’entrée.
+ */
+void initLecteurLignes(LecteurLignes* l, FILE* f);
+
+/**
+ * @brief Lit une ligne en attendant au plus `delai` millisecondes.
+ *
+ * Sous Windows, l’attente n’est pas bornée : la ligne est lue avec `readFullLine`.
+ *
+ * @param[in,out] l Lecteur.
+ * @param[in] delai Attente maximale (ms), ou `-1` pour attendre sans limite.
+ * @param[out] expire Reçoit `1` si le délai est écoulé sans ligne complète, `0` sinon.
+ * @return Une ligne allouée dynamiquement (sans `\n`), ou `NULL` en fin de flux, à l’expiration
+ *         ou en cas de manque de mémoire.
+ */
+char* lireLigneAvant(LecteurLignes* l, int64_t delai, int* expire);
+
+/**
+ * @brief Libère la mémoire d’un lecteur.
+ *
+ * @param[in,out] l Lecteur.
+ */
+void detruireLecteurLignes(LecteurLignes* l);
+
 /**
  * @brief Retourne le podium le plus grand parmi quatre.
  *
@@ -0,0 +1,163 @@
+#include "distance.h"
+
+/* distance maximale représentable dans la table */
+enum { DISTANCE_MAX = UINT8_MAX };
+
+
+int initTableDistances(TableDistances* table, int64_t max_etats) {
+	assert(max_etats >= 1);
+	uint64_t nb_cases = 2;
+	while (nb_cases < 2 * (uint64_t)max_etats) nb_cases *= 2;
+
+	table->cles = (CleEtat*)allouerMemoire(MEMOIRE_TABLES, sizeof(CleEtat) * (size_t)nb_cases);
+	table->distances = (uint8_t*)allouerMemoire(MEMOIRE_TABLES, (size_t)nb_cases);
+	table->file = (CleEtat*)allouerMemoire(MEMOIRE_TABLES, sizeof(CleEtat) * (size_t)max_etats);
+	table->masque = nb_cases - 1;
+	table->max_etats = max_etats;
+	table->nb_etats = 0;
+	table->cible = CLE_INVALIDE;
+	table->profondeur = -1;
+	table->complete = 0;
+	if (!table->cles || !table->distances || !table->file) {
+		detruireTableDistances(table);
+		return 0;
+	}
+	for (uint64_t i = 0; i < nb_cases; ++i) {
+		table->cles[i] = CLE_INVALIDE;
+	}
+	return 1;
+}
+
+void detruireTableDistances(TableDistances* table) {
+	size_t nb_cases = (size_t)table->masque + 1;
+	libererMemoire(MEMOIRE_TABLES, table->cles, sizeof(CleEtat) * nb_cases);
+	libererMemoire(MEMOIRE_TABLES, table->distances, nb_cases);
+	libererMemoire(MEMOIRE_TABLES, table->file, sizeof(CleEtat) * (size_t)table->max_etats);
+	table->cles = NULL;
+	table->distances = NULL;
+	table->file = NULL;
+	table->cible = CLE_INVALIDE;
+}
+
+/* case de la situation, ou case vide où l’insérer */
+static uint64_t caseDistance(const TableDistances* table, CleEtat cle) {
+	uint64_t i = hacherCleEtat(cle) & table->masque;
+	while (table->cles[i] != CLE_INVALIDE && table->cles[i] != cle) {
+		i = (i + 1) & table->masque;
+	}
+	return i;
+}
+
+static void insererDistance(TableDistances* table, CleEtat cle, int distance) {
+	uint64_t i = caseDistance(table, cle);
+	if (table->cles[i] == cle) return;
+	table->cles[i] = cle;
+	table->distances[i] = (uint8_t)distance;
+	table->file[table->nb_etats++] = cle;
+}
+
+void calculerDistances(TableDistances* table, CleEtat cible, int n, const Commandes* commandes, int profondeur_max) {
+	int present[NB_OPS] = { 0 };
+	table->n = n;
+	table->nb_ops = 0;
+	for (int i = 0; i < commandes->nbElements; ++i) {
+		int code = codeCommande(commandes->elements[i].nom_commande.texte);
+		if (code >= 0 && !present[code]) {
+			present[code] = 1;
+			table->ops[table->nb_ops++] = (uint8_t)code;
+		}
+	}
+	int nb_ops = table->nb_ops;
+	if (profondeur_max > DISTANCE_MAX) profondeur_max = DISTANCE_MAX;
+
+	/* seules les cases du calcul précédent sont vidées, de la dernière insérée à la première :
+	   chaque situation est alors encore trouvée au bout de son sondage */
+	for (int64_t k = table->nb_etats - 1; k >= 0; --k) {
+		table->cles[caseDistance(table, table->file[k])] = CLE_INVALIDE;
+	}
+	table->nb_etats = 0;
+	table->cible = cible;
+	table->complete = 0;
+	insererDistance(table, cible, 0);
+
+	/* niveau d : situations file[debut..fin) */
+	int64_t debut = 0;
+	int d = 0;
+	for (;;) {
+		int64_t fin = table->nb_etats;
+		if (debut == fin) {
+			table->complete = 1;
+			break;
+		}
+		/* le niveau suivant doit tenir entièrement, sinon le parcours s’arrête au niveau d */
+		if (d + 1 > profondeur_max || table->nb_etats + (fin - debut) * nb_ops > table->max_etats) {
+			break;
+		}
+		for (int64_t k = debut; k < fin; ++k) {
+			for (int o = 0; o < nb_ops; ++o) {
+				CleEtat precedente = table->file[k];
+				if (appliquerCommandeInverseCle(&precedente, n, table->ops[o])) {
+					insererDistance(table, precedente, d + 1);
+				}
+			}
+		}
+		debut = fin;
+		++d;
+	}
+	table->profondeur = d;
+}
+
+int distanceMinimale(const TableDistances* table, CleEtat cle) {
+	uint64_t i = caseDistance(table, cle);
+	if (table->cles[i] == cle) return table->distances[i];
+	return table->complete ? DISTANCE_INFINIE : table->profondeur + 1;
+}
+
+int cheminOptimal(const TableDistances* table, CleEtat depart, Sequence* chemin) {
+	viderSequence(chemin);
+	int d = distanceMinimale(table, depart);
+	if (d > table->profondeur) return 0;
+
+	/* chaque pas mène à une situation plus proche d’une unité */
+	CleEtat cle = depart;
+	for (; d > 0; --d) {
+		int trouve = 0;
+		for (int o = 0; o < table->nb_ops && !trouve; ++o) {
+			CleEtat suivante = cle;
+			if (appliquerCommandeCle(&suivante, table->n, table->ops[o])
+				&& distanceMinimale(table, suivante) == d - 1) {
+				if (!ajouterSequence(chemin, table->ops[o])) return 0;
+				cle = suivante;
+				trouve = 1;
+			}
+		}
+		if (!trouve) return 0;
+	}
+	return 1;
+}
+
+int executerLigneElaguee(const TableDistances* table, Commandes* commandes, const char* com, CleEtat* cle, int n) {
+	Sequence seq;
+	if (!initSequence(&seq, 0)) {
+		return 2;
+	}
+	/* en cas de commande inconnue, la séquence garde les commandes qui la précèdent */
+	int compilation = compilerSequence(commandes, com, &seq);
+	int resultat = compilation;
+	if (compilation != 2) {
+		/* une fois la cible hors d’atteinte, les commandes restantes ne sont plus que vérifiées */
+		int elaguee = compilation != 1;
+		for (int64_t i = 0; i < seq.nbElements; ++i) {
+			if (!elaguee && (int64_t)distanceMinimale(table, *cle) > seq.nbElements - i) {
+				elaguee = 1;
+			}
+			if (!appliquerCommandeCle(cle, n, seq.elements[i])) {
+				/* une commande impossible avant une commande inconnue l’emporte, comme dans la boucle naïve */
+				resultat = 2;
+				break;
+			}
+		}
+	}
+	detruireSequence(&seq);
+	return resultat;
+}
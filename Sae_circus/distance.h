@@ -0,0 +1,112 @@
+/**
+ * @file distance.h
+ * @brief Distances à la situation cible d’un tour, pour rejeter tôt les chaînes perdantes.
+ *
+ * Au début d’un tour, un parcours en largeur remonte les commandes autorisées à
+ * partir de la situation cible : chaque situation rencontrée reçoit le nombre
+ * minimal de commandes qui la mènent à la cible. Le parcours est borné par un
+ * nombre de situations (et, au besoin, une profondeur) ; il s’arrête toujours
+ * entre deux niveaux, si bien que toute situation absente de la table est à une
+ * distance strictement supérieure au dernier niveau complet. `distanceMinimale` est donc toujours un minorant
+ * exact, et la distance exacte quand la situation a été atteinte.
+ *
+ * Une chaîne de moins de commandes que la distance de la situation de départ
+ * ne peut pas réussir ; en cours d’exécution, la cible est hors d’atteinte dès
+ * que les commandes restantes ne suffisent plus à combler la distance. La chaîne
+ * reste vérifiée jusqu’au bout, pour garder le verdict d’une exécution complète.
+ */
+
+#pragma once
+
+#include <limits.h>
+#include "etat.h"
+
+/** @brief Distance d’une situation d’où la cible est inaccessible. */
+#define DISTANCE_INFINIE INT_MAX
+
+/** @brief Nombre de situations explorées par défaut à chaque tour. */
+enum { MAX_ETATS_DISTANCE = 1 << 16 };
+
+/**
+ * @brief Table des distances à une situation cible.
+ */
+typedef struct {
+    CleEtat* cles;        /**< Table ouverte (sondage linéaire), `CLE_INVALIDE` pour une case vide. */
+    uint8_t* distances;   /**< Distance de la situation de même indice. */
+    CleEtat* file;        /**< Situations dans l’ordre du parcours (par distance croissante). */
+    uint64_t masque;      /**< Nombre de cases moins un (puissance de deux). */
+    int64_t max_etats;    /**< Nombre maximal de situations explorées. */
+    int64_t nb_etats;     /**< Nombre de situations dans la table. */
+    CleEtat cible;        /**< Situation cible, `CLE_INVALIDE` si la table n’est pas calculée. */
+    int profondeur;       /**< Toutes les situations à distance au plus `profondeur` sont dans la table. */
+    int complete;         /**< `1` si toutes les situations d’où la cible est accessible sont dans la table. */
+    int n;                /**< Nombre d’animaux. */
+    uint8_t ops[NB_OPS];  /**< Codes des commandes autorisées. */
+    int nb_ops;
+} TableDistances;
+
+/**
+ * @brief Initialise une table vide.
+ *
+ * @param[out] table Table à initialiser.
+ * @param[in] max_etats Nombre maximal de situations explorées par calcul.
+ * @return `1` si l’initialisation réussit, `0` sinon.
+ * @pre `max_etats >= 1`.
+ */
+int initTableDistances(TableDistances* table, int64_t max_etats);
+
+/**
+ * @brief Libère une table.
+ *
+ * @param[in,out] table Table à libérer.
+ */
+void detruireTableDistances(TableDistances* table);
+
+/**
+ * @brief Calcule les distances à une situation cible avec les commandes autorisées.
+ *
+ * @param[in,out] table Table, vidée puis remplie.
+ * @param[in] cible Situation cible.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] profondeur_max Distance au-delà de laquelle le parcours s’arrête (`DISTANCE_INFINIE` pour aucune limite).
+ * @pre `cible` n’est pas `CLE_INVALIDE` et `n <= MAX_ANIMAUX_CLE`.
+ */
+void calculerDistances(TableDistances* table, CleEtat cible, int n, const Commandes* commandes, int profondeur_max);
+
+/**
+ * @brief Retourne un minorant du nombre de commandes menant une situation à la cible.
+ *
+ * @param[in] table Table calculée.
+ * @param[in] cle Situation.
+ * @return La distance exacte si la situation est dans la table, sinon
+ *         `profondeur + 1`, ou `DISTANCE_INFINIE` si la table est complète.
+ */
+int distanceMinimale(const TableDistances* table, CleEtat cle);
+
+/**
+ * @brief Reconstruit une plus courte séquence de commandes menant une situation à la cible.
+ *
+ * @param[in] table Table calculée.
+ * @param[in] depart Situation de départ.
+ * @param[out] chemin Séquence vidée puis remplie (codes `CodeCommande`).
+ * @return `1` si la distance de `depart` est connue et le chemin construit, `0` sinon.
+ */
+int cheminOptimal(const TableDistances* table, CleEtat depart, Sequence* chemin);
+
+/**
+ * @brief Exécute une chaîne en cessant de consulter la table dès qu’elle ne peut plus atteindre la cible.
+ *
+ * Avant chaque commande, si le nombre de commandes restantes est inférieur à la
+ * distance de la situation atteinte, la cible est hors d’atteinte : les commandes
+ * restantes sont seulement appliquées pour vérifier qu’elles sont possibles, si
+ * bien que le verdict est toujours celui de `executerLigneCommandes`.
+ *
+ * @param[in] table Table calculée pour la cible du tour.
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] com Chaîne de commandes.
+ * @param[in,out] cle Situation de départ, puis situation atteinte.
+ * @param[in] n Nombre d’animaux.
+ * @return Les mêmes codes que `executerLigneCommandes` (`1`, `0` ou `2`).
+ */
+int executerLigneElaguee(const TableDistances* table, Commandes* commandes, const char* com, CleEtat* cle, int n);
@@ -0,0 +1,141 @@
+#include "etat.h"
+
+
+CleEtat empaqueterPodiums(const Podium* b, const Podium* r) {
+	int64_t n = b->nbElements + r->nbElements;
+	if (n > MAX_ANIMAUX_CLE) return CLE_INVALIDE;
+
+	CleEtat cle = (CleEtat)b->nbElements;
+	int decalage = 4;
+	for (int64_t i = 0; i < b->nbElements; ++i, decalage += 4) {
+		cle |= (CleEtat)b->elements[i] << decalage;
+	}
+	for (int64_t i = 0; i < r->nbElements; ++i, decalage += 4) {
+		cle |= (CleEtat)r->elements[i] << decalage;
+	}
+	return cle;
+}
+
+CleEtat empaqueterCarte(const int* carte, int n) {
+	if (n > MAX_ANIMAUX_CLE) return CLE_INVALIDE;
+
+	CleEtat cle = (CleEtat)carte[0];
+	for (int i = 0; i < n; ++i) {
+		cle |= (CleEtat)carte[i + 1] << (4 + 4 * i);
+	}
+	return cle;
+}
+
+int depaqueterPodiums(CleEtat cle, int n, Podium* b, Podium* r) {
+	int split = (int)(cle & 0xF);
+	clearPodium(b);
+	clearPodium(r);
+	for (int i = 0; i < n; ++i) {
+		int animal = (int)((cle >> (4 + 4 * i)) & 0xF);
+		if (!ajouterPodiumAnimal(i < split ? b : r, animal)) return 0;
+	}
+	return 1;
+}
+
+uint64_t hacherCleEtat(CleEtat cle) {
+	/* finaliseur de splitmix64 */
+	cle ^= cle >> 30;
+	cle *= 0xBF58476D1CE4E5B9ULL;
+	cle ^= cle >> 27;
+	cle *= 0x94D049BB133111EBULL;
+	cle ^= cle >> 31;
+	return cle;
+}
+
+/* masque des quartets [a, b) de la permutation */
+static uint64_t masqueSegment(int a, int b) {
+	return (((uint64_t)1 << (4 * b)) - 1) ^ (((uint64_t)1 << (4 * a)) - 1);
+}
+
+/* le quartet a passe en b-1, les autres descendent d’une place */
+static uint64_t tournerGauche(uint64_t x, int a, int b) {
+	uint64_t m = masqueSegment(a, b);
+	uint64_t premier = (x >> (4 * a)) & 0xF;
+	return (x & ~m) | (((x & m) >> 4) & m) | (premier << (4 * (b - 1)));
+}
+
+/* le quartet b-1 passe en a, les autres montent d’une place */
+static uint64_t tournerDroite(uint64_t x, int a, int b) {
+	uint64_t m = masqueSegment(a, b);
+	uint64_t dernier = (x >> (4 * (b - 1))) & 0xF;
+	return (x & ~m) | (((x & m) << 4) & m) | (dernier << (4 * a));
+}
+
+static uint64_t echangerQuartets(uint64_t x, int i, int j) {
+	uint64_t vi = (x >> (4 * i)) & 0xF;
+	uint64_t vj = (x >> (4 * j)) & 0xF;
+	x &= ~(((uint64_t)0xF << (4 * i)) | ((uint64_t)0xF << (4 * j)));
+	return x | (vi << (4 * j)) | (vj << (4 * i));
+}
+
+int appliquerCommandeCle(CleEtat* cle, int n, int op) {
+	uint64_t perm = *cle >> 4;
+	int split = (int)(*cle & 0xF);
+
+	switch (op) {
+	case OP_KI:
+		if (split < 1) return 0;
+		perm = tournerGauche(perm, split - 1, n);
+		--split;
+		break;
+	case OP_LO:
+		if (split >= n) return 0;
+		perm = tournerDroite(perm, split, n);
+		++split;
+		break;
+	case OP_SO:
+		if (split < 1 || split >= n) return 0;
+		perm = echangerQuartets(perm, split - 1, n - 1);
+		break;
+	case OP_NI:
+		if (split < 1) return 0;
+		perm = tournerGauche(perm, 0, split);
+		break;
+	case OP_MA:
+		if (split >= n) return 0;
+		perm = tournerGauche(perm, split, n);
+		break;
+	default:
+		return 0;
+	}
+	*cle = (perm << 4) | (CleEtat)split;
+	return 1;
+}
+
+int appliquerCommandeInverseCle(CleEtat* cle, int n, int op) {
+	uint64_t perm = *cle >> 4;
+	int split = (int)(*cle & 0xF);
+
+	switch (op) {
+	case OP_KI:
+	case OP_LO:
+		/* KI et LO sont inverses l’une de l’autre */
+		return appliquerCommandeCle(cle, n, op == OP_KI ? OP_LO : OP_KI);
+	case OP_SO:
+		return appliquerCommandeCle(cle, n, OP_SO);
+	case OP_NI:
+		if (split < 1) return 0;
+		perm = tournerDroite(perm, 0, split);
+		break;
+	case OP_MA:
+		if (split >= n) return 0;
+		perm = tournerDroite(perm, split, n);
+		break;
+	default:
+		return 0;
+	}
+	*cle = (perm << 4) | (CleEtat)split;
+	return 1;
+}
+
+int64_t executerSequenceCle(CleEtat* cle, int n, const uint8_t* ops, int64_t nb) {
+	for (int64_t i = 0; i < nb; ++i) {
+		if (!appliquerCommandeCle(cle, n, ops[i])) return i;
+	}
+	return -1;
+}
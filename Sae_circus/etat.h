@@ -0,0 +1,101 @@
+/**
+ * @file etat.h
+ * @brief Représentation compacte d’une situation (podiums Bleu et Rouge) sur 64 bits.
+ *
+ * Pour au plus `MAX_ANIMAUX_CLE` animaux, une situation tient dans un entier :
+ * - bits 0 à 3 : nombre d’animaux sur le podium Bleu (le split) ;
+ * - bits 4 + 4k à 7 + 4k : indice du k-ième animal, en parcourant le podium Bleu
+ *   du bas vers le haut puis le podium Rouge du bas vers le haut.
+ *
+ * C’est exactement la disposition d’une carte (`arr[0]` = split, puis la permutation).
+ * Deux situations sont égales si et seulement si leurs clés le sont, ce qui fait
+ * de la clé une comparaison en une instruction et une clé de table de hachage.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "commandes.h"
+
+/** @brief Situation empaquetée. */
+typedef uint64_t CleEtat;
+
+enum { MAX_ANIMAUX_CLE = 15 };
+
+/** @brief Valeur qu’aucune situation valide ne peut avoir. */
+#define CLE_INVALIDE UINT64_MAX
+
+/**
+ * @brief Empaquette deux podiums.
+ *
+ * @param[in] b Podium Bleu.
+ * @param[in] r Podium Rouge.
+ * @return La clé de la situation, ou `CLE_INVALIDE` s’il y a plus de `MAX_ANIMAUX_CLE` animaux.
+ */
+CleEtat empaqueterPodiums(const Podium* b, const Podium* r);
+
+/**
+ * @brief Empaquette une carte (`arr[0]` = split, `arr[1..n]` = permutation).
+ *
+ * @param[in] carte Carte.
+ * @param[in] n Nombre d’animaux.
+ * @return La clé de la situation, ou `CLE_INVALIDE` si `n > MAX_ANIMAUX_CLE`.
+ */
+CleEtat empaqueterCarte(const int* carte, int n);
+
+/**
+ * @brief Reconstruit les podiums à partir d’une clé.
+ *
+ * @param[in] cle Clé d’une situation.
+ * @param[in] n Nombre d’animaux de la situation.
+ * @param[out] b Podium Bleu (vidé puis rempli).
+ * @param[out] r Podium Rouge (vidé puis rempli).
+ * @return `1` si l’opération réussit, `0` sinon.
+ * @pre `cle` n’est pas `CLE_INVALIDE` et `n <= MAX_ANIMAUX_CLE`.
+ */
+int depaqueterPodiums(CleEtat cle, int n, Podium* b, Podium* r);
+
+/**
+ * @brief Mélange les bits d’une clé pour l’indexation dans une table de hachage.
+ *
+ * @param[in] cle Clé.
+ * @return Un hachage 64 bits de la clé.
+ */
+uint64_t hacherCleEtat(CleEtat cle);
+
+/**
+ * @brief Applique une commande compilée à une situation empaquetée.
+ *
+ * Le résultat est identique à celui de `executerCommande` sur les podiums
+ * correspondants.
+ *
+ * @param[in,out] cle Situation, modifiée seulement si la commande est possible.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] op Code de la commande (`CodeCommande`).
+ * @return `1` si la commande a été exécutée, `0` si elle est impossible.
+ * @pre `*cle` n’est pas `CLE_INVALIDE`.
+ */
+int appliquerCommandeCle(CleEtat* cle, int n, int op);
+
+/**
+ * @brief Remonte une commande : calcule la situation d’où la commande mène à `cle`.
+ *
+ * @param[in,out] cle Situation atteinte, remplacée par la situation précédente si elle existe.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] op Code de la commande (`CodeCommande`).
+ * @return `1` si une situation précédente existe, `0` sinon (`cle` est alors inchangée).
+ * @pre `*cle` n’est pas `CLE_INVALIDE`.
+ */
+int appliquerCommandeInverseCle(CleEtat* cle, int n, int op);
+
+/**
+ * @brief Applique une séquence compilée, en s’arrêtant à la première commande impossible.
+ *
+ * @param[in,out] cle Situation de départ, puis situation atteinte.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] ops Codes des commandes.
+ * @param[in] nb Nombre de commandes.
+ * @return L’indice de la première commande impossible, ou `-1` si toutes ont été exécutées.
+ */
+int64_t executerSequenceCle(CleEtat* cle, int n, const uint8_t* ops, int64_t nb);
+
@@ -0,0 +1,288 @@
+#include "executeur.h"
+
+
+/* fonction préfixe de KMP des séries du segment courant */
+VECTEUR_DEF(Prefixes, int64_t)
+
+/* compilation en cours : le segment courant commence à la série `debut` */
+typedef struct {
+	LigneCompilee* ligne;
+	Prefixes prefixe;   /* bords des séries stockées du segment courant */
+	int64_t debut;
+	int64_t nb_series;  /* séries du segment courant, développé */
+	int64_t periode;    /* plus courte période du segment courant */
+	int compresse;      /* au moins deux périodes vues : les suivantes ne sont plus stockées */
+	int64_t rang;       /* en mode compressé, rang dans le bloc de la prochaine série attendue */
+} Compilation;
+
+static int memeSerie(Serie a, Serie b) {
+	return a.op == b.op && a.nb == b.nb;
+}
+
+/* termine le segment courant : seul son bloc est conservé */
+static int fermerSegment(Compilation* c) {
+	if (c->nb_series == 0) return 1;
+	Segment segment = { c->debut, c->periode, c->nb_series };
+	c->ligne->series.nbElements = c->debut + c->periode;
+	if (!ajouterSegments(&c->ligne->segments, segment)) return 0;
+	c->debut = c->ligne->series.nbElements;
+	c->nb_series = 0;
+	c->periode = 0;
+	c->compresse = 0;
+	viderPrefixes(&c->prefixe);
+	return 1;
+}
+
+/* ajoute une série terminée au segment courant */
+static int pousserSerie(Compilation* c, Serie serie) {
+	Series* series = &c->ligne->series;
+	if (c->compresse) {
+		if (memeSerie(serie, series->elements[c->debut + c->rang])) {
+			++c->nb_series;
+			if (++c->rang == c->periode) c->rang = 0;
+			return 1;
+		}
+		/* la répétition s’arrête : le bloc répété devient un segment */
+		if (!fermerSegment(c)) return 0;
+	}
+
+	int64_t i = c->nb_series;
+	if (!ajouterSeries(series, serie)) return 0;
+	Serie* s = series->elements + c->debut;
+	int64_t k = 0;
+	if (i > 0) {
+		k = c->prefixe.elements[i - 1];
+		while (k > 0 && !memeSerie(s[i], s[k])) {
+			k = c->prefixe.elements[k - 1];
+		}
+		if (memeSerie(s[i], s[k])) ++k;
+	}
+	if (!ajouterPrefixes(&c->prefixe, k)) return 0;
+	c->nb_series = i + 1;
+	c->periode = c->nb_series - k;
+	c->compresse = c->nb_series >= 2 * c->periode;
+	c->rang = c->nb_series % c->periode;
+	return 1;
+}
+
+int initLigneCompilee(LigneCompilee* ligne) {
+	if (!initSeries(&ligne->series, 8)) return 0;
+	if (!initSegments(&ligne->segments, 2)) {
+		detruireSeries(&ligne->series);
+		return 0;
+	}
+	return 1;
+}
+
+void detruireLigneCompilee(LigneCompilee* ligne) {
+	detruireSeries(&ligne->series);
+	detruireSegments(&ligne->segments);
+}
+
+int compilerLigne(Commandes* commandes, const char* com, LigneCompilee* ligne) {
+	size_t longueur = strlen(com);
+	viderSeries(&ligne->series);
+	viderSegments(&ligne->segments);
+	if (longueur % 2 != 0) {
+		return 2;
+	}
+
+	Compilation c = { 0 };
+	c.ligne = ligne;
+	int resultat = 1;
+	/* vérifie chaque nom distinct une seule fois */
+	int autorise[NB_OPS] = { -1, -1, -1, -1, -1 };
+	Serie courante = { 0, 0 };
+	for (size_t i = 0; i < longueur; i += 2) {
+		/* même commande que la précédente : la série s’allonge sans nouvelle vérification */
+		if (i > 0 && com[i] == com[i - 2] && com[i + 1] == com[i - 1]) {
+			++courante.nb;
+			continue;
+		}
+		char commande[3] = { com[i], com[i + 1], '\0' };
+		int code = codeCommande(commande);
+		if (code >= 0 && autorise[code] < 0) {
+			autorise[code] = verifierCommande(commandes, commande);
+		}
+		if (code < 0 || !autorise[code]) {
+			resultat = 0;
+			break;
+		}
+
+		if (courante.nb > 0 && courante.op == code) {
+			++courante.nb;
+			continue;
+		}
+		if (courante.nb > 0 && !pousserSerie(&c, courante)) {
+			resultat = 2;
+			break;
+		}
+		courante.op = (uint8_t)code;
+		courante.nb = 1;
+	}
+	if (resultat != 2 && courante.nb > 0 && !pousserSerie(&c, courante)) {
+		resultat = 2;
+	}
+	if (resultat != 2 && !fermerSegment(&c)) {
+		resultat = 2;
+	}
+	detruirePrefixes(&c.prefixe);
+	return resultat;
+}
+
+/* rotation vers le bas de r quartets du segment [a, b) : le quartet a + r passe en a */
+static uint64_t tournerSegment(uint64_t x, int a, int b, int64_t r) {
+	int longueur = b - a;
+	if (longueur <= 1 || r % longueur == 0) return x;
+	int d = (int)(r % longueur);
+	uint64_t bas = ((uint64_t)1 << (4 * longueur)) - 1;
+	uint64_t seg = (x >> (4 * a)) & bas;
+	seg = ((seg >> (4 * d)) | (seg << (4 * (longueur - d)))) & bas;
+	return (x & ~(bas << (4 * a))) | (seg << (4 * a));
+}
+
+/* applique op^nb ; retourne le nombre de commandes exécutées avant l’échec, ou nb */
+static int64_t appliquerSerie(CleEtat* cle, int n, int op, int64_t nb) {
+	int split = (int)(*cle & 0xF);
+	uint64_t perm = *cle >> 4;
+
+	switch (op) {
+	case OP_NI:
+		if (split < 1) return 0;
+		*cle = (tournerSegment(perm, 0, split, nb) << 4) | (CleEtat)split;
+		return nb;
+	case OP_MA:
+		if (split >= n) return 0;
+		*cle = (tournerSegment(perm, split, n, nb) << 4) | (CleEtat)split;
+		return nb;
+	case OP_SO:
+		if (split < 1 || split >= n) return 0;
+		if (nb % 2 != 0) appliquerCommandeCle(cle, n, OP_SO);
+		return nb;
+	default: {
+		/* KI et LO vident leur podium de départ en au plus n commandes */
+		int64_t fait = 0;
+		while (fait < nb && appliquerCommandeCle(cle, n, op)) {
+			++fait;
+		}
+		return fait;
+	}
+	}
+}
+
+/* exécute series[debut..fin) ; retourne l’indice relatif de l’échec ou -1 */
+static int64_t executerPlage(CleEtat* cle, int n, const Serie* series, int64_t debut, int64_t fin) {
+	int64_t position = 0;
+	for (int64_t i = debut; i < fin; ++i) {
+		int64_t fait = appliquerSerie(cle, n, series[i].op, series[i].nb);
+		if (fait < series[i].nb) return position + fait;
+		position += series[i].nb;
+	}
+	return -1;
+}
+
+/* applique m fois la permutation de positions src (nouveau[j] = ancien[src[j]]) */
+static uint64_t permuterPuissance(uint64_t perm, int n, const int* src, int64_t m) {
+	int vu[MAX_ANIMAUX_CLE] = { 0 };
+	uint64_t resultat = 0;
+	for (int depart = 0; depart < n; ++depart) {
+		if (vu[depart]) continue;
+		int cycle[MAX_ANIMAUX_CLE];
+		int longueur = 0;
+		for (int j = depart; !vu[j]; j = src[j]) {
+			vu[j] = 1;
+			cycle[longueur++] = j;
+		}
+		int d = (int)(m % longueur);
+		for (int k = 0; k < longueur; ++k) {
+			int source = cycle[(k + d) % longueur];
+			resultat |= ((perm >> (4 * source)) & 0xF) << (4 * cycle[k]);
+		}
+	}
+	return resultat;
+}
+
+/* exécute un segment ; retourne l’indice relatif de l’échec ou -1 */
+static int64_t executerSegment(CleEtat* cle, int n, const Serie* s, int64_t periode, int64_t nb_series) {
+	int64_t repetitions = nb_series / periode;
+	int64_t reste = nb_series % periode;
+
+	int64_t longueur_bloc = 0;
+	int variation = 0;
+	for (int64_t i = 0; i < periode; ++i) {
+		longueur_bloc += s[i].nb;
+		if (s[i].op == OP_KI) variation -= (int)(s[i].nb > n ? n + 1 : s[i].nb);
+		if (s[i].op == OP_LO) variation += (int)(s[i].nb > n ? n + 1 : s[i].nb);
+	}
+
+	if (repetitions >= 2 && variation == 0) {
+		/* premier passage : détermine la validité du bloc (elle ne dépend que du split) */
+		CleEtat debut = *cle;
+		int64_t echec = executerPlage(cle, n, s, 0, periode);
+		if (echec >= 0) return echec;
+
+		/* effet du bloc sur les positions, lu sur la permutation identité */
+		CleEtat identite = debut & 0xF;
+		for (int j = 0; j < n; ++j) {
+			identite |= (CleEtat)j << (4 + 4 * j);
+		}
+		executerPlage(&identite, n, s, 0, periode);
+		int src[MAX_ANIMAUX_CLE];
+		for (int j = 0; j < n; ++j) {
+			src[j] = (int)((identite >> (4 + 4 * j)) & 0xF);
+		}
+
+		uint64_t perm = permuterPuissance(debut >> 4, n, src, repetitions);
+		*cle = (perm << 4) | (debut & 0xF);
+		echec = executerPlage(cle, n, s, 0, reste);
+		return echec < 0 ? -1 : repetitions * longueur_bloc + echec;
+	}
+
+	/* bloc qui déplace le split (échec en au plus n + 1 passages) ou pas de répétition */
+	int64_t position = 0;
+	for (int64_t r = 0; r < repetitions; ++r, position += longueur_bloc) {
+		int64_t echec = executerPlage(cle, n, s, 0, periode);
+		if (echec >= 0) return position + echec;
+	}
+	int64_t echec = executerPlage(cle, n, s, 0, reste);
+	return echec < 0 ? -1 : position + echec;
+}
+
+int64_t executerLigneCompilee(CleEtat* cle, int n, const LigneCompilee* ligne) {
+	int64_t position = 0;
+	for (int64_t i = 0; i < ligne->segments.nbElements; ++i) {
+		const Segment* segment = &ligne->segments.elements[i];
+		const Serie* s = ligne->series.elements + segment->debut;
+		int64_t echec = executerSegment(cle, n, s, segment->longueur, segment->nb_series);
+		if (echec >= 0) return position + echec;
+
+		int64_t longueur_bloc = 0, longueur_reste = 0;
+		for (int64_t j = 0; j < segment->longueur; ++j) {
+			longueur_bloc += s[j].nb;
+			if (j < segment->nb_series % segment->longueur) longueur_reste += s[j].nb;
+		}
+		position += segment->nb_series / segment->longueur * longueur_bloc + longueur_reste;
+	}
+	return -1;
+}
+
+int executerLigneCle(Commandes* commandes, const char* com, CleEtat* cle, int n) {
+	LigneCompilee ligne;
+	if (!initLigneCompilee(&ligne)) {
+		return 2;
+	}
+	int compilation = compilerLigne(commandes, com, &ligne);
+	int resultat;
+	if (compilation == 2) {
+		resultat = 2;
+	}
+	else if (executerLigneCompilee(cle, n, &ligne) >= 0) {
+		/* une commande impossible avant une commande inconnue l’emporte, comme dans la boucle naïve */
+		resultat = 2;
+	}
+	else {
+		resultat = compilation;
+	}
+	detruireLigneCompilee(&ligne);
+	return resultat;
+}
@@ -0,0 +1,106 @@
+/**
+ * @file executeur.h
+ * @brief Exécution rapide de très longues chaînes de commandes.
+ *
+ * La chaîne est compilée en séries (une commande répétée `nb` fois), puis
+ * chaque série est appliquée en une seule étape sur la situation empaquetée :
+ * NI^k et MA^k sont des rotations d’ordre la hauteur du podium, SO^k ne dépend
+ * que de la parité de k, et une série de KI ou de LO échoue au plus tard quand
+ * le podium de départ est vide.
+ *
+ * Un bloc de séries répété m fois est détecté pendant la compilation, sans
+ * être développé (segment), et il est exécuté une fois : s’il ne change pas le split, son effet est une permutation
+ * des positions, appliquée m fois en O(n) par ses cycles. Le temps d’exécution
+ * ne dépend donc plus de la longueur des répétitions, et le résultat est
+ * exactement celui de la boucle naïve.
+ */
+
+#pragma once
+
+#include "etat.h"
+
+/**
+ * @brief Série : une commande répétée.
+ */
+typedef struct {
+    uint8_t op;  /**< Code de la commande (`CodeCommande`). */
+    int64_t nb;  /**< Nombre de répétitions (au moins 1). */
+} Serie;
+
+VECTEUR_DEF(Series, Serie)
+
+/**
+ * @brief Segment : un bloc de séries répété, suivi d’un préfixe de ce bloc.
+ */
+typedef struct {
+    int64_t debut;      /**< Indice de la première série du bloc dans `LigneCompilee::series`. */
+    int64_t longueur;   /**< Nombre de séries du bloc (la période). */
+    int64_t nb_series;  /**< Nombre de séries du segment une fois développé. */
+} Segment;
+
+VECTEUR_DEF(Segments, Segment)
+
+/**
+ * @brief Chaîne de commandes compilée : une suite de segments.
+ *
+ * La mémoire occupée est proportionnelle au nombre de séries des blocs, et non
+ * à la longueur de la chaîne.
+ */
+typedef struct {
+    Series series;      /**< Séries des blocs, mises bout à bout. */
+    Segments segments;  /**< Segments, dans l’ordre de la chaîne. */
+} LigneCompilee;
+
+/**
+ * @brief Initialise une chaîne compilée vide.
+ *
+ * @param[out] ligne Chaîne à initialiser.
+ * @return `1` si l’initialisation réussit, `0` sinon.
+ */
+int initLigneCompilee(LigneCompilee* ligne);
+
+/**
+ * @brief Libère une chaîne compilée.
+ *
+ * @param[in,out] ligne Chaîne à libérer.
+ */
+void detruireLigneCompilee(LigneCompilee* ligne);
+
+/**
+ * @brief Compile une chaîne de commandes en segments de séries.
+ *
+ * Les commandes identiques consécutives forment une série ; un bloc de séries
+ * qui se répète à partir du début de la chaîne, ou à partir de la fin de la
+ * répétition précédente, forme un segment. La compilation s’arrête à la
+ * première commande non autorisée ; ce qui précède reste dans `ligne`.
+ *
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] com Chaîne de commandes.
+ * @param[out] ligne Chaîne compilée initialisée, vidée puis remplie.
+ * @return `1` si toute la chaîne est compilée, `0` si une commande n’est pas
+ *         autorisée, `2` si la chaîne est de longueur impaire (ou en cas de manque de mémoire).
+ */
+int compilerLigne(Commandes* commandes, const char* com, LigneCompilee* ligne);
+
+/**
+ * @brief Exécute une chaîne compilée sur une situation empaquetée.
+ *
+ * @param[in,out] cle Situation de départ, puis situation atteinte (avant la commande impossible, le cas échéant).
+ * @param[in] n Nombre d’animaux.
+ * @param[in] ligne Chaîne compilée.
+ * @return L’indice (dans la chaîne développée) de la première commande impossible, ou `-1`.
+ * @pre `n <= MAX_ANIMAUX_CLE`.
+ */
+int64_t executerLigneCompilee(CleEtat* cle, int n, const LigneCompilee* ligne);
+
+/**
+ * @brief Équivalent de `executerLigneCommandes` sur une situation empaquetée.
+ *
+ * @param[in] commandes Commandes autorisées par la configuration.
+ * @param[in] com Chaîne de commandes.
+ * @param[in,out] cle Situation de départ, puis situation atteinte.
+ * @param[in] n Nombre d’animaux.
+ * @return Les mêmes codes que `executerLigneCommandes` (`1`, `0` ou `2`).
+ * @pre `n <= MAX_ANIMAUX_CLE`.
+ */
+int executerLigneCle(Commandes* commandes, const char* com, CleEtat* cle, int n);
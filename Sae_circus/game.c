@@ -1,24 +1,51 @@
 
 
 #include "game.h"
+#include "paquet.h"
+#include "trace.h"
 
+enum { TAILLE_BLOC_ARENE = 64 * 1024 };
 
+/* conteneur vide (tous les champs à zéro) alloué dans l’arène, compté au sous-système donné */
+static void* conteneurArene(Arene* arene, size_t taille, SousSysteme sous_systeme) {
+	arene->sous_systeme = sous_systeme;
+	void* v = allouerArene(arene, taille);
+	if (v) memset(v, 0, taille);
+	return v;
+}
 
-void distribuerCarteAleatoire(Vecteur* cartes, int nb_animaux, Game* game) {
-	if (!cartes || cartes->nbElements == 0) return;
-	int idx = choisirRandomCarte(cartes);
-	int* arr = (int*)obtenir(cartes, idx); 
+void distribuerCarteAleatoire(Cartes* cartes, int nb_animaux, Game* game) {
+	if (!cartes || cartes->valeurs.nbElements == 0) return;
+	/* donne tirée d’avance par la prédistribution */
+	int idx = game->carte_suivante >= 0 ? game->carte_suivante : choisirRandomCarte(cartes, &game->alea);
+	int* arr = obtenirCarte(cartes, idx); 
 	distrbuerAuxPodiums(arr, nb_animaux, game->podium_b, game->podium_r);
 
-	int idxs = choisirRandomCarte(game->cartes);
-	int* arrs = obtenir(game->cartes, idxs);
+	int idxs = game->cible_suivante >= 0 ? game->cible_suivante : choisirRandomCarte(game->cartes, &game->alea);
+	int* arrs = obtenirCarte(game->cartes, idxs);
+	game->carte_suivante = -1;
+	game->cible_suivante = -1;
+	game->bilan.carte = idx;
+	game->bilan.cible = idxs;
+	if (game->journal) journaliserDonne(game->journal, idx, idxs);
 
-	distrbuerAuxPodiums(arrs, game->animaux->nbElements, game->target_b, game->target_r);
+	distrbuerAuxPodiums(arrs, (int)game->animaux->nbElements, game->target_b, game->target_r);
+	game->cle_cible = empaqueterCarte(arrs, (int)game->animaux->nbElements);
 
 }
 
 int initGameConfig(Game* game, const char* fichier, int nb_joueurs, char** noms) {
-	srand((unsigned)time(NULL));
+	return initGameConfigGraine(game, fichier, nb_joueurs, noms, graineHorloge());
+}
+
+int initGameConfigGraine(Game* game, const char* fichier, int nb_joueurs, char** noms, uint64_t graine) {
+	if (chargerConfigGame(game, fichier) != 0) {
+		return -1;
+	}
+	return initGamePartagee(game, game, nb_joueurs, noms, graine);
+}
+
+int chargerConfigGame(Game* game, const char* fichier) {
 	game->animaux = NULL;
 	game->commandes = NULL;
 	game->joueurs = NULL;
@@ -27,26 +54,88 @@ int initGameConfig(Game* game, const char* fichier, int nb_joueurs, char** noms)
 	game->target_b = NULL;
 	game->target_r = NULL;
 	game->cartes = NULL;
+	game->sortie = sortieStandard();
+	game->nb_jouees = 0;
+	game->roue = NULL;
+	game->cache = NULL;
+	game->rejet = REJET_AUCUN;
+	memset(&game->distances, 0, sizeof(game->distances));
+	game->predistribution = NULL;
+	game->journal = NULL;
+	game->carte_suivante = -1;
+	game->cible_suivante = -1;
+	game->modele_suivant = NULL;
+	game->mesures = NULL;
+	game->analyses = NULL;
+	memset(&game->bilan, 0, sizeof(game->bilan));
+	game->possede_config = 1;
+	initArene(&game->arene, TAILLE_BLOC_ARENE);
 
-	game->animaux = (Animaux*)malloc(sizeof(Animaux));
-	game->commandes = (Commandes*)malloc(sizeof(Commandes));
-	game->joueurs = (Joueurs*)malloc(sizeof(Joueurs));
-	game->podium_b = (Podium*)malloc(sizeof(Podium));
-	game->podium_r = (Podium*)malloc(sizeof(Podium));
-	game->target_b = (Podium*)malloc(sizeof(Podium));
-	game->target_r = (Podium*)malloc(sizeof(Podium));
-	int resultat = loadConfig(fichier, game->animaux, game->commandes);
+	game->animaux = conteneurArene(&game->arene, sizeof(Animaux), MEMOIRE_CONFIG);
+	game->commandes = conteneurArene(&game->arene, sizeof(Commandes), MEMOIRE_CONFIG);
+	game->cartes = conteneurArene(&game->arene, sizeof(Cartes), MEMOIRE_PAQUET);
+	game->arene.sous_systeme = MEMOIRE_CONFIG;
+	int resultat = loadConfig(fichier, game->animaux, game->commandes, &game->arene);
 	
 	if (resultat != 0) {
 		if (resultat == 1) {
-			lancementErrorCommande();
-			return -1;
+			lancementErrorCommande(game->sortie);
 		}
+		detruireGame(game);
 		return -1;
 	}
 
-	if (loadJoueurs(game->joueurs, nb_joueurs, noms) != 0) {
-		printf("Erreur chargement joueurs");
+	/* paquet précompilé à côté de la configuration : « crazy.cfg.paquet » */
+	size_t longueur = strlen(fichier) + sizeof(".paquet");
+	char* chemin = (char*)malloc(longueur);
+	if (chemin) snprintf(chemin, longueur, "%s.paquet", fichier);
+	chargerPaquet(game->cartes, game->animaux, chemin);
+	free(chemin);
+
+	return 0;
+}
+
+static void rappelExpiration(void* contexte) {
+	expirerTour((Game*)contexte);
+}
+
+int initGamePartagee(Game* game, const Game* modele, int nb_joueurs, char** noms, uint64_t graine) {
+	game->animaux = modele->animaux;
+	game->commandes = modele->commandes;
+	game->cartes = modele->cartes;
+	game->sortie = modele->sortie;
+	game->nb_jouees = 0;
+	game->delai_ms = 0;
+	game->roue = NULL;
+	game->cache = NULL;
+	game->rejet = REJET_AUCUN;
+	memset(&game->distances, 0, sizeof(game->distances));
+	game->predistribution = NULL;
+	game->journal = NULL;
+	game->carte_suivante = -1;
+	game->cible_suivante = -1;
+	game->modele_suivant = NULL;
+	game->mesures = NULL;
+	game->analyses = NULL;
+	memset(&game->bilan, 0, sizeof(game->bilan));
+	game->cle_cible = CLE_INVALIDE;
+	game->numero_tour = 0;
+	initEcheance(&game->echeance, rappelExpiration, game);
+	initAleatoire(&game->alea, graine);
+	if (game != modele) {
+		game->possede_config = 0;
+		initArene(&game->arene, TAILLE_BLOC_ARENE);
+	}
+
+	game->podium_b = conteneurArene(&game->arene, sizeof(Podium), MEMOIRE_PODIUMS);
+	game->podium_r = conteneurArene(&game->arene, sizeof(Podium), MEMOIRE_PODIUMS);
+	game->target_b = conteneurArene(&game->arene, sizeof(Podium), MEMOIRE_PODIUMS);
+	game->target_r = conteneurArene(&game->arene, sizeof(Podium), MEMOIRE_PODIUMS);
+	/* les noms des joueurs suivent leur conteneur dans l’arène */
+	game->joueurs = conteneurArene(&game->arene, sizeof(Joueurs), MEMOIRE_JOUEURS);
+
+	if (loadJoueurs(game->joueurs, nb_joueurs, noms, &game->arene) != 0) {
+		imprimer(game->sortie, "Erreur chargement joueurs");
 		return -1;
 	}
 
@@ -54,107 +143,543 @@ int initGameConfig(Game* game, const char* fichier, int nb_joueurs, char** noms)
 	int capacite = game->animaux->nbElements > 0 ? game->animaux->nbElements : 1;
 	if (!initPodium(game->podium_b, capacite) || !initPodium(game->podium_r, capacite)
 		|| !initPodium(game->target_b, capacite) || !initPodium(game->target_r, capacite)) {
-		printf("Erreur initialisation podiums\n");
+		imprimer(game->sortie, "Erreur initialisation podiums\n");
 		return -1;
 	}
 
-
-	game->cartes = (Vecteur*)malloc(sizeof(Vecteur));
-	initVecteur(game->cartes, 1);
-	genererToutesLesCartes(game->animaux, game->cartes);
-	
-	distribuerCarteAleatoire(game->cartes, game->animaux->nbElements, game);
-	
+	nouveauTour(game);
 	
+	return 0;
 }
 
-int gameLoop(Game* game)
-{
-	char* ligne = NULL;
-	char* commande = NULL;
-	char* nom_j = NULL;
+/* les distances servent au rejet anticipé et à la distance de départ des bilans */
+static int avecDistances(const Game* game) {
+	return (game->rejet != REJET_AUCUN || game->analyses) && game->cle_cible != CLE_INVALIDE;
+}
 
-	int nb_jouees = 0;
-	
-	CommandesPresentes(game->commandes);
-	while (1) {
-		afficherPodiums(game->animaux, game->podium_b, game->podium_r, game->target_b, game->target_r);
-		ligne = readFullLine(stdin);
-		if (!ligne) {
-			break;
+/* distances à la nouvelle cible, si le rejet anticipé ou les analyses les demandent */
+static void preparerDistances(Game* game) {
+	if (!avecDistances(game) || !game->distances.cles) return;
+	calculerDistances(&game->distances, game->cle_cible, (int)game->animaux->nbElements, game->commandes, DISTANCE_INFINIE);
+	game->distance_depart = distanceMinimale(&game->distances, empaqueterPodiums(game->podium_b, game->podium_r));
+}
+
+/* confie la donne déjà tirée au fil de prédistribution */
+static void analyserDonneSuivante(Game* game) {
+	int n = (int)game->animaux->nbElements;
+	demanderDonne(game->predistribution, empaqueterCarte(obtenirCarte(game->cartes, game->carte_suivante), n),
+		empaqueterCarte(obtenirCarte(game->cartes, game->cible_suivante), n), avecDistances(game));
+}
+
+/* tire la donne du tour suivant, dans l’ordre de distribuerCarteAleatoire */
+static void tirerDonneSuivante(Game* game) {
+	if (nbCartes(game->cartes) == 0) return;
+	game->carte_suivante = choisirRandomCarte(game->cartes, &game->alea);
+	game->cible_suivante = choisirRandomCarte(game->cartes, &game->alea);
+	analyserDonneSuivante(game);
+}
+
+/* reprend l’analyse de la donne distribuée : la table calculée par le fil est échangée avec celle de la partie */
+static void adopterDonne(Game* game) {
+	Predistribution* p = game->predistribution;
+	/* la donne a pu être remplacée depuis la demande (journal, instantané) : départ et cible doivent concorder */
+	if (!avecDistances(game) || !p->avec_distances || p->cible != game->cle_cible
+		|| p->depart != empaqueterPodiums(game->podium_b, game->podium_r) || !game->distances.cles || p->distances.max_etats != game->distances.max_etats) {
+		preparerDistances(game);
+		return;
+	}
+	TableDistances table = game->distances;
+	game->distances = p->distances;
+	p->distances = table;
+	game->distance_depart = p->distance_depart;
+}
+
+/* configuration rechargée : les podiums seront remplis par la donne, tirée du nouveau paquet */
+static void adopterModele(Game* game) {
+	const Game* modele = game->modele_suivant;
+	game->modele_suivant = NULL;
+	detacherPredistribution(game);
+	game->animaux = modele->animaux;
+	game->commandes = modele->commandes;
+	game->cartes = modele->cartes;
+	game->cache = NULL;
+	game->carte_suivante = -1;
+	game->cible_suivante = -1;
+}
+
+static void copierPodiumBilan(uint8_t* animaux, uint8_t* nb, const Podium* p) {
+	*nb = (uint8_t)p->nbElements;
+	for (int64_t i = 0; i < p->nbElements; ++i) {
+		animaux[i] = (uint8_t)p->elements[i];
+	}
+}
+
+/* bilan du tour qui vient d’être distribué ; les cartes sont notées par distribuerCarteAleatoire */
+static void ouvrirBilan(Game* game) {
+	BilanTour* b = &game->bilan;
+	b->tour = game->numero_tour;
+	/* une clé valide garantit au plus MAX_ANIMAUX_CLE animaux par podium */
+	b->nb_animaux = game->cle_cible != CLE_INVALIDE ? (int)game->animaux->nbElements : 0;
+	if (b->nb_animaux > 0) {
+		copierPodiumBilan(b->depart_b, &b->nb_depart_b, game->podium_b);
+		copierPodiumBilan(b->depart_r, &b->nb_depart_r, game->podium_r);
+		copierPodiumBilan(b->arrivee_b, &b->nb_arrivee_b, game->target_b);
+		copierPodiumBilan(b->arrivee_r, &b->nb_arrivee_r, game->target_r);
+	}
+	b->distance = game->distances.cles && b->nb_animaux > 0 && game->distance_depart != DISTANCE_INFINIE
+		? game->distance_depart : -1;
+	b->debut_ms = game->debut_tour;
+	b->nb_echecs = 0;
+}
+
+static void noterEchec(Game* game, uint64_t latence) {
+	BilanTour* b = &game->bilan;
+	if (b->nb_echecs < MAX_ECHECS_ANALYSE) {
+		b->echecs_ms[b->nb_echecs] = latence > UINT32_MAX ? UINT32_MAX : (uint32_t)latence;
+	}
+	++b->nb_echecs;
+}
+
+/* publie le bilan du tour qui se termine, avant la distribution suivante */
+static void cloreBilan(Game* game, FinTour fin, const char* gagnant, int longueur) {
+	BilanTour* b = &game->bilan;
+	if (!game->analyses || b->tour != game->numero_tour) return;
+	b->fin = fin;
+	snprintf(b->gagnant, sizeof(b->gagnant), "%s", gagnant ? gagnant : "");
+	b->longueur = longueur;
+	b->duree_ms = maintenantMs() - b->debut_ms;
+	publierBilan(game->analyses, b);
+	b->tour = 0;
+}
+
+void nouveauTour(Game* game) {
+	debutTrace("donne");
+	uint64_t debut = game->mesures ? maintenantNs() : 0;
+	if (game->modele_suivant) {
+		adopterModele(game);
+	}
+	int analysee = game->predistribution && recupererDonne(game->predistribution);
+	distribuerCarteAleatoire(game->cartes, (int)game->animaux->nbElements, game);
+	if (analysee) {
+		adopterDonne(game);
+	}
+	else {
+		preparerDistances(game);
+	}
+	++game->numero_tour;
+	game->debut_tour = maintenantMs();
+	if (game->roue && game->delai_ms > 0) {
+		armerEcheance(game->roue, &game->echeance, game->debut_tour + (uint64_t)game->delai_ms);
+	}
+	if (game->analyses) {
+		ouvrirBilan(game);
+	}
+	if (game->predistribution) {
+		tirerDonneSuivante(game);
+	}
+	if (game->mesures) {
+		enregistrerHistogramme(&game->mesures->donne, maintenantNs() - debut);
+	}
+	finTrace("donne");
+}
+
+/* relecture d’un journal : points au fil de l’eau, dernière donne retenue */
+typedef struct {
+	Game* game;
+	int carte;
+	int cible;
+} Reprise;
+
+static void reprendreEvenement(void* contexte, int type, const uint8_t* donnees, size_t longueur) {
+	Reprise* r = (Reprise*)contexte;
+	if (type == EVENEMENT_POINT) {
+		char local[256];
+		char* nom = longueur < sizeof(local) ? local : (char*)malloc(longueur + 1);
+		if (!nom) return;
+		memcpy(nom, donnees, longueur);
+		nom[longueur] = '\0';
+		Joueur* j = obtenirJoueurParNom(r->game->joueurs, nom);
+		if (j) ajouterPointJoueur(r->game->joueurs, j);
+		if (nom != local) free(nom);
+	}
+	else if (type == EVENEMENT_DONNE && longueur == 8) {
+		uint32_t carte = (uint32_t)donnees[0] | (uint32_t)donnees[1] << 8 | (uint32_t)donnees[2] << 16 | (uint32_t)donnees[3] << 24;
+		uint32_t cible = (uint32_t)donnees[4] | (uint32_t)donnees[5] << 8 | (uint32_t)donnees[6] << 16 | (uint32_t)donnees[7] << 24;
+		if ((int64_t)carte < nbCartes(r->game->cartes) && (int64_t)cible < nbCartes(r->game->cartes)) {
+			r->carte = (int)carte;
+			r->cible = (int)cible;
 		}
-		
+	}
+}
 
-		
-		nom_j = strtok(ligne, " \t");
-		commande = strtok(NULL, " \t");
+int64_t reprendreJournal(Game* game, const char* chemin, const PositionJournal* depuis) {
+	Reprise r = { game, -1, -1 };
+	int64_t nb = lireJournalDepuis(chemin, depuis, reprendreEvenement, &r);
+	if (r.carte >= 0) {
+		game->carte_suivante = r.carte;
+		game->cible_suivante = r.cible;
+		nouveauTour(game);
+	}
+	return nb;
+}
+
+int attacherPredistribution(Game* game, Predistribution* p) {
+	if (game->cle_cible == CLE_INVALIDE) return 0;
+	game->predistribution = p;
+	if (game->carte_suivante < 0) {
+		tirerDonneSuivante(game);
+	}
+	else {
+		analyserDonneSuivante(game);
+	}
+	return 1;
+}
 
-		Podium* podium_b = clonePodium(game->podium_b);
-		Podium* podium_r = clonePodium(game->podium_r);
+void detacherPredistribution(Game* game) {
+	if (!game->predistribution) return;
+	recupererDonne(game->predistribution);
+	game->predistribution = NULL;
+}
+
+void expirerTour(Game* game) {
+	cloreBilan(game, FIN_DELAI, NULL, -1);
+	tempsEcoule(game->sortie);
+	game->nb_jouees = 0;
+	remetreTours(game->joueurs);
+	nouveauTour(game);
+}
+
+void attacherAnalyses(Game* game, Analyses* analyses, int partie) {
+	game->analyses = analyses;
+	game->bilan.partie = partie;
+	/* la table sert aussi sans rejet ; sans mémoire, les bilans n’ont pas de distance */
+	if (game->cle_cible != CLE_INVALIDE
+		&& (game->distances.cles || initTableDistances(&game->distances, MAX_ETATS_DISTANCE))) {
+		preparerDistances(game);
+	}
+	ouvrirBilan(game);
+}
+
+void changerModele(Game* game, const Game* modele) {
+	game->modele_suivant = modele;
+}
+
+void attacherMinuterie(Game* game, RoueMinuterie* roue, int delai_ms) {
+	game->roue = roue;
+	game->delai_ms = delai_ms;
+	armerEcheance(roue, &game->echeance, game->debut_tour + (uint64_t)delai_ms);
+}
+
+int situationAtteinte(const Game* game, const Podium* podium_b, const Podium* podium_r) {
+	if (game->cle_cible != CLE_INVALIDE) {
+		return empaqueterPodiums(podium_b, podium_r) == game->cle_cible;
+	}
+	return comparer2Podiums(podium_b, game->target_b) == 1
+		&& comparer2Podiums(podium_r, game->target_r) == 1;
+}
+
+int choisirRejet(Game* game, ModeRejet mode) {
+	if (mode != REJET_AUCUN && !game->distances.cles
+		&& !initTableDistances(&game->distances, MAX_ETATS_DISTANCE)) {
+		game->rejet = REJET_AUCUN;
+		return 0;
+	}
+	game->rejet = mode;
+	preparerDistances(game);
+	return 1;
+}
 
-		Joueur* j = obtenirJoueurParNom(game->joueurs, nom_j);
-		if (!joueurExiste(game->joueurs, nom_j)) {
-			joueurJouePas();
+/* exécute la chaîne sur une copie de la situation courante (codes de executerLigneCommandes) */
+static int executerCoup(Game* game, const char* commande, int* atteint) {
+	if (game->rejet != REJET_AUCUN && game->cle_cible != CLE_INVALIDE) {
+		/* moins de commandes que la distance de départ : la cible est hors d’atteinte,
+		   il ne reste qu’à vérifier la chaîne pour donner le même verdict, sans passer par le cache */
+		size_t minimum = game->distance_depart == DISTANCE_INFINIE ? SIZE_MAX : 2 * (size_t)game->distance_depart;
+		if (game->rejet == REJET_PREFIXE || strnlen(commande, minimum) < minimum) {
+			CleEtat cle = empaqueterPodiums(game->podium_b, game->podium_r);
+			int reponse = executerLigneElaguee(&game->distances, game->commandes, commande, &cle,
+				(int)game->animaux->nbElements);
+			*atteint = reponse == 1 && cle == game->cle_cible;
+			return reponse;
 		}
+	}
+
+	if (game->cle_cible != CLE_INVALIDE) {
+		CleEtat cle = empaqueterPodiums(game->podium_b, game->podium_r);
+		int reponse = executerLigneCache(game->cache, game->commandes, commande, &cle, (int)game->animaux->nbElements);
+		*atteint = reponse == 1 && cle == game->cle_cible;
+		return reponse;
+	}
+
+	Podium* podium_b = clonePodium(game->podium_b);
+	Podium* podium_r = clonePodium(game->podium_r);
+	int reponse = executerLigneCommandes(game->commandes, commande, podium_b, podium_r);
+	*atteint = reponse == 1 && situationAtteinte(game, podium_b, podium_r);
+	freeClonePodium(podium_b);
+	freeClonePodium(podium_r);
+	return reponse;
+}
+
+static void jouerLigne(Game* game, char* ligne)
+{
+	const Sortie* s = game->sortie;
+	char* curseur = ligne;
+	char* nom_j = prochainMot(&curseur);
+	char* commande = prochainMot(&curseur);
+
+	Joueur* j = nom_j ? obtenirJoueurParNom(game->joueurs, nom_j) : NULL;
+	if (j == NULL) {
+		joueurJouePas(s);
+		return;
+	}
+	if (peutJouer(game->joueurs, nom_j) != 1) {
+		joueurPeutPasJouer(s, j);
+		return;
+	}
+	if (commande == NULL) {
+		ordreErreur(s);
+		return;
+	}
+	uint64_t latence = maintenantMs() - game->debut_tour;
+	enregistrerLatenceJoueur(j, latence);
+
+	int atteint = 0;
+	int reponse = executerCoup(game, commande, &atteint);
+	if (game->analyses && (reponse != 1 || !atteint)) {
+		noterEchec(game, latence);
+	}
+	
+	if (reponse == 0) {
+		ordreExistePas(s);
 		
+	}
+	else if(reponse == 2 ) {
+		ordreErreur(s);
+	}
+	else {
 		
-		else if (peutJouer(game->joueurs, nom_j) == 1) {
-			
-			int reponse = executerLigneCommandes(game->commandes,commande, podium_b, podium_r);
+		j->tour = 0;
+		++game->nb_jouees;
+		
+		if (atteint) {
 			
-			if (reponse == 0) {
-				ordreExistePas();
-				
-			}
-			else if(reponse == 2 ) {
-				ordreErreur();
-			}
-			else {
-				
-				j->tour = 0;
-				++nb_jouees;
-				
-				if (comparer2Podiums(podium_b, game->target_b) == 1 && comparer2Podiums(podium_r, game->target_r) == 1) {
-					
-					ajouterPointJoueur(game->joueurs, nom_j);
-					gagnerPoint(nom_j, 0);
-					nb_jouees = 0;
-
-					distribuerCarteAleatoire(game->cartes, game->animaux->nbElements, game);
-
-				}
-
-				else {
-					
-					ordreIncorect(j);
-				}
-
-				if (nb_jouees == game->joueurs->nbElements - 1) {
-					nb_jouees = 0;
-					distribuerCarteAleatoire(game->cartes, game->animaux->nbElements, game);
-					Joueur* j = lastPerson(game->joueurs);
-					ajouterPointJoueur(game->joueurs, j->nom);
-					gagnerPoint(j->nom, 1);
-					remetreTours(game->joueurs);
-					
-				}
-			}
+			j = ajouterPointJoueur(game->joueurs, j);
+			if (game->journal) journaliserPoint(game->journal, j->nom.texte, j->nom.longueur);
+			gagnerPoint(s, nom_j, 0);
+			afficherRang(s, j, game->joueurs);
+			game->nb_jouees = 0;
+
+			cloreBilan(game, FIN_GAGNE, j->nom.texte, (int)(strlen(commande) / 2));
+			nouveauTour(game);
 
+		}
+
+		else {
 			
+			ordreIncorect(s, j);
+		}
 
+		if (game->nb_jouees == game->joueurs->nbElements - 1) {
+			game->nb_jouees = 0;
+			/* le dernier joueur peut être encore bloqué par le tour précédent : personne ne marque */
+			Joueur* dernier = lastPerson(game->joueurs);
+			cloreBilan(game, FIN_DERNIER, dernier ? dernier->nom.texte : NULL, -1);
+			nouveauTour(game);
+			if (dernier) {
+				const char* nom_dernier = dernier->nom.texte;
+				dernier = ajouterPointJoueur(game->joueurs, dernier);
+				if (game->journal) journaliserPoint(game->journal, dernier->nom.texte, dernier->nom.longueur);
+				gagnerPoint(s, nom_dernier, 1);
+				afficherRang(s, dernier, game->joueurs);
+			}
+			remetreTours(game->joueurs);
 			
-		
+		}
+	}
+}
+
+void traiterLigne(Game* game, char* ligne) {
+	if (!game->mesures) {
+		jouerLigne(game, ligne);
+		return;
+	}
+	uint64_t debut = maintenantNs();
+	jouerLigne(game, ligne);
+	enregistrerHistogramme(&game->mesures->ligne, maintenantNs() - debut);
+}
+
+int activerMesures(Game* game) {
+	if (game->mesures) return 1;
+	int nb = (int)game->joueurs->nbElements;
+	MesuresPartie* m = (MesuresPartie*)malloc(sizeof(MesuresPartie) + sizeof(Histogramme) * (size_t)nb);
+	if (!m) return 0;
+	initHistogramme(&m->ligne);
+	initHistogramme(&m->donne);
+	initHistogramme(&m->rendu);
+	m->nb_joueurs = nb;
+	for (int i = 0; i < nb; ++i) {
+		initHistogramme(&m->reflexion[i]);
+		obtenirJoueur(game->joueurs, i)->reflexion = &m->reflexion[i];
+	}
+	game->mesures = m;
+	return 1;
+}
+
+void afficherMesures(const Game* game) {
+	const Sortie* s = game->sortie;
+	afficherCentiles(s, "ligne", &game->mesures->ligne);
+	afficherCentiles(s, "donne", &game->mesures->donne);
+	afficherCentiles(s, "affichage", &game->mesures->rendu);
+	for (int i = 0; i < game->joueurs->nbElements; ++i) {
+		const Joueur* j = obtenirJoueur(game->joueurs, i);
+		if (j->reflexion) afficherCentiles(s, j->nom.texte, j->reflexion);
+	}
+	imprimer(s, "\n");
+}
+
+/* affichage de la situation, mesuré avec les latences */
+static void afficherTour(Game* game) {
+	debutTrace("affichage");
+	uint64_t debut = game->mesures ? maintenantNs() : 0;
+	afficherPodiums(game->sortie, game->animaux, game->podium_b, game->podium_r, game->target_b, game->target_r);
+	if (game->mesures) {
+		enregistrerHistogramme(&game->mesures->rendu, maintenantNs() - debut);
+	}
+	finTrace("affichage");
+}
+
+int gameLoop(Game* game)
+{
+	char* ligne = NULL;
+	RoueMinuterie roue;
+	LecteurLignes lecteur;
+	int avec_delai = game->delai_ms > 0;
+	CacheCompositions cache;
+	if (!game->cache && game->cle_cible != CLE_INVALIDE && initCache(&cache, TAILLE_CACHE_DEFAUT)) {
+		game->cache = &cache;
+	}
+	/* l’analyse de chaque donne (rejet anticipé ou analyses) se fait pendant le tour précédent */
+	Predistribution predistribution;
+	int avec_predistribution = !game->predistribution && avecDistances(game)
+		&& demarrerPredistribution(&predistribution, (int)game->animaux->nbElements, game->commandes)
+		&& attacherPredistribution(game, &predistribution);
+
+	if (avec_delai) {
+		initRoue(&roue, 10, maintenantMs());
+		attacherMinuterie(game, &roue, game->delai_ms);
+		initLecteurLignes(&lecteur, stdin);
+	}
+	
+	nommerFilTrace("boucle de jeu");
+	CommandesPresentes(game->sortie, game->commandes);
+	while (1) {
+		afficherTour(game);
+		debutTrace("attente ligne");
+		if (avec_delai) {
+			int expire = 0;
+			ligne = lireLigneAvant(&lecteur, delaiRoue(&roue, maintenantMs()), &expire);
+			finTrace("attente ligne");
+			if (ligne && *ligne == '\0') {
+				free(ligne);
+				ligne = NULL;
+			}
+			if (!ligne && !expire) {
+				break;
+			}
+			/* une ligne arrivée après l'échéance est jouée sur le tour suivant */
+			avancerRoue(&roue, maintenantMs());
+			if (expire) {
+				continue;
+			}
 		}
 		else {
-			joueurPeutPasJouer(j);
+			ligne = readFullLine(stdin);
+			finTrace("attente ligne");
+		}
+		if (!ligne) {
+			break;
+		}
+		/* centiles à la demande */
+		if (game->mesures && strcmp(ligne, "!latences") == 0) {
+			afficherMesures(game);
+			free(ligne);
+			continue;
+		}
+		if (strcmp(ligne, "!memoire") == 0) {
+			afficherMemoire(game->sortie);
+			free(ligne);
+			continue;
+		}
+		if (game->cache && strcmp(ligne, "!cache") == 0) {
+			afficherStatistiquesCache(game->sortie, &game->cache->stats);
+			free(ligne);
+			continue;
 		}
 		
-		
-		
+		debutTrace("ligne");
+		traiterLigne(game, ligne);
+		finTrace("ligne");
+		free(ligne);
+	}
+
+	afficherResultats(game->sortie, game->joueurs);
+	if (avec_delai) {
+		afficherLatences(game->sortie, game->joueurs);
+		annulerEcheance(&roue, &game->echeance);
+		game->roue = NULL;
+		detruireLecteurLignes(&lecteur);
+	}
+	if (game->mesures) {
+		afficherMesures(game);
+		if (game->cache) {
+			afficherStatistiquesCache(game->sortie, &game->cache->stats);
+		}
+	}
+	if (game->cache == &cache) {
+		game->cache = NULL;
+		detruireCache(&cache);
+	}
+	if (avec_predistribution) {
+		detacherPredistribution(game);
+		arreterPredistribution(&predistribution);
 	}
 
-	afficherResultats(game->joueurs);
-	
 
 	return 0;
-}
\ No newline at end of file
+}
+
+static void detruirePodium(Podium* p) {
+	if (p) freePodium(p);
+}
+
+
+void detruireGame(Game* game) {
+	detacherPredistribution(game);
+	if (game->roue) {
+		annulerEcheance(game->roue, &game->echeance);
+		game->roue = NULL;
+	}
+	detruirePodium(game->podium_b);
+	detruirePodium(game->podium_r);
+	detruirePodium(game->target_b);
+	detruirePodium(game->target_r);
+	if (game->joueurs) detruireVecteurJoueur(game->joueurs);
+	if (game->possede_config) {
+		if (game->animaux) detruireVecteurAnimal(game->animaux);
+		if (game->commandes) detruireVecteurCommande(game->commandes);
+		if (game->cartes) detruireCartes(game->cartes);
+	}
+	detruireTableDistances(&game->distances);
+	detruireArene(&game->arene);
+	free(game->mesures);
+	game->mesures = NULL;
+
+	game->animaux = NULL;
+	game->commandes = NULL;
+	game->joueurs = NULL;
+	game->podium_b = NULL;
+	game->podium_r = NULL;
+	game->target_b = NULL;
+	game->target_r = NULL;
+	game->cartes = NULL;
+}
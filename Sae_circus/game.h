@@ -11,11 +11,38 @@
 #pragma warning(disable:4996)
 
 #include "affichage.h"
+#include "minuterie.h"
+#include "cache.h"
+#include "distance.h"
+#include "predistribution.h"
+#include "journal.h"
+#include "histogramme.h"
+#include "analyses.h"
 
 /**
- * @brief Structure représentant l’état d’une partie.
+ * @brief Rejet anticipé des chaînes qui ne peuvent pas atteindre la cible.
+ */
+typedef enum {
+    REJET_AUCUN,    /**< Toutes les chaînes sont exécutées. */
+    REJET_COURT,    /**< Une chaîne plus courte que la distance de départ est seulement vérifiée, sans passer par le cache. */
+    REJET_PREFIXE   /**< Toute chaîne cesse de consulter les distances dès que son reste ne suffit plus. */
+} ModeRejet;
+
+/**
+ * @brief Histogrammes de latence d’une partie (voir `activerMesures`).
  */
 typedef struct {
+    Histogramme ligne;        /**< Traitement d’une ligne, de sa lecture au verdict. */
+    Histogramme donne;        /**< Distribution d’une nouvelle donne. */
+    Histogramme rendu;        /**< Affichage des podiums par la boucle de jeu. */
+    int nb_joueurs;
+    Histogramme reflexion[];  /**< Temps de réflexion de chaque joueur, désignés par `Joueur::reflexion`. */
+} MesuresPartie;
+
+/**
+ * @brief Structure représentant l’état d’une partie.
+ */
+typedef struct Game {
     Animaux* animaux;
     Commandes* commandes;
     Joueurs* joueurs;
@@ -26,12 +53,42 @@ typedef struct {
     Podium* target_b;
     Podium* target_r;
 
-    Vecteur* cartes;
+    Cartes* cartes;
+    CleEtat cle_cible;     /**< Clé de la situation cible, `CLE_INVALIDE` au-delà de `MAX_ANIMAUX_CLE` animaux. */
+
+    Aleatoire alea; /**< Générateur propre à la partie. */
+
+    const Sortie* sortie; /**< Destination des messages de la partie. */
+    int nb_jouees;        /**< Nombre de joueurs ayant déjà joué durant le tour. */
+
+    int delai_ms;          /**< Durée maximale d’un tour (ms), `0` pour un tour sans limite. */
+    uint64_t debut_tour;   /**< Heure de la dernière distribution (ms, horloge monotone). */
+    uint64_t numero_tour;  /**< Nombre de distributions depuis le début de la partie. */
+    RoueMinuterie* roue;   /**< Roue où est armée l’échéance du tour, ou `NULL`. */
+    Echeance echeance;     /**< Échéance du tour courant. */
+    CacheCompositions* cache; /**< Cache des résultats de chaînes (appartenant au thread qui fait jouer la partie), ou `NULL`. */
+
+    ModeRejet rejet;           /**< Rejet anticipé des chaînes perdantes. */
+    TableDistances distances;  /**< Distances à la cible du tour (allouée seulement avec un rejet anticipé). */
+    int distance_depart;       /**< Minorant de la distance de la situation courante à la cible du tour. */
+    Predistribution* predistribution; /**< Fil analysant la donne suivante (appartenant au thread qui fait jouer la partie), ou `NULL`. */
+    Journal* journal;          /**< Journal des points et des donnes, ou `NULL`. */
+    int carte_suivante;        /**< Carte de départ déjà tirée pour le tour suivant, `-1` sinon. */
+    int cible_suivante;        /**< Carte cible déjà tirée pour le tour suivant, `-1` sinon. */
+    const struct Game* modele_suivant; /**< Configuration à adopter à la prochaine distribution, ou `NULL`. */
+    MesuresPartie* mesures;    /**< Histogrammes de latence, ou `NULL` sans mesures. */
+    Analyses* analyses;        /**< Flux des bilans de tours, ou `NULL`. */
+    BilanTour bilan;           /**< Bilan du tour en cours (`bilan.tour` vaut `0` s’il n’est pas suivi). */
+
+    Arene arene;           /**< Arène des objets vivant aussi longtemps que la partie. */
+    int possede_config;    /**< `1` si la partie possède ses animaux, commandes et cartes, `0` si elle les partage. */
 } Game;
 
 /**
  * @brief Initialise une partie à partir d’un fichier de configuration et d’une liste de joueurs.
  *
+ * Le générateur de la partie est initialisé à partir de l’horloge.
+ *
  * @param[in,out] game État du jeu à initialiser.
  * @param[in] fichier Fichier de configuration.
  * @param[in] nb_joueurs Nombre de joueurs.
@@ -41,9 +98,222 @@ typedef struct {
  */
 int initGameConfig(Game* game, const char* fichier, int nb_joueurs, char** noms);
 
+/**
+ * @brief Initialise une partie avec une graine explicite, pour rejouer une partie à l’identique.
+ *
+ * @param[in,out] game État du jeu à initialiser.
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] nb_joueurs Nombre de joueurs.
+ * @param[in] noms Tableau contenant les noms des joueurs.
+ * @param[in] graine Graine du générateur de la partie.
+ * @return `0` si l’initialisation réussit, `-1` sinon.
+ * @pre `game`, `fichier` et `noms` ne sont pas `NULL`.
+ */
+int initGameConfigGraine(Game* game, const char* fichier, int nb_joueurs, char** noms, uint64_t graine);
+
+/**
+ * @brief Charge uniquement la configuration partageable (animaux, commandes, cartes).
+ *
+ * Une partie ainsi chargée sert de modèle à `initGamePartagee` ; elle n’a ni joueurs ni podiums.
+ * Le paquet est projeté depuis le fichier `<fichier>.paquet`, créé au premier chargement (voir `paquet.h`).
+ *
+ * @param[out] game Partie modèle.
+ * @param[in] fichier Fichier de configuration.
+ * @return `0` si le chargement réussit, `-1` sinon.
+ * @pre `game` et `fichier` ne sont pas `NULL`.
+ */
+int chargerConfigGame(Game* game, const char* fichier);
+
+/**
+ * @brief Initialise une partie qui partage la configuration d’une partie modèle.
+ *
+ * Les animaux, les commandes et les cartes du modèle sont partagés (en lecture seule) ;
+ * les joueurs, les podiums et le générateur sont propres à la nouvelle partie.
+ * `game` peut être le modèle lui-même.
+ *
+ * @param[out] game Partie à initialiser.
+ * @param[in] modele Partie dont la configuration est chargée.
+ * @param[in] nb_joueurs Nombre de joueurs.
+ * @param[in] noms Tableau contenant les noms des joueurs.
+ * @param[in] graine Graine du générateur de la partie.
+ * @return `0` si l’initialisation réussit, `-1` sinon.
+ */
+int initGamePartagee(Game* game, const Game* modele, int nb_joueurs, char** noms, uint64_t graine);
+
+/**
+ * @brief Libère tout ce qu’une partie possède.
+ *
+ * Les podiums, les joueurs et l’arène de la partie sont libérés ; la configuration
+ * n’est libérée que si la partie la possède. Une partie modèle doit être détruite
+ * après toutes les parties qui partagent sa configuration. Il est possible de détruire
+ * une partie dont l’initialisation a échoué.
+ *
+ * @param[in,out] game Partie à détruire.
+ */
+void detruireGame(Game* game);
+
+/**
+ * @brief Distribue de nouvelles cartes et démarre un nouveau tour.
+ *
+ * L’heure de début du tour est mise à jour et, si la partie est attachée à une roue,
+ * l’échéance du tour est réarmée.
+ *
+ * @param[in,out] game État du jeu.
+ */
+void nouveauTour(Game* game);
+
+/**
+ * @brief Termine un tour dont le délai est écoulé : personne ne marque, les cartes sont redistribuées.
+ *
+ * @param[in,out] game État du jeu.
+ */
+void expirerTour(Game* game);
+
+/**
+ * @brief Attache la partie à une roue de minuterie pour limiter la durée des tours.
+ *
+ * L’échéance du tour courant est armée immédiatement. Par défaut, son rappel appelle
+ * `expirerTour` ; le propriétaire de la roue peut le remplacer via `game->echeance`.
+ *
+ * @param[in,out] game État du jeu.
+ * @param[in,out] roue Roue de minuterie (appartenant au thread qui fait jouer la partie).
+ * @param[in] delai_ms Durée maximale d’un tour (ms).
+ * @pre `delai_ms > 0`.
+ */
+void attacherMinuterie(Game* game, RoueMinuterie* roue, int delai_ms);
+
+/**
+ * @brief Publie le bilan de chaque tour de la partie, à partir du tour en cours.
+ *
+ * Les distances à la cible sont alors calculées à chaque donne, comme avec le
+ * rejet anticipé mais sans changer le traitement des chaînes, pour publier la
+ * distance de départ (hors du thread de la partie quand une prédistribution
+ * est attachée).
+ *
+ * @param[in,out] game État du jeu.
+ * @param[in,out] analyses Flux d’analyses ouvert (partagé entre parties si besoin).
+ * @param[in] partie Identifiant de la partie dans les bilans.
+ */
+void attacherAnalyses(Game* game, Analyses* analyses, int partie);
+
+/**
+ * @brief Active les histogrammes de latence : par ligne, par donne, par affichage et par joueur.
+ *
+ * Chaque mesure coûte deux lectures de l’horloge et quelques nanosecondes
+ * d’enregistrement ; sans mesures, le seul coût est un test de pointeur.
+ *
+ * @param[in,out] game Partie dont les joueurs sont chargés.
+ * @return `1` si les mesures sont actives, `0` en cas de manque de mémoire.
+ */
+int activerMesures(Game* game);
+
+/**
+ * @brief Affiche les centiles (p50, p99, p99,9) et le maximum de chaque histogramme de latence.
+ *
+ * @param[in] game Partie dont les mesures sont actives.
+ */
+void afficherMesures(const Game* game);
+
+/**
+ * @brief Programme le passage à une autre configuration, effectif à la prochaine distribution.
+ *
+ * Les joueurs et leurs points sont conservés ; la donne suivante est tirée du
+ * paquet du nouveau modèle. La donne déjà tirée d’avance, le cache de résultats
+ * et la prédistribution, propres à l’ancienne configuration, sont abandonnés :
+ * le propriétaire de la partie rattache un cache s’il le souhaite.
+ *
+ * @param[in,out] game Partie partageant sa configuration (voir `initGamePartagee`).
+ * @param[in] modele Partie dont la configuration est chargée ; elle doit rester valide
+ *                   aussi longtemps que la partie l’utilise.
+ * @pre `game->possede_config == 0`.
+ */
+void changerModele(Game* game, const Game* modele);
+
+/**
+ * @brief Choisit le rejet anticipé des chaînes qui ne peuvent pas atteindre la cible.
+ *
+ * Avec un mode autre que `REJET_AUCUN`, les distances à la cible sont calculées
+ * au début de chaque tour (à partir de celui en cours). Une chaîne rejetée est
+ * encore vérifiée (noms et commandes possibles) : son verdict reste celui d’une
+ * exécution complète, seule la recherche de la cible est évitée. Sans effet
+ * au-delà de `MAX_ANIMAUX_CLE` animaux.
+ *
+ * @param[in,out] game État du jeu.
+ * @param[in] mode Mode de rejet.
+ * @return `1` si le mode est appliqué, `0` en cas de manque de mémoire (le rejet est alors désactivé).
+ */
+int choisirRejet(Game* game, ModeRejet mode);
+
+/**
+ * @brief Attache un fil de prédistribution : la donne de chaque tour est tirée et analysée un tour à l’avance.
+ *
+ * Les cartes sont tirées dans le même ordre qu’avec une distribution synchrone :
+ * une partie rejouée avec la même graine reçoit les mêmes donnes. Sans effet
+ * au-delà de `MAX_ANIMAUX_CLE` animaux.
+ *
+ * @param[in,out] game État du jeu, sans prédistribution attachée.
+ * @param[in,out] p Prédistribution démarrée pour la configuration de la partie.
+ * @return `1` si la prédistribution est attachée, `0` sinon.
+ */
+int attacherPredistribution(Game* game, Predistribution* p);
+
+/**
+ * @brief Détache la prédistribution de la partie, après la fin de l’analyse en cours.
+ *
+ * La donne déjà tirée reste celle du tour suivant.
+ *
+ * @param[in,out] game État du jeu.
+ */
+void detacherPredistribution(Game* game);
+
+/**
+ * @brief Reconstitue les scores et la donne en cours à partir d’un journal.
+ *
+ * Les points des joueurs absents de la partie sont ignorés. La dernière donne
+ * journalisée est redistribuée et démarre un nouveau tour. La partie doit être
+ * rattachée au journal ensuite (`game->journal`) pour que la suite y soit ajoutée.
+ *
+ * @param[in,out] game Partie fraîchement initialisée ou restaurée, sans journal ni prédistribution attachés.
+ * @param[in] chemin Fichier du journal.
+ * @param[in] depuis Position déjà contenue dans la partie (instantané), ou `NULL` pour tout relire.
+ * @return Le nombre d’événements relus, ou `-1` si le journal est absent, illisible ou ne prolonge pas `depuis`.
+ */
+int64_t reprendreJournal(Game* game, const char* chemin, const PositionJournal* depuis);
+
+/**
+ * @brief Indique si des podiums sont dans la situation cible du tour.
+ *
+ * La comparaison se fait sur les clés 64 bits quand la configuration le permet,
+ * et élément par élément sinon.
+ *
+ * @param[in] game État du jeu.
+ * @param[in] podium_b Podium Bleu à tester.
+ * @param[in] podium_r Podium Rouge à tester.
+ * @return `1` si la situation cible est atteinte, `0` sinon.
+ */
+int situationAtteinte(const Game* game, const Podium* podium_b, const Podium* podium_r);
+
+/**
+ * @brief Traite une ligne « joueur commandes » : exécution, vérification et attribution des points.
+ *
+ * Les messages sont écrits sur la sortie de la partie. La ligne est modifiée (découpage).
+ *
+ * @param[in,out] game État du jeu.
+ * @param[in,out] ligne Ligne saisie.
+ * @pre `game` est initialisé et `ligne` n’est pas `NULL`.
+ */
+void traiterLigne(Game* game, char* ligne);
+
 /**
  * @brief Lance la boucle principale du jeu.
  *
+ * Si `game->delai_ms` est positif, l’entrée est lue sans bloquer au-delà de
+ * l’échéance du tour : un tour sans séquence correcte dans le délai est redistribué.
+ *
+ * Les lignes `!latences`, `!memoire` et `!cache` affichent les mesures en cours ;
+ * avec les mesures activées, les compteurs du cache de résultats sont aussi
+ * affichés à la fin.
+ *
  * @param[in,out] game État du jeu.
  * @return `0` à la fin normale du jeu.
  * @pre `game` est initialisé.
@@ -56,8 +326,8 @@ int gameLoop(Game* game);
  * @param[in] cartes Collection de cartes pour les podiums courants.
  * @param[in] nb_animaux Nombre total d’animaux.
  * @param[in,out] game État du jeu.
- * @pre `cartes` n’est pas `NULL`, `cartes->nbElements > 0` et `game` est initialisé.
+ * @pre `cartes` n’est pas `NULL`, `nbCartes(cartes) > 0` et `game` est initialisé.
  */
-void distribuerCarteAleatoire(Vecteur* cartes, int nb_animaux, Game* game);
+void distribuerCarteAleatoire(Cartes* cartes, int nb_animaux, Game* game);
 
 
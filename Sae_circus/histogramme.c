@@ -0,0 +1,49 @@
+#include <math.h>
+#include <string.h>
+
+#include "histogramme.h"
+
+
+void initHistogramme(Histogramme* h) {
+	memset(h->seaux, 0, sizeof(h->seaux));
+	h->nb = 0;
+	h->somme = 0;
+	h->min = UINT64_MAX;
+	h->max = 0;
+}
+
+void fusionnerHistogramme(Histogramme* total, const Histogramme* h) {
+	for (int i = 0; i < NB_SEAUX_HISTOGRAMME; ++i) {
+		total->seaux[i] += h->seaux[i];
+	}
+	total->nb += h->nb;
+	total->somme += h->somme;
+	if (h->min < total->min) total->min = h->min;
+	if (h->max > total->max) total->max = h->max;
+}
+
+/* plus grande valeur rangée dans un seau */
+static uint64_t hautSeau(int seau) {
+	if (seau < SOUS_SEAUX_HISTOGRAMME) return (uint64_t)seau;
+	int decalage = (seau >> BITS_SOUS_SEAUX) - 1;
+	uint64_t bas = (uint64_t)(SOUS_SEAUX_HISTOGRAMME + (seau & (SOUS_SEAUX_HISTOGRAMME - 1))) << decalage;
+	return bas + ((uint64_t)1 << decalage) - 1;
+}
+
+uint64_t centileHistogramme(const Histogramme* h, double centile) {
+	if (h->nb == 0) return 0;
+	if (centile <= 0.0) return h->min;
+	if (centile >= 100.0) return h->max;
+	uint64_t rang = (uint64_t)ceil(centile / 100.0 * (double)h->nb);
+
+	uint64_t cumul = 0;
+	for (int i = 0; i < NB_SEAUX_HISTOGRAMME; ++i) {
+		cumul += h->seaux[i];
+		if (cumul >= rang) {
+			uint64_t valeur = hautSeau(i);
+			if (valeur > h->max) valeur = h->max;
+			return valeur < h->min ? h->min : valeur;
+		}
+	}
+	return h->max;
+}
@@ -0,0 +1,110 @@
+/**
+ * @file histogramme.h
+ * @brief Histogrammes de latences à précision relative constante (façon HDR).
+ *
+ * Les valeurs inférieures à `SOUS_SEAUX_HISTOGRAMME` ont chacune leur seau ; au-delà,
+ * chaque puissance de deux est découpée en `SOUS_SEAUX_HISTOGRAMME` seaux de même
+ * largeur, soit une erreur relative inférieure à 1 % sur les centiles. Le tableau
+ * des seaux est fixe : un enregistrement ne fait qu’un calcul de bits et une
+ * incrémentation, sans allocation ni verrou. Un histogramme appartient au thread
+ * qui l’alimente ; `fusionnerHistogramme` en regroupe plusieurs.
+ *
+ * Les valeurs sont des nanosecondes ; au-delà de `VALEUR_MAX_HISTOGRAMME` (environ
+ * 36 minutes), elles tombent dans le dernier seau, le maximum restant exact.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+enum {
+    BITS_SOUS_SEAUX = 7,
+    SOUS_SEAUX_HISTOGRAMME = 1 << BITS_SOUS_SEAUX,
+    BIT_MAX_HISTOGRAMME = 41,  /**< Les valeurs sont bornées à 2^41 - 1. */
+    NB_SEAUX_HISTOGRAMME = (BIT_MAX_HISTOGRAMME - BITS_SOUS_SEAUX + 1) * SOUS_SEAUX_HISTOGRAMME
+};
+
+#define VALEUR_MAX_HISTOGRAMME ((UINT64_C(1) << BIT_MAX_HISTOGRAMME) - 1)
+
+/**
+ * @brief Histogramme de valeurs (ns).
+ */
+typedef struct {
+    uint64_t seaux[NB_SEAUX_HISTOGRAMME];
+    uint64_t nb;      /**< Nombre de valeurs enregistrées. */
+    uint64_t somme;   /**< Somme des valeurs, pour la moyenne. */
+    uint64_t min;     /**< Plus petite valeur, `UINT64_MAX` si vide. */
+    uint64_t max;     /**< Plus grande valeur, `0` si vide. */
+} Histogramme;
+
+/* rang du bit de poids fort, v > 0 */
+static inline int bitFortHistogramme(uint64_t v) {
+#if defined(_MSC_VER)
+    unsigned long rang;
+    _BitScanReverse64(&rang, v);
+    return (int)rang;
+#elif defined(__GNUC__)
+    return 63 - __builtin_clzll(v);
+#else
+    int rang = 0;
+    while (v >>= 1) ++rang;
+    return rang;
+#endif
+}
+
+/**
+ * @brief Indice du seau d’une valeur.
+ *
+ * @param[in] valeur Valeur.
+ * @return Un indice dans `[0, NB_SEAUX_HISTOGRAMME)`.
+ */
+static inline int seauHistogramme(uint64_t valeur) {
+    if (valeur < SOUS_SEAUX_HISTOGRAMME) return (int)valeur;
+    if (valeur > VALEUR_MAX_HISTOGRAMME) valeur = VALEUR_MAX_HISTOGRAMME;
+    int rang = bitFortHistogramme(valeur);
+    int decalage = rang - BITS_SOUS_SEAUX;
+    return ((decalage + 1) << BITS_SOUS_SEAUX) + (int)((valeur >> decalage) - SOUS_SEAUX_HISTOGRAMME);
+}
+
+/**
+ * @brief Enregistre une valeur.
+ *
+ * @param[in,out] h Histogramme.
+ * @param[in] valeur Valeur (ns).
+ */
+static inline void enregistrerHistogramme(Histogramme* h, uint64_t valeur) {
+    ++h->seaux[seauHistogramme(valeur)];
+    ++h->nb;
+    h->somme += valeur;
+    if (valeur < h->min) h->min = valeur;
+    if (valeur > h->max) h->max = valeur;
+}
+
+/**
+ * @brief Initialise un histogramme vide.
+ *
+ * @param[out] h Histogramme.
+ */
+void initHistogramme(Histogramme* h);
+
+/**
+ * @brief Ajoute les valeurs d’un histogramme à un autre.
+ *
+ * @param[in,out] total Histogramme recevant les valeurs.
+ * @param[in] h Histogramme ajouté.
+ */
+void fusionnerHistogramme(Histogramme* total, const Histogramme* h);
+
+/**
+ * @brief Centile d’un histogramme.
+ *
+ * @param[in] h Histogramme.
+ * @param[in] centile Rang entre `0` et `100` (par exemple `99.9`).
+ * @return La plus grande valeur du seau atteint (bornée par le maximum) ; le minimum pour `0`,
+ *         le maximum pour `100`, `0` si l’histogramme est vide.
+ */
+uint64_t centileHistogramme(const Histogramme* h, double centile);
@@ -0,0 +1,287 @@
+#include "instantane.h"
+
+static const char MAGIE_INSTANTANE[8] = "SAEINST";
+enum { NB_PODIUMS_INSTANTANE = 4 };
+
+/* ---- écriture ---- */
+
+static int poser(Tampon* t, const void* octets, size_t n) {
+	return ajouterTampon(t, (const char*)octets, n);
+}
+
+static int poser8(Tampon* t, uint8_t v) {
+	return poser(t, &v, 1);
+}
+
+static int poser16(Tampon* t, uint16_t v) {
+	uint8_t o[2] = { (uint8_t)v, (uint8_t)(v >> 8) };
+	return poser(t, o, sizeof(o));
+}
+
+static int poser32(Tampon* t, uint32_t v) {
+	uint8_t o[4];
+	for (int i = 0; i < 4; ++i) o[i] = (uint8_t)(v >> (8 * i));
+	return poser(t, o, sizeof(o));
+}
+
+static int poser64(Tampon* t, uint64_t v) {
+	uint8_t o[8];
+	for (int i = 0; i < 8; ++i) o[i] = (uint8_t)(v >> (8 * i));
+	return poser(t, o, sizeof(o));
+}
+
+static uint32_t sommeInstantane(const uint8_t* donnees, size_t longueur) {
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < longueur; ++i) {
+		h = (h ^ donnees[i]) * 16777619u;
+	}
+	return h;
+}
+
+static int poserPodium(Tampon* t, const Podium* p) {
+	int ok = poser16(t, (uint16_t)p->nbElements);
+	for (int64_t i = 0; i < p->nbElements && ok; ++i) {
+		ok = poser16(t, (uint16_t)p->elements[i]);
+	}
+	return ok;
+}
+
+int ecrireInstantane(const Game* game, const PositionJournal* position, Tampon* t) {
+	size_t debut = t->taille;
+	const Podium* podiums[NB_PODIUMS_INSTANTANE] = { game->podium_b, game->podium_r, game->target_b, game->target_r };
+
+	int ok = poser(t, MAGIE_INSTANTANE, sizeof(MAGIE_INSTANTANE))
+		&& poser32(t, VERSION_INSTANTANE)
+		&& poser32(t, (uint32_t)game->animaux->nbElements)
+		&& poser8(t, position != NULL)
+		&& poser32(t, position ? position->generation : 0)
+		&& poser64(t, position ? position->decalage : 0);
+	for (int i = 0; i < 4 && ok; ++i) {
+		ok = poser64(t, game->alea.s[i]);
+	}
+	ok = ok && poser64(t, game->numero_tour)
+		&& poser32(t, (uint32_t)game->nb_jouees)
+		&& poser32(t, (uint32_t)game->carte_suivante)
+		&& poser32(t, (uint32_t)game->cible_suivante)
+		&& poser8(t, (uint8_t)game->rejet);
+	for (int i = 0; i < NB_PODIUMS_INSTANTANE && ok; ++i) {
+		ok = poserPodium(t, podiums[i]);
+	}
+
+	/* joueurs dans l’ordre du classement : la restauration n’a pas à trier */
+	ok = ok && poser32(t, (uint32_t)game->joueurs->nbElements);
+	for (int64_t i = 0; i < game->joueurs->nbElements && ok; ++i) {
+		const Joueur* j = &game->joueurs->elements[i];
+		ok = j->nom.longueur <= UINT16_MAX
+			&& poser16(t, (uint16_t)j->nom.longueur)
+			&& poser(t, j->nom.texte, j->nom.longueur)
+			&& poser32(t, (uint32_t)j->points)
+			&& poser8(t, (uint8_t)j->tour)
+			&& poser32(t, (uint32_t)j->nb_coups)
+			&& poser64(t, j->latence_totale)
+			&& poser64(t, j->derniere_latence);
+	}
+
+	ok = ok && poser32(t, sommeInstantane((const uint8_t*)&t->donnees[debut], t->taille - debut));
+	if (!ok) t->taille = debut;
+	return ok;
+}
+
+/* ---- lecture ---- */
+
+typedef struct {
+	const uint8_t* p;
+	size_t reste;
+	int erreur;
+} Lecteur;
+
+static const uint8_t* prendre(Lecteur* l, size_t n) {
+	if (l->erreur || l->reste < n) {
+		l->erreur = 1;
+		return NULL;
+	}
+	const uint8_t* p = l->p;
+	l->p += n;
+	l->reste -= n;
+	return p;
+}
+
+static uint64_t prendreEntier(Lecteur* l, int octets) {
+	const uint8_t* p = prendre(l, (size_t)octets);
+	uint64_t v = 0;
+	for (int i = 0; p && i < octets; ++i) v |= (uint64_t)p[i] << (8 * i);
+	return v;
+}
+
+typedef struct {
+	const uint8_t* nom;
+	size_t longueur;
+	int points;
+	int tour;
+	int nb_coups;
+	uint64_t latence_totale;
+	uint64_t derniere_latence;
+} JoueurInstantane;
+
+/* podium lu sur place : nombre d’animaux puis leurs indices (vérifiés) */
+static const uint8_t* prendrePodium(Lecteur* l, int n, int* nb) {
+	*nb = (int)prendreEntier(l, 2);
+	if (*nb > n) l->erreur = 1;
+	const uint8_t* indices = prendre(l, 2 * (size_t)*nb);
+	for (int i = 0; indices && i < *nb; ++i) {
+		if ((indices[2 * i] | indices[2 * i + 1] << 8) >= n) l->erreur = 1;
+	}
+	return indices;
+}
+
+static void remplirPodium(Podium* p, const uint8_t* indices, int nb) {
+	clearPodium(p);
+	for (int i = 0; i < nb; ++i) {
+		ajouterPodiumAnimal(p, indices[2 * i] | indices[2 * i + 1] << 8);
+	}
+}
+
+int restaurerInstantane(Game* game, const Game* modele, const uint8_t* donnees, size_t longueur, PositionJournal* position) {
+	if (longueur < sizeof(MAGIE_INSTANTANE) + 4
+		|| sommeInstantane(donnees, longueur - 4) != (uint32_t)(donnees[longueur - 4] | donnees[longueur - 3] << 8
+			| donnees[longueur - 2] << 16 | (uint32_t)donnees[longueur - 1] << 24)) {
+		return -1;
+	}
+	Lecteur l = { donnees, longueur - 4, 0 };
+	int n = (int)modele->animaux->nbElements;
+	const uint8_t* magie = prendre(&l, sizeof(MAGIE_INSTANTANE));
+	if (!magie || memcmp(magie, MAGIE_INSTANTANE, sizeof(MAGIE_INSTANTANE)) != 0
+		|| prendreEntier(&l, 4) != VERSION_INSTANTANE || prendreEntier(&l, 4) != (uint64_t)n) {
+		return -1;
+	}
+
+	/* tout est lu et vérifié avant de toucher à la partie */
+	int avec_position = (int)prendreEntier(&l, 1);
+	PositionJournal lue;
+	lue.generation = (uint32_t)prendreEntier(&l, 4);
+	lue.decalage = prendreEntier(&l, 8);
+	Aleatoire alea;
+	for (int i = 0; i < 4; ++i) alea.s[i] = prendreEntier(&l, 8);
+	uint64_t numero_tour = prendreEntier(&l, 8);
+	int nb_jouees = (int)(int32_t)prendreEntier(&l, 4);
+	int carte_suivante = (int)(int32_t)prendreEntier(&l, 4);
+	int cible_suivante = (int)(int32_t)prendreEntier(&l, 4);
+	int rejet = (int)prendreEntier(&l, 1);
+	const uint8_t* podiums[NB_PODIUMS_INSTANTANE];
+	int tailles[NB_PODIUMS_INSTANTANE];
+	for (int i = 0; i < NB_PODIUMS_INSTANTANE; ++i) {
+		podiums[i] = prendrePodium(&l, n, &tailles[i]);
+	}
+	int64_t nb_cartes = nbCartes(modele->cartes);
+	if (carte_suivante >= nb_cartes || cible_suivante >= nb_cartes || (carte_suivante < 0) != (cible_suivante < 0)
+		|| rejet < REJET_AUCUN || rejet > REJET_PREFIXE) {
+		l.erreur = 1;
+	}
+
+	uint32_t nb_joueurs = (uint32_t)prendreEntier(&l, 4);
+	if (l.erreur || nb_joueurs == 0 || nb_joueurs > l.reste / 27) {
+		return -1;
+	}
+	JoueurInstantane* joueurs = (JoueurInstantane*)malloc(sizeof(JoueurInstantane) * nb_joueurs);
+	char** noms = (char**)malloc(sizeof(char*) * nb_joueurs);
+	char* textes = (char*)malloc(longueur + nb_joueurs);
+	int resultat = -1;
+	if (!joueurs || !noms || !textes) goto fin;
+	char* texte = textes;
+	for (uint32_t i = 0; i < nb_joueurs; ++i) {
+		JoueurInstantane* j = &joueurs[i];
+		j->longueur = (size_t)prendreEntier(&l, 2);
+		j->nom = prendre(&l, j->longueur);
+		j->points = (int)(int32_t)prendreEntier(&l, 4);
+		j->tour = (int)prendreEntier(&l, 1);
+		j->nb_coups = (int)(int32_t)prendreEntier(&l, 4);
+		j->latence_totale = prendreEntier(&l, 8);
+		j->derniere_latence = prendreEntier(&l, 8);
+		if (l.erreur) goto fin;
+		memcpy(texte, j->nom, j->longueur);
+		texte[j->longueur] = '\0';
+		noms[i] = texte;
+		texte += j->longueur + 1;
+	}
+	if (l.reste != 0) goto fin;
+
+	if (initGamePartagee(game, modele, (int)nb_joueurs, noms, 0) != 0) {
+		detruireGame(game);
+		goto fin;
+	}
+	for (uint32_t i = 0; i < nb_joueurs; ++i) {
+		Joueur* j = obtenirJoueur(game->joueurs, (int)i);
+		j->points = joueurs[i].points;
+		j->tour = joueurs[i].tour;
+		j->nb_coups = joueurs[i].nb_coups;
+		j->latence_totale = joueurs[i].latence_totale;
+		j->derniere_latence = joueurs[i].derniere_latence;
+	}
+	Podium* destinations[NB_PODIUMS_INSTANTANE] = { game->podium_b, game->podium_r, game->target_b, game->target_r };
+	for (int i = 0; i < NB_PODIUMS_INSTANTANE; ++i) {
+		remplirPodium(destinations[i], podiums[i], tailles[i]);
+	}
+	game->cle_cible = empaqueterPodiums(game->target_b, game->target_r);
+	game->alea = alea;
+	game->numero_tour = numero_tour;
+	game->debut_tour = maintenantMs();
+	game->nb_jouees = nb_jouees;
+	game->carte_suivante = carte_suivante;
+	game->cible_suivante = cible_suivante;
+	choisirRejet(game, (ModeRejet)rejet);
+	if (position) {
+		*position = lue;
+		if (!avec_position) position->generation = UINT32_MAX;
+	}
+	resultat = 0;
+
+fin:
+	free(joueurs);
+	free(noms);
+	free(textes);
+	return resultat;
+}
+
+/* ---- fichiers et points de reprise ---- */
+
+int sauvegarderInstantane(const Game* game, const PositionJournal* position, const char* chemin) {
+	Tampon t;
+	initTampon(&t);
+	int ok = ecrireInstantane(game, position, &t) && ecrireFichierDurable(chemin, t.donnees, t.taille);
+	detruireTampon(&t);
+	return ok;
+}
+
+int chargerInstantane(Game* game, const Game* modele, const char* chemin, PositionJournal* position) {
+	FILE* f = fopen(chemin, "rb");
+	if (!f) return 1;
+	fseek(f, 0, SEEK_END);
+	long taille = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	uint8_t* contenu = taille > 0 ? (uint8_t*)malloc((size_t)taille) : NULL;
+	int lu = contenu && fread(contenu, 1, (size_t)taille, f) == (size_t)taille;
+	fclose(f);
+	int resultat = lu ? restaurerInstantane(game, modele, contenu, (size_t)taille, position) : 1;
+	free(contenu);
+	return resultat;
+}
+
+int pointDeReprise(Game* game, const char* chemin_instantane, const char* chemin_journal) {
+	if (!game->journal) return 0;
+	PositionJournal position = game->journal->fin;
+	if (!sauvegarderInstantane(game, &position, chemin_instantane)) return 0;
+	if (!renouvelerJournal(game->journal, chemin_journal)) {
+		game->journal = NULL;
+		return 0;
+	}
+	return 1;
+}
+
+int64_t reprendrePartie(Game* game, const Game* modele, const char* chemin_instantane, const char* chemin_journal) {
+	PositionJournal position;
+	if (chargerInstantane(game, modele, chemin_instantane, &position) != 0) return -1;
+	/* un instantané sans position ne dit pas quelle partie du journal il contient */
+	if (!chemin_journal || position.generation == UINT32_MAX) return 0;
+	int64_t nb = reprendreJournal(game, chemin_journal, &position);
+	return nb < 0 ? 0 : nb;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file instantane.h
+ * @brief Instantanés binaires d’une partie, pour un redémarrage rapide ou le déplacement d’une salle.
+ *
+ * Un instantané contient tout l’état propre à une partie : joueurs (dans l’ordre
+ * du classement) avec leurs points, leur droit de jouer et leurs latences,
+ * podiums courants et cibles, état du générateur, numéro du tour et donne déjà
+ * tirée pour le tour suivant. La configuration (animaux, commandes, paquet)
+ * n’y figure pas : la partie restaurée la partage avec un modèle, comme
+ * `initGamePartagee`. Seul le nombre d’animaux est vérifié. La minuterie non
+ * plus : elle est rattachée à nouveau par l’appelant (`attacherMinuterie`).
+ *
+ * Format : en-tête (`"SAEINST"`, octet nul, version, nombre d’animaux, position du
+ * journal), puis les champs, entiers en petit-boutiste, et une somme FNV-1a finale.
+ * Quelques centaines d’octets pour une salle ordinaire : l’écriture et la relecture
+ * se mesurent en microsecondes.
+ *
+ * Un point de reprise écrit un instantané avec la position du journal qu’il
+ * contient déjà, puis renouvelle le journal : la relecture au redémarrage se
+ * limite aux événements postérieurs au dernier point de reprise.
+ */
+
+#pragma once
+
+#include "game.h"
+
+/** @brief Version du format des instantanés. */
+enum { VERSION_INSTANTANE = 1 };
+
+/**
+ * @brief Ajoute l’instantané d’une partie à un tampon.
+ *
+ * @param[in] game Partie.
+ * @param[in] position Position du journal contenue dans l’instantané, ou `NULL`.
+ * @param[in,out] t Tampon recevant l’instantané.
+ * @return `1` si l’écriture réussit, `0` en cas de manque de mémoire.
+ */
+int ecrireInstantane(const Game* game, const PositionJournal* position, Tampon* t);
+
+/**
+ * @brief Restaure une partie à partir d’un instantané.
+ *
+ * L’instantané est entièrement vérifié avant que la partie soit initialisée.
+ *
+ * @param[out] game Partie à initialiser ; à détruire par `detruireGame` seulement si la restauration réussit.
+ * @param[in] modele Partie dont la configuration est chargée (voir `initGamePartagee`).
+ * @param[in] donnees Instantané.
+ * @param[in] longueur Taille de l’instantané.
+ * @param[out] position Position du journal contenue dans l’instantané (génération `UINT32_MAX`
+ *                 s’il n’en contient pas), ou `NULL`.
+ * @return `0` si la restauration réussit, `-1` si l’instantané est invalide ou ne correspond pas à la configuration.
+ */
+int restaurerInstantane(Game* game, const Game* modele, const uint8_t* donnees, size_t longueur, PositionJournal* position);
+
+/**
+ * @brief Écrit l’instantané d’une partie dans un fichier (nom temporaire, synchronisation, puis renommage).
+ *
+ * @param[in] game Partie.
+ * @param[in] position Position du journal contenue dans l’instantané, ou `NULL`.
+ * @param[in] chemin Fichier de l’instantané.
+ * @return `1` si l’écriture réussit, `0` sinon.
+ */
+int sauvegarderInstantane(const Game* game, const PositionJournal* position, const char* chemin);
+
+/**
+ * @brief Restaure une partie à partir d’un fichier d’instantané.
+ *
+ * @param[out] game Partie à initialiser ; à détruire par `detruireGame` seulement si la restauration réussit.
+ * @param[in] modele Partie dont la configuration est chargée.
+ * @param[in] chemin Fichier de l’instantané.
+ * @param[out] position Position du journal contenue dans l’instantané, ou `NULL`.
+ * @return `0` si la restauration réussit, `1` si le fichier est absent ou illisible
+ *         (`game` n’est alors pas initialisée), `-1` si l’instantané est invalide.
+ */
+int chargerInstantane(Game* game, const Game* modele, const char* chemin, PositionJournal* position);
+
+/**
+ * @brief Point de reprise : instantané de la partie, puis renouvellement de son journal.
+ *
+ * @param[in,out] game Partie rattachée à un journal (`game->journal`) ; si le journal
+ *                ne peut pas être rouvert, il est fermé et détaché.
+ * @param[in] chemin_instantane Fichier de l’instantané.
+ * @param[in] chemin_journal Fichier du journal.
+ * @return `1` si le point de reprise est écrit et le journal renouvelé, `0` sinon.
+ */
+int pointDeReprise(Game* game, const char* chemin_instantane, const char* chemin_journal);
+
+/**
+ * @brief Reprend une partie : dernier instantané, puis événements journalisés depuis.
+ *
+ * @param[out] game Partie à initialiser (à détruire par `detruireGame` si le retour n’est pas `-1`).
+ * @param[in] modele Partie dont la configuration est chargée.
+ * @param[in] chemin_instantane Fichier de l’instantané.
+ * @param[in] chemin_journal Fichier du journal, ou `NULL`.
+ * @return Le nombre d’événements relus, ou `-1` s’il n’y a pas d’instantané valide.
+ */
+int64_t reprendrePartie(Game* game, const Game* modele, const char* chemin_instantane, const char* chemin_journal);
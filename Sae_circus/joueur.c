@@ -3,36 +3,47 @@
 #include "joueur.h"
 
 
-Joueur* creerJoueur(const char* nom) {
-	Joueur* j = (Joueur*)malloc(sizeof(Joueur));
-
+int creerJoueur(Joueur* j, const char* nom, PoolNoms* noms) {
 	j->tour = 1;
 	j->points = 0;
-	j->nom = (char*)malloc(strlen(nom) + 1);
-	strcpy(j->nom, nom);
-	return j;
+	j->nb_coups = 0;
+	j->latence_totale = 0;
+	j->derniere_latence = 0;
+	j->reflexion = NULL;
+	return internerNom(noms, nom, &j->nom);
 }
 
 int initJoueurs(Joueurs* joueurs, int capacite) {
-	return initVecteur(joueurs, capacite);
+	return initPourVecteurJoueur(joueurs, capacite, MEMOIRE_JOUEURS);
 }
-int ajouterJoueur(Joueurs* joueurs, const char* nom) {
-	Joueur* j = creerJoueur(nom);
-	ajouter(joueurs, j);
+int ajouterJoueur(Joueurs* joueurs, const char* nom, PoolNoms* noms) {
+	Joueur j;
+	if (!creerJoueur(&j, nom, noms)) return 0;
+	return ajouterVecteurJoueur(joueurs, j);
 }
 Joueur* obtenirJoueur(const Joueurs* joueurs, int i) {
-	return obtenir(joueurs, i);
+	return obtenirVecteurJoueur(joueurs, i);
 }
 
 
-Joueur* obtenirJoueurParNom(const Joueurs* joueurs, const char* nom) {
+static int indiceJoueurParNom(const Joueurs* joueurs, const char* nom) {
+	size_t longueur = strlen(nom);
+	uint32_t h = hacherNom(nom, longueur);
 	for (int i = 0; i < joueurs->nbElements; ++i) {
 		Joueur* j = obtenirJoueur(joueurs, i);
-		if (strcmp(j->nom, nom) == 0) {
-			return j;
+		if (nomEgal(&j->nom, nom, longueur, h)) {
+			return i;
 		}
 	}
-	return NULL;
+	return -1;
+}
+
+Joueur* obtenirJoueurParNom(const Joueurs* joueurs, const char* nom) {
+	int i = indiceJoueurParNom(joueurs, nom);
+	if (i < 0) {
+		return NULL;
+	}
+	return obtenirJoueur(joueurs, i);
 }
 int peutJouer(const Joueurs* joueurs, char* nom) {
 	Joueur* j = obtenirJoueurParNom(joueurs, nom);
@@ -46,10 +57,52 @@ int joueurExiste(const Joueurs* joueurs, char* nom) {
 	return (obtenirJoueurParNom(joueurs, nom) != NULL);
 }
 
-void ajouterPointJoueur(Joueurs* joueurs,char* nom_j) {
-	Joueur* j = obtenirJoueurParNom(joueurs, nom_j);
-	++j->points;
-	j->tour = 1;
+Joueur* ajouterPointJoueur(Joueurs* joueurs, Joueur* j) {
+	Joueur* premier = obtenirJoueur(joueurs, premierAvecPoints(joueurs, j->points));
+	Joueur tmp = *premier;
+	*premier = *j;
+	*j = tmp;
+
+	++premier->points;
+	premier->tour = 1;
+	return premier;
+}
+
+int premierAvecPoints(const Joueurs* joueurs, int points) {
+	int bas = 0;
+	int haut = joueurs->nbElements;
+	while (bas < haut) {
+		int milieu = bas + (haut - bas) / 2;
+		Joueur* j = obtenirJoueur(joueurs, milieu);
+		if (j->points > points) {
+			bas = milieu + 1;
+		}
+		else {
+			haut = milieu;
+		}
+	}
+	return bas;
+}
+
+int rangJoueur(const Joueurs* joueurs, const Joueur* j) {
+	return premierAvecPoints(joueurs, j->points) + 1;
+}
+
+int meilleursJoueurs(const Joueurs* joueurs, int k, Joueur** meilleurs) {
+	if (k > joueurs->nbElements) {
+		k = joueurs->nbElements;
+	}
+	for (int i = 0; i < k; ++i) {
+		meilleurs[i] = obtenirJoueur(joueurs, i);
+	}
+	return k;
+}
+
+void enregistrerLatenceJoueur(Joueur* j, uint64_t latence) {
+	++j->nb_coups;
+	j->latence_totale += latence;
+	j->derniere_latence = latence;
+	if (j->reflexion) enregistrerHistogramme(j->reflexion, latence * 1000000);
 }
 
 Joueur* lastPerson(Joueurs* joueurs){
@@ -62,14 +115,6 @@ Joueur* lastPerson(Joueurs* joueurs){
 	return NULL;
 }
 
-void afficherResultats(Joueurs* joueurs) {
-	for (int i = 0; i < joueurs->nbElements; ++i) {
-		Joueur* j = obtenirJoueur(joueurs, i);
-		printf("%s %d\n", j->nom, j->points);
-	}
-	printf("\n\n");
-}
-
 void remetreTours(Joueurs* joueurs) {
 	for (int i = 0; i < joueurs->nbElements; ++i) {
 		Joueur* j = obtenirJoueur(joueurs, i);
@@ -4,6 +4,10 @@
  *
  * Ce module définit le type `Joueur`, le conteneur `Joueurs` et les fonctions
  * permettant de créer, stocker et manipuler les joueurs et leurs scores.
+ *
+ * Le conteneur `Joueurs` sert aussi de classement : il est maintenu trié par
+ * points décroissants, ce qui permet de répondre aux requêtes « top K » en O(K)
+ * et « rang d’un joueur » en O(log P) à tout moment de la partie.
  */
 
 #pragma once
@@ -13,30 +17,45 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
-#include "vecteur.h"
+#include <stdint.h>
+#include "vecteurtype.h"
+#include "noms.h"
+#include "histogramme.h"
 
 /**
  * @brief Représente un joueur.
  */
 typedef struct {
-    char* nom;
+    Nom nom;  /**< Nom interné du joueur. */
     int tour;
     int points;
+
+    int nb_coups;               /**< Nombre de coups joués. */
+    uint64_t latence_totale;    /**< Somme des temps de réponse (ms). */
+    uint64_t derniere_latence;  /**< Temps de réponse du dernier coup (ms). */
+    Histogramme* reflexion;     /**< Temps de réponse (ns, au milliseconde près), ou `NULL` sans mesures. */
 } Joueur;
 
+VECTEUR_DEF(VecteurJoueur, Joueur)
+
 /**
- * @brief Conteneur de joueurs.
+ * @brief Conteneur de joueurs stockés par valeur, trié par points décroissants.
+ *
+ * Un `Joueur*` obtenu dans le conteneur désigne une case du classement : il
+ * n’est plus valide après `ajouterPointJoueur`, qui peut déplacer le joueur.
  */
-typedef Vecteur Joueurs;
+typedef VecteurJoueur Joueurs;
 
 /**
- * @brief Crée un joueur à partir de son nom.
+ * @brief Initialise un joueur à partir de son nom.
  *
+ * @param[out] j Joueur à initialiser.
  * @param[in] nom Nom du joueur.
- * @return Un pointeur vers un joueur initialisé, ou `NULL` en cas d’erreur.
- * @pre `nom` n’est pas `NULL`.
+ * @param[in,out] noms Réserve où le nom est interné.
+ * @return `1` si l’opération réussit, `0` sinon.
+ * @pre `j` et `nom` ne sont pas `NULL`.
  */
-Joueur* creerJoueur(const char* nom);
+int creerJoueur(Joueur* j, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Initialise un conteneur de joueurs.
@@ -53,10 +72,11 @@ int initJoueurs(Joueurs* joueurs, int capacite);
  *
  * @param[in,out] joueurs Conteneur de joueurs.
  * @param[in] nom Nom du joueur.
+ * @param[in,out] noms Réserve où le nom est interné.
  * @return `1` si l’ajout réussit, `0` sinon.
  * @pre `joueurs` est initialisé et `nom` n’est pas `NULL`.
  */
-int ajouterJoueur(Joueurs* joueurs, const char* nom);
+int ajouterJoueur(Joueurs* joueurs, const char* nom, PoolNoms* noms);
 
 /**
  * @brief Accède à un joueur par son indice.
@@ -95,13 +115,57 @@ int peutJouer(const Joueurs* joueurs, char* nom);
 int joueurExiste(const Joueurs* joueurs, char* nom);
 
 /**
- * @brief Ajoute un point à un joueur.
+ * @brief Ajoute un point à un joueur et met à jour le classement.
+ *
+ * Le joueur est échangé avec le premier joueur de son groupe de points
+ * (trouvé par dichotomie), ce qui conserve le tri en O(log P). Le joueur est
+ * désigné par sa case, que l’appelant détient déjà : aucune recherche par nom.
  *
  * @param[in,out] joueurs Conteneur de joueurs.
- * @param[in] nom_j Nom du joueur.
- * @pre Le joueur existe.
+ * @param[in,out] j Joueur, case du conteneur (voir `obtenirJoueurParNom`).
+ * @return L’adresse du joueur à sa nouvelle place dans le classement ;
+ *         `j` désigne alors le joueur avec qui il a été échangé.
+ */
+Joueur* ajouterPointJoueur(Joueurs* joueurs, Joueur* j);
+
+/**
+ * @brief Retourne la position du premier joueur ayant au plus `points` points.
+ *
+ * @param[in] joueurs Conteneur de joueurs.
+ * @param[in] points Nombre de points recherché.
+ * @return Un indice dans `[0, taille(joueurs)]`.
+ */
+int premierAvecPoints(const Joueurs* joueurs, int points);
+
+/**
+ * @brief Retourne le rang d’un joueur dans le classement (les ex aequo partagent le même rang).
+ *
+ * @param[in] joueurs Conteneur de joueurs.
+ * @param[in] j Joueur.
+ * @return Le rang, à partir de 1.
+ * @pre `j` appartient à `joueurs`.
+ */
+int rangJoueur(const Joueurs* joueurs, const Joueur* j);
+
+/**
+ * @brief Copie les `k` premiers joueurs du classement.
+ *
+ * @param[in] joueurs Conteneur de joueurs.
+ * @param[in] k Nombre de joueurs demandés.
+ * @param[out] meilleurs Tableau d’au moins `k` cases recevant les joueurs.
+ * @return Le nombre de joueurs copiés (au plus `k`).
+ */
+int meilleursJoueurs(const Joueurs* joueurs, int k, Joueur** meilleurs);
+
+/**
+ * @brief Enregistre le temps de réponse d’un coup (entre la distribution et la soumission).
+ *
+ * Le temps est aussi ajouté à l’histogramme `reflexion` du joueur, s’il en a un.
+ *
+ * @param[in,out] j Joueur.
+ * @param[in] latence Temps de réponse (ms).
  */
-void ajouterPointJoueur(Joueurs* joueurs, char* nom_j);
+void enregistrerLatenceJoueur(Joueur* j, uint64_t latence);
 
 /**
  * @brief Réactive le tour de tous les joueurs.
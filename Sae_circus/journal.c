@@ -0,0 +1,306 @@
+#include <errno.h>
+#include <time.h>
+#include "journal.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+static const char MAGIE_JOURNAL[8] = "SAEJRNL";
+enum { TAILLE_ENTETE_JOURNAL = 16, LONGUEUR_MAX_EVENEMENT = 0xFFFF };
+
+
+static uint32_t sommeEvenement(uint8_t type, const uint8_t* donnees, size_t longueur) {
+	uint32_t h = 2166136261u;
+	uint8_t tete[3] = { type, (uint8_t)longueur, (uint8_t)(longueur >> 8) };
+	for (int i = 0; i < 3; ++i) {
+		h = (h ^ tete[i]) * 16777619u;
+	}
+	for (size_t i = 0; i < longueur; ++i) {
+		h = (h ^ donnees[i]) * 16777619u;
+	}
+	return h;
+}
+
+static uint32_t lire32(const uint8_t* p) {
+	return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void ecrire32(uint8_t* p, uint32_t v) {
+	p[0] = (uint8_t)v;
+	p[1] = (uint8_t)(v >> 8);
+	p[2] = (uint8_t)(v >> 16);
+	p[3] = (uint8_t)(v >> 24);
+}
+
+/* parcourt un journal à partir d’une position (NULL : du début) ;
+   *fin reçoit la position qui suit le dernier enregistrement valide */
+static int64_t parcourirJournal(const char* chemin, const PositionJournal* depuis, LireEvenement lire, void* contexte,
+	PositionJournal* fin) {
+	FILE* f = fopen(chemin, "rb");
+	if (!f) return -1;
+	fseek(f, 0, SEEK_END);
+	long taille = ftell(f);
+	fseek(f, 0, SEEK_SET);
+	uint8_t* contenu = taille > 0 ? (uint8_t*)malloc((size_t)taille) : NULL;
+	int lu = contenu && fread(contenu, 1, (size_t)taille, f) == (size_t)taille;
+	fclose(f);
+	if (!lu || taille < TAILLE_ENTETE_JOURNAL || memcmp(contenu, MAGIE_JOURNAL, sizeof(MAGIE_JOURNAL)) != 0
+		|| lire32(&contenu[8]) != VERSION_JOURNAL) {
+		free(contenu);
+		return -1;
+	}
+
+	uint32_t generation = lire32(&contenu[12]);
+	long position = TAILLE_ENTETE_JOURNAL;
+	if (depuis && generation == depuis->generation) {
+		position = (long)depuis->decalage;
+	}
+	else if (depuis && generation != depuis->generation + 1) {
+		free(contenu);
+		return -1;
+	}
+
+	/* une position au-delà de la fin valide ne prolonge pas ce journal */
+	int64_t nb = 0;
+	long debut = position;
+	position = TAILLE_ENTETE_JOURNAL;
+	while (taille - position >= 7) {
+		const uint8_t* e = &contenu[position];
+		size_t longueur = (size_t)e[1] | (size_t)e[2] << 8;
+		if ((size_t)(taille - position) < 7 + longueur
+			|| lire32(&e[3 + longueur]) != sommeEvenement(e[0], &e[3], longueur)) {
+			break;
+		}
+		if (position >= debut) {
+			if (lire) lire(contexte, e[0], &e[3], longueur);
+			++nb;
+		}
+		position += (long)(7 + longueur);
+	}
+	free(contenu);
+	if (position < debut) return -1;
+	if (fin) {
+		fin->generation = generation;
+		fin->decalage = (uint64_t)position;
+	}
+	return nb;
+}
+
+int64_t lireJournal(const char* chemin, LireEvenement lire, void* contexte) {
+	return parcourirJournal(chemin, NULL, lire, contexte, NULL);
+}
+
+int64_t lireJournalDepuis(const char* chemin, const PositionJournal* depuis, LireEvenement lire, void* contexte) {
+	return parcourirJournal(chemin, depuis, lire, contexte, NULL);
+}
+
+static int synchroniser(FILE* f) {
+	if (fflush(f) != 0) return 0;
+#ifdef _WIN32
+	return _commit(_fileno(f)) == 0;
+#else
+	return fsync(fileno(f)) == 0;
+#endif
+}
+
+int ecrireFichierDurable(const char* chemin, const void* donnees, size_t longueur) {
+	size_t taille = strlen(chemin) + sizeof(".tmp");
+	char* temporaire = (char*)malloc(taille);
+	if (!temporaire) return 0;
+	snprintf(temporaire, taille, "%s.tmp", chemin);
+	FILE* f = fopen(temporaire, "wb");
+	int ok = f != NULL;
+	if (f) {
+		ok = fwrite(donnees, 1, longueur, f) == longueur && synchroniser(f);
+		ok = fclose(f) == 0 && ok;
+	}
+#ifdef _WIN32
+	ok = ok && MoveFileExA(temporaire, chemin, MOVEFILE_REPLACE_EXISTING);
+#else
+	ok = ok && rename(temporaire, chemin) == 0;
+#endif
+	if (!ok) remove(temporaire);
+	free(temporaire);
+	return ok;
+}
+
+static int creerJournal(const char* chemin, uint32_t generation) {
+	uint8_t entete[TAILLE_ENTETE_JOURNAL] = { 0 };
+	memcpy(entete, MAGIE_JOURNAL, sizeof(MAGIE_JOURNAL));
+	ecrire32(&entete[8], VERSION_JOURNAL);
+	ecrire32(&entete[12], generation);
+	return ecrireFichierDurable(chemin, entete, sizeof(entete));
+}
+
+/* seul un journal absent est recréé : un journal illisible garde les scores qu’il protège */
+static int fichierAbsent(const char* chemin) {
+	FILE* f = fopen(chemin, "rb");
+	if (f) {
+		fclose(f);
+		return 0;
+	}
+	return errno == ENOENT;
+}
+
+static int tronquerFichier(const char* chemin, long taille) {
+	FILE* f = fopen(chemin, "r+b");
+	if (!f) return 0;
+#ifdef _WIN32
+	int ok = _chsize_s(_fileno(f), taille) == 0;
+#else
+	int ok = ftruncate(fileno(f), (off_t)taille) == 0;
+#endif
+	fclose(f);
+	return ok;
+}
+
+static void attendreMs(Journal* j, int delai_ms) {
+	struct timespec limite;
+	timespec_get(&limite, TIME_UTC);
+	limite.tv_sec += delai_ms / 1000;
+	limite.tv_nsec += (long)(delai_ms % 1000) * 1000000L;
+	if (limite.tv_nsec >= 1000000000L) {
+		++limite.tv_sec;
+		limite.tv_nsec -= 1000000000L;
+	}
+	/* un réveil anticipé ne peut venir que de la fermeture */
+	while (!j->arret && cnd_timedwait(&j->signal, &j->verrou, &limite) == thrd_success) {}
+}
+
+static int boucleJournal(void* arg) {
+	Journal* j = (Journal*)arg;
+	Tampon lot;
+	/* après une écriture ratée, le fichier peut finir par un enregistrement partiel :
+	   rien n’est plus ajouté derrière, la relecture s’arrête juste avant */
+	int ecriture_ratee = 0;
+	nommerFilTrace("journal");
+	initTampon(&lot);
+
+	mtx_lock(&j->verrou);
+	for (;;) {
+		while (!j->arret && j->en_attente.taille == 0) {
+			cnd_wait(&j->signal, &j->verrou);
+		}
+		if (j->en_attente.taille == 0) break;
+		/* le premier événement du lot ouvre la fenêtre de regroupement */
+		if (!j->arret && j->intervalle_ms > 0) {
+			attendreMs(j, j->intervalle_ms);
+		}
+		Tampon plein = j->en_attente;
+		j->en_attente = lot;
+		mtx_unlock(&j->verrou);
+
+		debutTrace("ecriture journal");
+		int ok = !ecriture_ratee
+			&& fwrite(plein.donnees, 1, plein.taille, j->fichier) == plein.taille && synchroniser(j->fichier);
+		finTrace("ecriture journal");
+		if (!ok) ecriture_ratee = 1;
+		plein.taille = 0;
+		lot = plein;
+
+		mtx_lock(&j->verrou);
+		if (!ok) j->erreur = 1;
+		++j->nb_synchronisations;
+	}
+	mtx_unlock(&j->verrou);
+	detruireTampon(&lot);
+	return 0;
+}
+
+int ouvrirJournal(Journal* j, const char* chemin, int intervalle_ms) {
+	PositionJournal fin;
+	if (parcourirJournal(chemin, NULL, NULL, NULL, &fin) >= 0) {
+		if (!tronquerFichier(chemin, (long)fin.decalage)) return 0;
+	}
+	else {
+		if (!fichierAbsent(chemin) || !creerJournal(chemin, 0)) return 0;
+		fin.generation = 0;
+		fin.decalage = TAILLE_ENTETE_JOURNAL;
+	}
+	j->fichier = fopen(chemin, "ab");
+	if (!j->fichier) return 0;
+	j->fin = fin;
+
+	initTampon(&j->en_attente);
+	j->intervalle_ms = intervalle_ms;
+	j->arret = 0;
+	j->erreur = 0;
+	j->nb_evenements = 0;
+	j->nb_synchronisations = 0;
+	mtx_init(&j->verrou, mtx_plain);
+	cnd_init(&j->signal);
+	if (thrd_create(&j->fil, boucleJournal, j) != thrd_success) {
+		cnd_destroy(&j->signal);
+		mtx_destroy(&j->verrou);
+		fclose(j->fichier);
+		return 0;
+	}
+	return 1;
+}
+
+static void ajouterEvenement(Journal* j, uint8_t type, const uint8_t* donnees, size_t longueur) {
+	uint8_t tete[3] = { type, (uint8_t)longueur, (uint8_t)(longueur >> 8) };
+	uint8_t somme[4];
+	ecrire32(somme, sommeEvenement(type, donnees, longueur));
+
+	mtx_lock(&j->verrou);
+	size_t avant = j->en_attente.taille;
+	if (ajouterTampon(&j->en_attente, (const char*)tete, sizeof(tete))
+		&& ajouterTampon(&j->en_attente, (const char*)donnees, longueur)
+		&& ajouterTampon(&j->en_attente, (const char*)somme, sizeof(somme))) {
+		++j->nb_evenements;
+		j->fin.decalage += sizeof(tete) + longueur + sizeof(somme);
+	}
+	else {
+		/* un enregistrement partiel rendrait la suite du journal illisible */
+		j->en_attente.taille = avant;
+		j->erreur = 1;
+	}
+	mtx_unlock(&j->verrou);
+	if (avant == 0) cnd_signal(&j->signal);
+}
+
+void journaliserPoint(Journal* j, const char* nom, size_t longueur) {
+	if (longueur > LONGUEUR_MAX_EVENEMENT) {
+		mtx_lock(&j->verrou);
+		j->erreur = 1;
+		mtx_unlock(&j->verrou);
+		return;
+	}
+	ajouterEvenement(j, EVENEMENT_POINT, (const uint8_t*)nom, longueur);
+}
+
+void journaliserDonne(Journal* j, int carte, int cible) {
+	uint8_t donnees[8];
+	ecrire32(&donnees[0], (uint32_t)carte);
+	ecrire32(&donnees[4], (uint32_t)cible);
+	ajouterEvenement(j, EVENEMENT_DONNE, donnees, sizeof(donnees));
+}
+
+int fermerJournal(Journal* j) {
+	mtx_lock(&j->verrou);
+	j->arret = 1;
+	mtx_unlock(&j->verrou);
+	cnd_broadcast(&j->signal);
+	thrd_join(j->fil, NULL);
+
+	int ok = !j->erreur;
+	if (fclose(j->fichier) != 0) ok = 0;
+	j->fichier = NULL;
+	detruireTampon(&j->en_attente);
+	cnd_destroy(&j->signal);
+	mtx_destroy(&j->verrou);
+	return ok;
+}
+
+int renouvelerJournal(Journal* j, const char* chemin) {
+	uint32_t generation = j->fin.generation + 1;
+	int intervalle_ms = j->intervalle_ms;
+	if (!fermerJournal(j)) return 0;
+	return creerJournal(chemin, generation) && ouvrirJournal(j, chemin, intervalle_ms);
+}
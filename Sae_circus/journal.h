@@ -0,0 +1,160 @@
+/**
+ * @file journal.h
+ * @brief Journal binaire des points et des donnes, écrit par validations groupées.
+ *
+ * Chaque point marqué et chaque donne sont ajoutés en fin de journal. Le fil de
+ * la partie ne fait que copier l’événement dans un tampon en mémoire ; un fil
+ * d’écriture vide ce tampon au plus toutes les `intervalle_ms` millisecondes,
+ * en une écriture suivie d’une synchronisation (`fsync`) pour tout le lot. Au
+ * redémarrage, la relecture du journal reconstitue les scores et la donne en cours.
+ *
+ * Format : un en-tête de 16 octets (`"SAEJRNL"`, octet nul, version sur 4 octets,
+ * génération sur 4 octets), puis des enregistrements
+ * `type (1 octet) | longueur (2 octets) | données | somme (4 octets)`, les entiers
+ * en petit-boutiste. La somme (FNV-1a sur le type, la longueur et les données)
+ * détecte un enregistrement incomplet après un arrêt brutal : la relecture s’arrête
+ * au premier enregistrement invalide, et l’ouverture suivante tronque le journal
+ * à cet endroit.
+ *
+ * Un instantané de la partie (voir `instantane.h`) retient la position du journal
+ * qu’il contient déjà ; le journal est ensuite renouvelé avec la génération suivante.
+ * La relecture depuis cette position reste juste si l’arrêt survient entre les deux.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include "sortie.h"
+
+/** @brief Version du format du journal. */
+enum { VERSION_JOURNAL = 1 };
+
+/**
+ * @brief Types d’événements.
+ */
+typedef enum {
+    EVENEMENT_POINT = 1,  /**< Un point pour un joueur ; données : le nom du joueur. */
+    EVENEMENT_DONNE = 2   /**< Nouvelle donne ; données : indices des cartes de départ et cible (2 × 4 octets). */
+} TypeEvenement;
+
+/**
+ * @brief Fonction recevant les événements relus.
+ */
+typedef void (*LireEvenement)(void* contexte, int type, const uint8_t* donnees, size_t longueur);
+
+/**
+ * @brief Position dans un journal : génération du fichier et décalage en octets.
+ */
+typedef struct {
+    uint32_t generation;
+    uint64_t decalage;
+} PositionJournal;
+
+/**
+ * @brief Journal ouvert en ajout et son fil d’écriture.
+ */
+typedef struct {
+    FILE* fichier;
+    thrd_t fil;
+    mtx_t verrou;                 /**< Protège `en_attente`, `arret` et les compteurs. */
+    cnd_t signal;                 /**< Signalé à l’arrivée du premier événement d’un lot et à la fermeture. */
+    Tampon en_attente;            /**< Événements pas encore écrits. */
+    int intervalle_ms;            /**< Durée maximale d’accumulation d’un lot. */
+    PositionJournal fin;          /**< Position qui suit le dernier événement journalisé (écrit ou en attente). */
+    int arret;
+    int erreur;                   /**< `1` si une écriture ou une synchronisation a échoué (après une écriture ratée, plus rien n’est écrit). */
+    uint64_t nb_evenements;       /**< Événements journalisés. */
+    uint64_t nb_synchronisations; /**< Lots écrits et synchronisés. */
+} Journal;
+
+/**
+ * @brief Écrit un fichier complet sous un nom temporaire, le synchronise puis le renomme.
+ *
+ * Un lecteur voit l’ancien contenu ou le nouveau, jamais un fichier partiel, même après un arrêt brutal.
+ *
+ * @param[in] chemin Fichier à remplacer.
+ * @param[in] donnees Contenu.
+ * @param[in] longueur Taille du contenu.
+ * @return `1` si l’écriture réussit, `0` sinon.
+ */
+int ecrireFichierDurable(const char* chemin, const void* donnees, size_t longueur);
+
+/**
+ * @brief Relit un journal.
+ *
+ * @param[in] chemin Fichier du journal.
+ * @param[in] lire Fonction appelée pour chaque événement valide, dans l’ordre.
+ * @param[in] contexte Contexte transmis à `lire`.
+ * @return Le nombre d’événements relus, ou `-1` si le fichier est absent ou n’est pas un journal.
+ */
+int64_t lireJournal(const char* chemin, LireEvenement lire, void* contexte);
+
+/**
+ * @brief Relit les événements d’un journal postérieurs à une position.
+ *
+ * Si le fichier est de la génération suivant celle de la position, il a été
+ * renouvelé après la position : il est relu en entier.
+ *
+ * @param[in] chemin Fichier du journal.
+ * @param[in] depuis Position à partir de laquelle relire.
+ * @param[in] lire Fonction appelée pour chaque événement valide, dans l’ordre.
+ * @param[in] contexte Contexte transmis à `lire`.
+ * @return Le nombre d’événements relus, ou `-1` si le fichier est absent, n’est pas un
+ *         journal ou ne prolonge pas la position.
+ */
+int64_t lireJournalDepuis(const char* chemin, const PositionJournal* depuis, LireEvenement lire, void* contexte);
+
+/**
+ * @brief Ouvre (ou crée) un journal en ajout et démarre son fil d’écriture.
+ *
+ * Un enregistrement incomplet en fin de fichier est supprimé. Seul un fichier absent
+ * est remplacé par un journal vide : un fichier illisible (erreur de lecture, manque
+ * de mémoire, autre format) fait échouer l’ouverture sans être modifié.
+ *
+ * @param[out] j Journal.
+ * @param[in] chemin Fichier du journal.
+ * @param[in] intervalle_ms Durée maximale d’accumulation d’un lot avant écriture et synchronisation.
+ * @return `1` si l’ouverture réussit, `0` sinon (rien n’est alors à libérer).
+ */
+int ouvrirJournal(Journal* j, const char* chemin, int intervalle_ms);
+
+/**
+ * @brief Ferme le journal puis le remplace par un journal vide de la génération suivante.
+ *
+ * À n’appeler qu’une fois la position `j->fin` conservée ailleurs (instantané écrit).
+ *
+ * @param[in,out] j Journal ouvert ; en cas d’échec, il est fermé.
+ * @param[in] chemin Fichier du journal.
+ * @return `1` si le journal est rouvert, `0` sinon.
+ */
+int renouvelerJournal(Journal* j, const char* chemin);
+
+/**
+ * @brief Journalise un point ; l’appel ne bloque que le temps de copier l’événement.
+ *
+ * @param[in,out] j Journal.
+ * @param[in] nom Nom du joueur.
+ * @param[in] longueur Longueur du nom (au plus 65535 octets).
+ */
+void journaliserPoint(Journal* j, const char* nom, size_t longueur);
+
+/**
+ * @brief Journalise une donne ; l’appel ne bloque que le temps de copier l’événement.
+ *
+ * @param[in,out] j Journal.
+ * @param[in] carte Indice de la carte de départ.
+ * @param[in] cible Indice de la carte cible.
+ */
+void journaliserDonne(Journal* j, int carte, int cible);
+
+/**
+ * @brief Écrit et synchronise les événements en attente, arrête le fil et ferme le journal.
+ *
+ * @param[in,out] j Journal ouvert.
+ * @return `1` si toutes les écritures ont réussi, `0` sinon.
+ */
+int fermerJournal(Journal* j);
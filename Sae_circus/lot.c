@@ -0,0 +1,157 @@
+#include "lot.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+/* nombre de voies traitées ensemble (multiple de 4) */
+enum { LARGEUR_BLOC = 64 };
+
+/* code des voies inactives (séquence terminée ou en échec) */
+enum { OP_AUCUNE = NB_OPS };
+
+typedef struct {
+	uint64_t cle[LARGEUR_BLOC];    /* situation de chaque voie */
+	uint64_t op[LARGEUR_BLOC];     /* commande du pas courant */
+	int64_t echec[LARGEUR_BLOC];   /* indice de la commande impossible, -1 sinon */
+} Voies;
+
+#if defined(__AVX2__)
+
+static void etapeVoies(Voies* v, int nb_voies, int n, int64_t t) {
+	const __m256i un = _mm256_set1_epi64x(1);
+	const __m256i quartet = _mm256_set1_epi64x(0xF);
+	const __m256i zero = _mm256_setzero_si256();
+	const __m256i nv = _mm256_set1_epi64x(n);
+	const __m256i nm1 = _mm256_set1_epi64x(4 * (n - 1));
+
+	for (int i = 0; i < nb_voies; i += 4) {
+		__m256i cle = _mm256_loadu_si256((const __m256i*)&v->cle[i]);
+		__m256i op = _mm256_loadu_si256((const __m256i*)&v->op[i]);
+		__m256i split = _mm256_and_si256(cle, quartet);
+		__m256i perm = _mm256_srli_epi64(cle, 4);
+
+		__m256i ki = _mm256_cmpeq_epi64(op, _mm256_set1_epi64x(OP_KI));
+		__m256i lo = _mm256_cmpeq_epi64(op, _mm256_set1_epi64x(OP_LO));
+		__m256i so = _mm256_cmpeq_epi64(op, _mm256_set1_epi64x(OP_SO));
+		__m256i ni = _mm256_cmpeq_epi64(op, _mm256_set1_epi64x(OP_NI));
+		__m256i ma = _mm256_cmpeq_epi64(op, _mm256_set1_epi64x(OP_MA));
+
+		/* KI, SO et NI demandent un Bleu non vide ; LO, SO et MA un Rouge non vide */
+		__m256i bleu_vide = _mm256_cmpeq_epi64(split, zero);
+		__m256i rouge_vide = _mm256_cmpeq_epi64(split, nv);
+		__m256i echoue = _mm256_or_si256(
+			_mm256_and_si256(_mm256_or_si256(_mm256_or_si256(ki, so), ni), bleu_vide),
+			_mm256_and_si256(_mm256_or_si256(_mm256_or_si256(lo, so), ma), rouge_vide));
+
+		/* segment [a, b) : KI [split-1, n), LO et MA [split, n), NI [0, split) */
+		__m256i sm1 = _mm256_sub_epi64(split, un);
+		__m256i a = _mm256_or_si256(_mm256_and_si256(ki, sm1),
+			_mm256_andnot_si256(_mm256_or_si256(ki, ni), split));
+		__m256i b = _mm256_or_si256(_mm256_and_si256(ni, split), _mm256_andnot_si256(ni, nv));
+		__m256i a4 = _mm256_slli_epi64(a, 2);
+		__m256i b4 = _mm256_slli_epi64(b, 2);
+		__m256i bm4 = _mm256_sub_epi64(b4, _mm256_set1_epi64x(4));
+		__m256i m = _mm256_xor_si256(_mm256_sub_epi64(_mm256_sllv_epi64(un, b4), un),
+			_mm256_sub_epi64(_mm256_sllv_epi64(un, a4), un));
+		__m256i hors = _mm256_andnot_si256(m, perm);
+		__m256i dedans = _mm256_and_si256(m, perm);
+
+		__m256i premier = _mm256_and_si256(_mm256_srlv_epi64(perm, a4), quartet);
+		__m256i gauche = _mm256_or_si256(_mm256_or_si256(hors,
+			_mm256_and_si256(_mm256_srli_epi64(dedans, 4), m)), _mm256_sllv_epi64(premier, bm4));
+
+		__m256i dernier = _mm256_and_si256(_mm256_srlv_epi64(perm, bm4), quartet);
+		__m256i droite = _mm256_or_si256(_mm256_or_si256(hors,
+			_mm256_and_si256(_mm256_slli_epi64(dedans, 4), m)), _mm256_sllv_epi64(dernier, a4));
+
+		/* SO : échange des quartets split-1 et n-1 */
+		__m256i i4 = _mm256_slli_epi64(sm1, 2);
+		__m256i vi = _mm256_and_si256(_mm256_srlv_epi64(perm, i4), quartet);
+		__m256i vj = _mm256_and_si256(_mm256_srlv_epi64(perm, nm1), quartet);
+		__m256i efface = _mm256_or_si256(_mm256_sllv_epi64(quartet, i4), _mm256_sllv_epi64(quartet, nm1));
+		__m256i echange = _mm256_or_si256(_mm256_andnot_si256(efface, perm),
+			_mm256_or_si256(_mm256_sllv_epi64(vi, nm1), _mm256_sllv_epi64(vj, i4)));
+
+		__m256i nouveau = _mm256_blendv_epi8(perm, gauche, _mm256_or_si256(_mm256_or_si256(ki, ni), ma));
+		nouveau = _mm256_blendv_epi8(nouveau, droite, lo);
+		nouveau = _mm256_blendv_epi8(nouveau, echange, so);
+		__m256i nouveau_split = _mm256_add_epi64(_mm256_sub_epi64(split, lo), ki);
+		__m256i resultat = _mm256_or_si256(_mm256_slli_epi64(nouveau, 4), nouveau_split);
+
+		_mm256_storeu_si256((__m256i*)&v->cle[i], _mm256_blendv_epi8(resultat, cle, echoue));
+
+		int masque = _mm256_movemask_pd(_mm256_castsi256_pd(echoue));
+		for (int k = 0; masque; ++k, masque >>= 1) {
+			if (masque & 1) v->echec[i + k] = t;
+		}
+	}
+}
+
+const char* instructionsLot(void) {
+	return "avx2";
+}
+
+#else
+
+static void etapeVoies(Voies* v, int nb_voies, int n, int64_t t) {
+	for (int i = 0; i < nb_voies; ++i) {
+		if (v->op[i] == OP_AUCUNE) continue;
+		if (!appliquerCommandeCle(&v->cle[i], n, (int)v->op[i])) {
+			v->echec[i] = t;
+		}
+	}
+}
+
+const char* instructionsLot(void) {
+	return "scalaire";
+}
+
+#endif
+
+static void evaluerBloc(const Game* game, CleEtat depart, int n, const Sequence* sequences, int nb_voies,
+	ResultatSequence* resultats) {
+	Voies v;
+	/* les voies au-delà de nb_voies complètent le dernier groupe de 4 sans rien faire */
+	int nb_groupes = (nb_voies + 3) & ~3;
+	int64_t longueur = 0;
+	for (int i = 0; i < nb_groupes; ++i) {
+		v.cle[i] = depart;
+		v.op[i] = OP_AUCUNE;
+		v.echec[i] = -1;
+		if (i < nb_voies && sequences[i].nbElements > longueur) {
+			longueur = sequences[i].nbElements;
+		}
+	}
+
+	for (int64_t t = 0; t < longueur; ++t) {
+		int actives = 0;
+		for (int i = 0; i < nb_voies; ++i) {
+			int active = v.echec[i] < 0 && t < sequences[i].nbElements;
+			v.op[i] = active ? sequences[i].elements[t] : OP_AUCUNE;
+			actives += active;
+		}
+		if (actives == 0) break;
+		etapeVoies(&v, nb_groupes, n, t);
+	}
+
+	for (int i = 0; i < nb_voies; ++i) {
+		resultats[i].echec = v.echec[i];
+		resultats[i].finale = v.cle[i];
+		resultats[i].reussite = v.echec[i] < 0 && v.cle[i] == game->cle_cible;
+	}
+}
+
+int evaluerLot(const Game* game, const Sequence* sequences, int64_t nb, ResultatSequence* resultats) {
+	int n = (int)game->animaux->nbElements;
+	CleEtat depart = empaqueterPodiums(game->podium_b, game->podium_r);
+	if (depart == CLE_INVALIDE || game->cle_cible == CLE_INVALIDE) {
+		return 0;
+	}
+
+	for (int64_t debut = 0; debut < nb; debut += LARGEUR_BLOC) {
+		int nb_voies = (int)(nb - debut < LARGEUR_BLOC ? nb - debut : LARGEUR_BLOC);
+		evaluerBloc(game, depart, n, sequences + debut, nb_voies, resultats + debut);
+	}
+	return 1;
+}
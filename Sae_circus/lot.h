@@ -0,0 +1,47 @@
+/**
+ * @file lot.h
+ * @brief Évaluation par lots de séquences de commandes compilées.
+ *
+ * Les robots et les outils d’analyse évaluent des milliers de séquences à partir
+ * de la même situation. Les séquences sont traitées par blocs de voies rangées
+ * en structure de tableaux (une voie par séquence) : à chaque pas, la commande
+ * de chaque voie est appliquée à sa situation empaquetée sans branchement, ce
+ * qui permet de traiter quatre voies par instruction AVX2. Les décalages
+ * variables par voie sur 64 bits n’existant pas en SSE, une version scalaire
+ * est utilisée quand AVX2 n’est pas activé à la compilation.
+ */
+
+#pragma once
+
+#include "game.h"
+
+/**
+ * @brief Résultat de l’évaluation d’une séquence.
+ */
+typedef struct {
+    int64_t echec;   /**< Indice de la première commande impossible, ou `-1`. */
+    CleEtat finale;  /**< Situation atteinte (avant la commande impossible, le cas échéant). */
+    int reussite;    /**< `1` si la séquence s’exécute entièrement et mène à la situation cible. */
+} ResultatSequence;
+
+/**
+ * @brief Évalue un lot de séquences à partir de la situation courante d’une partie.
+ *
+ * Le résultat de chaque séquence est celui qu’aurait donné `executerLigneCommandes`
+ * sur une copie des podiums de la partie.
+ *
+ * @param[in] game Partie (situation courante et situation cible).
+ * @param[in] sequences Séquences compilées (voir `compilerSequence`).
+ * @param[in] nb Nombre de séquences.
+ * @param[out] resultats Tableau d’au moins `nb` résultats.
+ * @return `1` si l’évaluation réussit, `0` si la configuration compte plus de
+ *         `MAX_ANIMAUX_CLE` animaux.
+ */
+int evaluerLot(const Game* game, const Sequence* sequences, int64_t nb, ResultatSequence* resultats);
+
+/**
+ * @brief Indique le jeu d’instructions utilisé par `evaluerLot`.
+ *
+ * @return `"avx2"` ou `"scalaire"`.
+ */
+const char* instructionsLot(void);
@@ -1,10 +1,87 @@
-﻿#include "game.h"
+﻿#include "reseau.h"
+#include "simulation.h"
+#include "solveur.h"
+#include "trace.h"
 
 
+//static const char* chemin_trace = NULL;
+//
+///* la trace est écrite à la sortie, quand les threads tracés sont arrêtés */
+//static void ecrireTraceSortie(void) {
+//	ecrireTrace(chemin_trace);
+//	arreterTrace();
+//}
+//
 //int main(int argc, char** argv) {
 //	
+//	if (argc >= 3 && strcmp(argv[1], "--trace") == 0) {
+//		chemin_trace = argv[2];
+//		argv += 2;
+//		argc -= 2;
+//		demarrerTrace(CAPACITE_TRACE_DEFAUT);
+//		atexit(ecrireTraceSortie);
+//	}
+//	
+//	if (argc >= 2 && strcmp(argv[1], "--serveur") == 0) {
+//		int nb_travailleurs = argc >= 3 ? atoi(argv[2]) : 4;
+//		int delai_ms = argc >= 4 ? atoi(argv[3]) : 0;
+//		return lancerServeur("crazy.cfg", nb_travailleurs, delai_ms, stdin);
+//	}
+//	if (argc >= 3 && strcmp(argv[1], "--reseau") == 0) {
+//		int nb_travailleurs = argc >= 4 ? atoi(argv[3]) : 4;
+//		int delai_ms = argc >= 5 ? atoi(argv[4]) : 0;
+//		return lancerReseau(argv[2], "crazy.cfg", nb_travailleurs, delai_ms);
+//	}
+//	if (argc >= 5 && strcmp(argv[1], "--charge") == 0) {
+//		return chargeReseau(argv[2], atoi(argv[3]), atoi(argv[4]));
+//	}
+//	if (argc >= 5 && strcmp(argv[1], "--simuler") == 0) {
+//		/* --simuler nb_fils nb_tours niveau... */
+//		ParametresSimulation parametres = { atoi(argv[2]), atoll(argv[3]), 100, 0, { 0 }, graineHorloge() };
+//		for (int i = 4; i < argc && parametres.nb_strategies < MAX_STRATEGIES; ++i) {
+//			parametres.niveaux[parametres.nb_strategies++] = atoi(argv[i]);
+//		}
+//		return lancerSimulation("crazy.cfg", &parametres);
+//	}
+//	if (argc >= 2 && strcmp(argv[1], "--resoudre") == 0) {
+//		/* --resoudre [nb_fils] : requetes JSONL sur l'entree standard, reponses sur la sortie standard */
+//		ParametresSolveur parametres = { argc >= 3 ? atoi(argv[2]) : 4, 0 };
+//		return lancerSolveur("crazy.cfg", &parametres);
+//	}
+//	
+//	int delai_ms = 0;
+//	if (argc >= 3 && strcmp(argv[1], "--delai") == 0) {
+//		delai_ms = atoi(argv[2]);
+//		argv += 2;
+//		argc -= 2;
+//	}
+//	int avec_latences = 0;
+//	if (argc >= 2 && strcmp(argv[1], "--latences") == 0) {
+//		avec_latences = 1;
+//		++argv;
+//		--argc;
+//	}
+//	int avec_memoire = 0;
+//	if (argc >= 2 && strcmp(argv[1], "--memoire") == 0) {
+//		avec_memoire = 1;
+//		++argv;
+//		--argc;
+//	}
+//	const char* chemin_analyses = NULL;
+//	if (argc >= 3 && strcmp(argv[1], "--analyses") == 0) {
+//		chemin_analyses = argv[2];
+//		argv += 2;
+//		argc -= 2;
+//	}
+//	const char* chemin_journal = NULL;
+//	if (argc >= 3 && strcmp(argv[1], "--journal") == 0) {
+//		chemin_journal = argv[2];
+//		argv += 2;
+//		argc -= 2;
+//	}
+//	
 //	if (argc < 3) {
-//		pasAssesDesJoueurs();
+//		pasAssesDesJoueurs(sortieStandard());
 //		return -1;
 //	}
 //	
@@ -17,7 +94,39 @@
 //		printf("Changez des parametres du jeu\n");
 //		return -1;
 //	}
+//	game.delai_ms = delai_ms;
+//	if (avec_latences) {
+//		activerMesures(&game);
+//	}
+//	
+//	Journal journal;
+//	if (chemin_journal) {
+//		reprendreJournal(&game, chemin_journal, NULL);
+//		if (ouvrirJournal(&journal, chemin_journal, 50)) {
+//			game.journal = &journal;
+//		}
+//	}
+//	
+//	Analyses analyses;
+//	if (chemin_analyses && ouvrirAnalyses(&analyses, chemin_analyses, CAPACITE_ANALYSES_DEFAUT)) {
+//		attacherAnalyses(&game, &analyses, 0);
+//	}
 //	
 //	gameLoop(&game);
+//	if (game.analyses) {
+//		game.analyses = NULL;
+//		fermerAnalyses(&analyses);
+//		if (analyses.nb_perdus > 0) {
+//			printf("%llu bilans de tours perdus\n", (unsigned long long)analyses.nb_perdus);
+//		}
+//	}
+//	if (game.journal) {
+//		game.journal = NULL;
+//		fermerJournal(&journal);
+//	}
+//	detruireGame(&game);
+//	if (avec_memoire) {
+//		afficherMemoire(sortieStandard());
+//	}
 //	
 //}
\ No newline at end of file
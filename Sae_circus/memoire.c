@@ -0,0 +1,66 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#include "memoire.h"
+
+
+typedef struct {
+	atomic_int_fast64_t vivants;
+	atomic_int_fast64_t pic;
+	atomic_int_fast64_t nb_allocations;
+} CompteursMemoire;
+
+static CompteursMemoire compteurs[NB_SOUS_SYSTEMES];
+
+static const char* const noms_sous_systemes[NB_SOUS_SYSTEMES] = {
+	"autre", "paquet", "podiums", "joueurs", "config", "tables", "arenes"
+};
+
+
+void compterAllocation(SousSysteme s, size_t octets) {
+	CompteursMemoire* c = &compteurs[s];
+	atomic_fetch_add_explicit(&c->nb_allocations, 1, memory_order_relaxed);
+	int_fast64_t vivants = atomic_fetch_add_explicit(&c->vivants, (int_fast64_t)octets, memory_order_relaxed)
+		+ (int_fast64_t)octets;
+	int_fast64_t pic = atomic_load_explicit(&c->pic, memory_order_relaxed);
+	while (vivants > pic
+		&& !atomic_compare_exchange_weak_explicit(&c->pic, &pic, vivants, memory_order_relaxed, memory_order_relaxed)) {
+	}
+}
+
+void compterLiberation(SousSysteme s, size_t octets) {
+	atomic_fetch_sub_explicit(&compteurs[s].vivants, (int_fast64_t)octets, memory_order_relaxed);
+}
+
+void* allouerMemoire(SousSysteme s, size_t taille) {
+	void* p = malloc(taille);
+	if (p) compterAllocation(s, taille);
+	return p;
+}
+
+void* reallouerMemoire(SousSysteme s, void* p, size_t ancienne, size_t nouvelle) {
+	void* q = realloc(p, nouvelle);
+	if (!q) return NULL;
+	/* l’ancienne zone est rendue avant que la nouvelle soit comptée : le pic ne les additionne pas */
+	if (p) compterLiberation(s, ancienne);
+	compterAllocation(s, nouvelle);
+	return q;
+}
+
+void libererMemoire(SousSysteme s, void* p, size_t taille) {
+	if (!p) return;
+	free(p);
+	compterLiberation(s, taille);
+}
+
+BilanMemoire bilanMemoire(SousSysteme s) {
+	BilanMemoire b;
+	b.vivants = atomic_load_explicit(&compteurs[s].vivants, memory_order_relaxed);
+	b.pic = atomic_load_explicit(&compteurs[s].pic, memory_order_relaxed);
+	b.nb_allocations = atomic_load_explicit(&compteurs[s].nb_allocations, memory_order_relaxed);
+	return b;
+}
+
+const char* nomSousSysteme(SousSysteme s) {
+	return s >= 0 && s < NB_SOUS_SYSTEMES ? noms_sous_systemes[s] : "?";
+}
@@ -0,0 +1,105 @@
+/**
+ * @file memoire.h
+ * @brief Comptabilité de la mémoire par sous-système (paquet, podiums, joueurs, configuration, tables).
+ *
+ * Chaque sous-système tient trois compteurs : les octets vivants, le pic atteint
+ * par ces octets et le nombre d’allocations. Les compteurs sont atomiques : les
+ * travailleurs du serveur, les robots et la prédistribution les mettent à jour
+ * sans verrou. Seules les croissances et libérations de blocs sont comptées, pas
+ * les accès.
+ *
+ * Les vecteurs typés (`vecteurtype.h`) et les arènes (`arene.h`) portent le
+ * sous-système auquel ils sont comptés ; les autres allocations passent par
+ * `allouerMemoire` / `libererMemoire`, qui demandent la taille de la zone à sa
+ * libération (il n’y a pas d’en-tête caché). Les tampons temporaires (lecture
+ * d’une ligne, découpage) ne sont pas comptés.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Sous-systèmes comptés.
+ */
+typedef enum {
+    MEMOIRE_AUTRE,     /**< Vecteurs typés sans sous-système (séquences, chaînes compilées…). */
+    MEMOIRE_PAQUET,    /**< Cartes générées ou fichier de paquet projeté. */
+    MEMOIRE_PODIUMS,   /**< Podiums d’une partie et leurs copies. */
+    MEMOIRE_JOUEURS,   /**< Joueurs et leurs noms. */
+    MEMOIRE_CONFIG,    /**< Animaux, commandes et leurs noms. */
+    MEMOIRE_TABLES,    /**< Tables de distances et cache des compositions. */
+    MEMOIRE_ARENES,    /**< Blocs d’arène pas encore distribués (et leurs en-têtes). */
+    NB_SOUS_SYSTEMES
+} SousSysteme;
+
+/**
+ * @brief Compteurs d’un sous-système.
+ */
+typedef struct {
+    int64_t vivants;         /**< Octets alloués et pas encore libérés. */
+    int64_t pic;             /**< Maximum atteint par `vivants`. */
+    int64_t nb_allocations;  /**< Nombre d’allocations (un agrandissement en est une). */
+} BilanMemoire;
+
+/**
+ * @brief Compte une allocation.
+ *
+ * @param[in] s Sous-système.
+ * @param[in] octets Taille de la zone allouée.
+ */
+void compterAllocation(SousSysteme s, size_t octets);
+
+/**
+ * @brief Compte une libération.
+ *
+ * @param[in] s Sous-système (celui de l’allocation).
+ * @param[in] octets Taille de la zone libérée.
+ */
+void compterLiberation(SousSysteme s, size_t octets);
+
+/**
+ * @brief `malloc` compté.
+ *
+ * @param[in] s Sous-système.
+ * @param[in] taille Nombre d’octets.
+ * @return La zone, ou `NULL` en cas de manque de mémoire (rien n’est alors compté).
+ */
+void* allouerMemoire(SousSysteme s, size_t taille);
+
+/**
+ * @brief `realloc` compté.
+ *
+ * @param[in] s Sous-système.
+ * @param[in] p Zone à agrandir ou réduire, ou `NULL`.
+ * @param[in] ancienne Taille actuelle de `p` (`0` si `p` est `NULL`).
+ * @param[in] nouvelle Nouvelle taille.
+ * @return La zone, ou `NULL` en cas de manque de mémoire (`p` reste alors valide et compté).
+ */
+void* reallouerMemoire(SousSysteme s, void* p, size_t ancienne, size_t nouvelle);
+
+/**
+ * @brief `free` compté.
+ *
+ * @param[in] s Sous-système de l’allocation.
+ * @param[in] p Zone, ou `NULL`.
+ * @param[in] taille Taille de la zone.
+ */
+void libererMemoire(SousSysteme s, void* p, size_t taille);
+
+/**
+ * @brief Lit les compteurs d’un sous-système.
+ *
+ * @param[in] s Sous-système.
+ * @return Ses compteurs (chacun lu atomiquement).
+ */
+BilanMemoire bilanMemoire(SousSysteme s);
+
+/**
+ * @brief Nom d’un sous-système.
+ *
+ * @param[in] s Sous-système.
+ * @return Un nom court (« paquet », « podiums »…).
+ */
+const char* nomSousSysteme(SousSysteme s);
@@ -0,0 +1,143 @@
+#include <stddef.h>
+
+#include "minuterie.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+
+uint64_t maintenantMs(void) {
+#ifdef _WIN32
+	return (uint64_t)GetTickCount64();
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000 + (uint64_t)ts.tv_nsec / 1000000;
+#endif
+}
+
+uint64_t maintenantNs(void) {
+#ifdef _WIN32
+	static LARGE_INTEGER frequence;
+	LARGE_INTEGER compteur;
+	if (frequence.QuadPart == 0) QueryPerformanceFrequency(&frequence);
+	QueryPerformanceCounter(&compteur);
+	/* en deux temps pour ne pas déborder */
+	uint64_t secondes = (uint64_t)(compteur.QuadPart / frequence.QuadPart);
+	uint64_t reste = (uint64_t)(compteur.QuadPart % frequence.QuadPart);
+	return secondes * 1000000000ULL + reste * 1000000000ULL / (uint64_t)frequence.QuadPart;
+#else
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+void initRoue(RoueMinuterie* roue, uint64_t resolution, uint64_t maintenant) {
+	for (int i = 0; i < NB_CRANS; ++i) {
+		roue->crans[i] = NULL;
+	}
+	roue->resolution = resolution;
+	roue->courant = maintenant / resolution;
+	roue->nb_armees = 0;
+}
+
+void initEcheance(Echeance* e, void (*rappel)(void*), void* contexte) {
+	e->expiration = 0;
+	e->suivant = NULL;
+	e->precedent = NULL;
+	e->armee = 0;
+	e->cran = 0;
+	e->rappel = rappel;
+	e->contexte = contexte;
+}
+
+static int cranDe(const RoueMinuterie* roue, uint64_t expiration) {
+	uint64_t cran = expiration / roue->resolution;
+	/* une échéance déjà dépassée est traitée au prochain avancement */
+	if (cran <= roue->courant) cran = roue->courant + 1;
+	return (int)(cran % NB_CRANS);
+}
+
+void annulerEcheance(RoueMinuterie* roue, Echeance* e) {
+	if (!e->armee) return;
+	if (e->suivant) e->suivant->precedent = e->precedent;
+	if (e->precedent) {
+		e->precedent->suivant = e->suivant;
+	}
+	else {
+		roue->crans[e->cran] = e->suivant;
+	}
+	e->suivant = NULL;
+	e->precedent = NULL;
+	e->armee = 0;
+	--roue->nb_armees;
+}
+
+void armerEcheance(RoueMinuterie* roue, Echeance* e, uint64_t expiration) {
+	annulerEcheance(roue, e);
+	e->cran = cranDe(roue, expiration);
+	Echeance** tete = &roue->crans[e->cran];
+	e->expiration = expiration;
+	e->precedent = NULL;
+	e->suivant = *tete;
+	if (*tete) (*tete)->precedent = e;
+	*tete = e;
+	e->armee = 1;
+	++roue->nb_armees;
+}
+
+int avancerRoue(RoueMinuterie* roue, uint64_t maintenant) {
+	uint64_t cible = maintenant / roue->resolution;
+	Echeance* expirees = NULL;
+	int nb = 0;
+
+	/* le cran courant est revisité : ses échéances pas encore dépassées lors du dernier
+	   avancement y sont restées ; au-delà d’un tour complet, chaque cran n’est visité qu’une fois */
+	uint64_t debut = roue->courant;
+	if (cible >= debut + NB_CRANS) debut = cible - NB_CRANS + 1;
+
+	for (uint64_t cran = debut; cran <= cible && roue->nb_armees > 0; ++cran) {
+		Echeance* e = roue->crans[cran % NB_CRANS];
+		while (e) {
+			Echeance* suivant = e->suivant;
+			if (e->expiration <= maintenant) {
+				annulerEcheance(roue, e);
+				e->suivant = expirees;
+				expirees = e;
+			}
+			e = suivant;
+		}
+	}
+	if (cible > roue->courant) roue->courant = cible;
+
+	/* les rappels sont appelés après la collecte : ils peuvent réarmer sans perturber le parcours */
+	while (expirees) {
+		Echeance* suivant = expirees->suivant;
+		expirees->suivant = NULL;
+		expirees->rappel(expirees->contexte);
+		expirees = suivant;
+		++nb;
+	}
+	return nb;
+}
+
+int64_t delaiRoue(const RoueMinuterie* roue, uint64_t maintenant) {
+	if (roue->nb_armees == 0) return -1;
+
+	uint64_t plus_tot = UINT64_MAX;
+	for (uint64_t k = 0; k < NB_CRANS; ++k) {
+		uint64_t cran = roue->courant + k;
+		uint64_t fin_cran = (cran + 1) * roue->resolution;
+		for (const Echeance* e = roue->crans[cran % NB_CRANS]; e; e = e->suivant) {
+			if (e->expiration < plus_tot) plus_tot = e->expiration;
+		}
+		/* toute échéance d’un cran plus lointain expire après la fin de celui-ci */
+		if (plus_tot < fin_cran) break;
+	}
+
+	return plus_tot <= maintenant ? 0 : (int64_t)(plus_tot - maintenant);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file minuterie.h
+ * @brief Horloge monotone et roue de minuterie pour les échéances des tours.
+ *
+ * La roue répartit les échéances dans `NB_CRANS` listes selon leur date
+ * d’expiration (en millisecondes, divisée par la résolution). Armer ou annuler
+ * une échéance est en O(1) ; faire avancer la roue ne visite que les crans
+ * écoulés. Une roue n’est pas protégée : elle appartient à un seul thread
+ * (la boucle de jeu ou un travailleur du serveur).
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+enum { NB_CRANS = 256 };
+
+/**
+ * @brief Échéance armée dans une roue (à intégrer dans la structure concernée).
+ */
+typedef struct Echeance {
+    uint64_t expiration;             /**< Date d’expiration (ms, horloge monotone). */
+    struct Echeance* suivant;
+    struct Echeance* precedent;
+    int armee;                       /**< `1` si l’échéance est dans une roue. */
+    int cran;                        /**< Indice du cran qui la contient. */
+    void (*rappel)(void* contexte);  /**< Appelée à l’expiration. */
+    void* contexte;                  /**< Contexte transmis à `rappel`. */
+} Echeance;
+
+/**
+ * @brief Roue de minuterie.
+ */
+typedef struct {
+    Echeance* crans[NB_CRANS]; /**< Listes doublement chaînées d’échéances. */
+    uint64_t resolution;       /**< Durée d’un cran (ms). */
+    uint64_t courant;          /**< Numéro absolu du dernier cran atteint (ses échéances non dépassées y restent). */
+    int nb_armees;             /**< Nombre d’échéances armées. */
+} RoueMinuterie;
+
+/**
+ * @brief Retourne l’heure d’une horloge monotone, en millisecondes.
+ *
+ * @return Un instant croissant, sans origine particulière.
+ */
+uint64_t maintenantMs(void);
+
+/**
+ * @brief Retourne l’heure de la même horloge monotone, en nanosecondes, pour les mesures de latence.
+ *
+ * @return Un instant croissant, sans origine particulière.
+ */
+uint64_t maintenantNs(void);
+
+/**
+ * @brief Initialise une roue vide.
+ *
+ * @param[out] roue Roue à initialiser.
+ * @param[in] resolution Durée d’un cran (ms).
+ * @param[in] maintenant Heure courante (ms).
+ * @pre `resolution >= 1`.
+ */
+void initRoue(RoueMinuterie* roue, uint64_t resolution, uint64_t maintenant);
+
+/**
+ * @brief Initialise une échéance non armée.
+ *
+ * @param[out] e Échéance.
+ * @param[in] rappel Fonction appelée à l’expiration.
+ * @param[in] contexte Contexte transmis à `rappel`.
+ */
+void initEcheance(Echeance* e, void (*rappel)(void*), void* contexte);
+
+/**
+ * @brief Arme (ou réarme) une échéance pour une date donnée.
+ *
+ * @param[in,out] roue Roue.
+ * @param[in,out] e Échéance, retirée de sa position précédente si elle était armée.
+ * @param[in] expiration Date d’expiration (ms).
+ */
+void armerEcheance(RoueMinuterie* roue, Echeance* e, uint64_t expiration);
+
+/**
+ * @brief Désarme une échéance (sans effet si elle ne l’est pas).
+ *
+ * @param[in,out] roue Roue.
+ * @param[in,out] e Échéance.
+ */
+void annulerEcheance(RoueMinuterie* roue, Echeance* e);
+
+/**
+ * @brief Fait avancer la roue et appelle le rappel des échéances expirées.
+ *
+ * Un rappel peut réarmer son échéance ou en armer d’autres.
+ *
+ * @param[in,out] roue Roue.
+ * @param[in] maintenant Heure courante (ms).
+ * @return Le nombre d’échéances expirées.
+ */
+int avancerRoue(RoueMinuterie* roue, uint64_t maintenant);
+
+/**
+ * @brief Retourne le délai avant la prochaine expiration.
+ *
+ * @param[in] roue Roue.
+ * @param[in] maintenant Heure courante (ms).
+ * @return Le délai en millisecondes (`0` si une échéance est déjà dépassée),
+ *         ou `-1` si aucune échéance n’est armée.
+ */
+int64_t delaiRoue(const RoueMinuterie* roue, uint64_t maintenant);
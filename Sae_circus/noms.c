@@ -0,0 +1,68 @@
+#include <string.h>
+
+#include "noms.h"
+
+
+uint32_t hacherNom(const char* texte, size_t longueur) {
+	uint32_t h = 2166136261u;
+	for (size_t i = 0; i < longueur; ++i) {
+		h ^= (unsigned char)texte[i];
+		h *= 16777619u;
+	}
+	return h;
+}
+
+int initPoolNoms(PoolNoms* pool, size_t nb_octets, size_t nb_noms, Arene* arene) {
+	/* table remplie au plus à moitié */
+	size_t nb_cases = 1;
+	while (nb_cases < 2 * nb_noms) {
+		nb_cases <<= 1;
+	}
+	pool->donnees = (char*)allouerArene(arene, nb_octets ? nb_octets : 1);
+	pool->cases = (Nom*)allouerArene(arene, nb_cases * sizeof(Nom));
+	if (!pool->donnees || !pool->cases) return 0;
+
+	memset(pool->cases, 0, nb_cases * sizeof(Nom));
+	pool->taille = 0;
+	pool->capacite = nb_octets;
+	pool->nb_cases = nb_cases;
+	return 1;
+}
+
+int internerNom(PoolNoms* pool, const char* texte, Nom* nom) {
+	size_t longueur = strlen(texte);
+	uint32_t h = hacherNom(texte, longueur);
+	size_t masque = pool->nb_cases - 1;
+	size_t i = h & masque;
+
+	for (size_t essais = 0; essais < pool->nb_cases; ++essais) {
+		Nom* c = &pool->cases[i];
+		if (c->texte == NULL) {
+			if (pool->capacite - pool->taille < longueur + 1) return 0;
+			char* copie = pool->donnees + pool->taille;
+			memcpy(copie, texte, longueur + 1);
+			pool->taille += longueur + 1;
+
+			c->texte = copie;
+			c->longueur = (uint32_t)longueur;
+			c->hachage = h;
+			*nom = *c;
+			return 1;
+		}
+		if (nomEgal(c, texte, longueur, h)) {
+			*nom = *c;
+			return 1;
+		}
+		i = (i + 1) & masque;
+	}
+	return 0;
+}
+
+int nomEgal(const Nom* nom, const char* texte, size_t longueur, uint32_t hachage) {
+	return nom->hachage == hachage && nom->longueur == longueur
+		&& memcmp(nom->texte, texte, longueur) == 0;
+}
+
+int memeNom(const Nom* a, const Nom* b) {
+	return a->texte == b->texte;
+}
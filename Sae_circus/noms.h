@@ -0,0 +1,93 @@
+/**
+ * @file noms.h
+ * @brief Réserve de noms internés (animaux, commandes, joueurs).
+ *
+ * Tous les noms d’une configuration (ou d’une partie) sont copiés une seule fois
+ * dans un tampon contigu dont la taille est fixée au chargement. Chaque nom
+ * distinct n’y figure qu’une fois : deux `Nom` issus de la même réserve sont
+ * égaux si et seulement s’ils désignent le même texte, et la longueur et le
+ * hachage sont calculés une fois pour toutes.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "arene.h"
+
+/**
+ * @brief Nom interné : texte dans la réserve, longueur et hachage précalculés.
+ */
+typedef struct {
+    const char* texte;  /**< Chaîne C terminée par `'\0'`, dans la réserve. */
+    uint32_t longueur;  /**< Longueur du texte, sans le `'\0'`. */
+    uint32_t hachage;   /**< Hachage FNV-1a du texte. */
+} Nom;
+
+/**
+ * @brief Réserve de noms : tampon contigu et table d’internement.
+ *
+ * Le tampon et la table sont alloués dans une arène et ne sont jamais
+ * déplacés ; les `Nom` peuvent donc pointer directement dans le tampon.
+ */
+typedef struct {
+    char* donnees;     /**< Tampon des textes, mis bout à bout. */
+    size_t taille;     /**< Octets utilisés. */
+    size_t capacite;   /**< Octets disponibles. */
+    Nom* cases;        /**< Table d’adressage ouvert (`texte == NULL` : case vide). */
+    size_t nb_cases;   /**< Nombre de cases (puissance de 2). */
+} PoolNoms;
+
+/**
+ * @brief Calcule le hachage d’un texte.
+ *
+ * @param[in] texte Texte.
+ * @param[in] longueur Nombre d’octets.
+ * @return Le hachage FNV-1a 32 bits du texte.
+ */
+uint32_t hacherNom(const char* texte, size_t longueur);
+
+/**
+ * @brief Initialise une réserve dans une arène.
+ *
+ * @param[out] pool Réserve à initialiser.
+ * @param[in] nb_octets Nombre total d’octets des textes, `'\0'` compris.
+ * @param[in] nb_noms Nombre maximal de noms distincts.
+ * @param[in,out] arene Arène qui héberge le tampon et la table.
+ * @return `1` si l’initialisation réussit, `0` sinon.
+ */
+int initPoolNoms(PoolNoms* pool, size_t nb_octets, size_t nb_noms, Arene* arene);
+
+/**
+ * @brief Interne un texte dans la réserve.
+ *
+ * Si le texte y figure déjà, le `Nom` existant est retourné.
+ *
+ * @param[in,out] pool Réserve.
+ * @param[in] texte Chaîne C à interner.
+ * @param[out] nom Nom interné.
+ * @return `1` si l’opération réussit, `0` si la réserve est pleine.
+ */
+int internerNom(PoolNoms* pool, const char* texte, Nom* nom);
+
+/**
+ * @brief Compare un nom interné à un texte dont le hachage est déjà connu.
+ *
+ * La longueur et le hachage sont comparés avant le texte lui-même.
+ *
+ * @param[in] nom Nom interné.
+ * @param[in] texte Texte à comparer.
+ * @param[in] longueur Longueur du texte.
+ * @param[in] hachage Hachage du texte (voir `hacherNom`).
+ * @return `1` si les textes sont égaux, `0` sinon.
+ */
+int nomEgal(const Nom* nom, const char* texte, size_t longueur, uint32_t hachage);
+
+/**
+ * @brief Compare deux noms internés dans la même réserve.
+ *
+ * @param[in] a Premier nom.
+ * @param[in] b Second nom.
+ * @return `1` si les noms sont égaux, `0` sinon.
+ */
+int memeNom(const Nom* a, const Nom* b);
@@ -0,0 +1,164 @@
+#include "paquet.h"
+#include "trace.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+static const char MAGIE_PAQUET[8] = "SAEPAQT";
+enum { ORDRE_PAQUET = 0x01020304, ALIGNEMENT_PAQUET = 4096 };
+
+
+/* nombre de cartes d’un paquet complet : (n + 1)!, ou -1 s’il déborde */
+static int64_t nbCartesAttendu(int n) {
+	int64_t total = 1;
+	for (int i = 2; i <= n + 1; ++i) {
+		if (total > INT64_MAX / i) return -1;
+		total *= i;
+	}
+	return total;
+}
+
+/* projection en lecture seule de tout le fichier, NULL en cas d’échec */
+static void* projeterFichier(const char* chemin, size_t* taille) {
+#ifdef _WIN32
+	HANDLE fichier = CreateFileA(chemin, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, NULL,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (fichier == INVALID_HANDLE_VALUE) return NULL;
+	LARGE_INTEGER longueur;
+	if (!GetFileSizeEx(fichier, &longueur) || longueur.QuadPart < (LONGLONG)sizeof(EntetePaquet)) {
+		CloseHandle(fichier);
+		return NULL;
+	}
+	HANDLE projection = CreateFileMappingA(fichier, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(fichier);
+	if (!projection) return NULL;
+	/* la vue garde la projection ouverte */
+	void* vue = MapViewOfFile(projection, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(projection);
+	*taille = (size_t)longueur.QuadPart;
+	return vue;
+#else
+	int fd = open(chemin, O_RDONLY);
+	if (fd < 0) return NULL;
+	struct stat infos;
+	if (fstat(fd, &infos) != 0 || infos.st_size < (off_t)sizeof(EntetePaquet)) {
+		close(fd);
+		return NULL;
+	}
+	void* vue = mmap(NULL, (size_t)infos.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (vue == MAP_FAILED) return NULL;
+	*taille = (size_t)infos.st_size;
+	return vue;
+#endif
+}
+
+static void supprimerProjection(void* vue, size_t taille) {
+#ifdef _WIN32
+	(void)taille;
+	UnmapViewOfFile(vue);
+#else
+	munmap(vue, taille);
+#endif
+}
+
+int projeterPaquet(Cartes* cartes, int n, const char* chemin) {
+	size_t taille = 0;
+	void* vue = projeterFichier(chemin, &taille);
+	if (!vue) return 0;
+
+	const EntetePaquet* entete = (const EntetePaquet*)vue;
+	int64_t attendu = nbCartesAttendu(n);
+	uint64_t octets = attendu > 0 ? (uint64_t)attendu * (uint64_t)(n + 1) * sizeof(int) : 0;
+	if (memcmp(entete->magie, MAGIE_PAQUET, sizeof(MAGIE_PAQUET)) != 0
+		|| entete->version != VERSION_PAQUET || entete->ordre != ORDRE_PAQUET
+		|| entete->taille_int != sizeof(int) || entete->n != n
+		|| attendu <= 0 || entete->nb_cartes != attendu
+		|| entete->decalage % ALIGNEMENT_PAQUET != 0 || entete->decalage > taille
+		|| octets / sizeof(int) / (uint64_t)(n + 1) != (uint64_t)attendu
+		|| octets > taille - entete->decalage) {
+		supprimerProjection(vue, taille);
+		return 0;
+	}
+
+	cartes->largeur = n + 1;
+	cartes->valeurs.elements = (int*)((char*)vue + entete->decalage);
+	cartes->valeurs.nbElements = attendu * (n + 1);
+	cartes->valeurs.capacite = cartes->valeurs.nbElements;
+	cartes->valeurs.sous_systeme = MEMOIRE_PAQUET;
+	cartes->projection = vue;
+	cartes->taille_projection = taille;
+	/* la projection est comptée en entier, bien que ses pages soient partagées avec le cache du système */
+	compterAllocation(MEMOIRE_PAQUET, taille);
+	return 1;
+}
+
+int ecrirePaquet(const Cartes* cartes, int n, const char* chemin) {
+	EntetePaquet entete;
+	memset(&entete, 0, sizeof(entete));
+	memcpy(entete.magie, MAGIE_PAQUET, sizeof(MAGIE_PAQUET));
+	entete.version = VERSION_PAQUET;
+	entete.ordre = ORDRE_PAQUET;
+	entete.taille_int = sizeof(int);
+	entete.n = n;
+	entete.nb_cartes = nbCartes(cartes);
+	entete.decalage = ALIGNEMENT_PAQUET;
+
+	/* nom temporaire propre à cet écrivain */
+	size_t longueur = strlen(chemin) + 32;
+	char* temporaire = (char*)malloc(longueur);
+	if (!temporaire) return 0;
+	snprintf(temporaire, longueur, "%s.%016llx.tmp", chemin, (unsigned long long)graineHorloge());
+
+	FILE* f = fopen(temporaire, "wb");
+	if (!f) {
+		free(temporaire);
+		return 0;
+	}
+	static const char zeros[ALIGNEMENT_PAQUET] = { 0 };
+	size_t nb = (size_t)cartes->valeurs.nbElements;
+	int ok = fwrite(&entete, sizeof(entete), 1, f) == 1
+		&& fwrite(zeros, 1, ALIGNEMENT_PAQUET - sizeof(entete), f) == ALIGNEMENT_PAQUET - sizeof(entete)
+		&& (nb == 0 || fwrite(cartes->valeurs.elements, sizeof(int), nb, f) == nb);
+	ok = fclose(f) == 0 && ok;
+
+#ifdef _WIN32
+	ok = ok && MoveFileExA(temporaire, chemin, MOVEFILE_REPLACE_EXISTING);
+#else
+	ok = ok && rename(temporaire, chemin) == 0;
+#endif
+	if (!ok) remove(temporaire);
+	free(temporaire);
+	return ok;
+}
+
+int chargerPaquet(Cartes* cartes, Animaux* animaux, const char* chemin) {
+	int n = (int)animaux->nbElements;
+	if (chemin && projeterPaquet(cartes, n, chemin)) {
+		return 1;
+	}
+	initCartes(cartes, n);
+	debutTrace("generation paquet");
+	genererToutesLesCartes(animaux, cartes);
+	finTrace("generation paquet");
+	if (chemin) {
+		ecrirePaquet(cartes, n, chemin);
+	}
+	return 0;
+}
+
+void libererProjectionPaquet(Cartes* cartes) {
+	supprimerProjection(cartes->projection, cartes->taille_projection);
+	compterLiberation(MEMOIRE_PAQUET, cartes->taille_projection);
+	cartes->projection = NULL;
+	cartes->taille_projection = 0;
+	cartes->valeurs.elements = NULL;
+	cartes->valeurs.nbElements = 0;
+	cartes->valeurs.capacite = 0;
+}
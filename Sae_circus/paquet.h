@@ -0,0 +1,82 @@
+/**
+ * @file paquet.h
+ * @brief Fichier de paquet précompilé, projeté en mémoire en lecture seule.
+ *
+ * Le paquet complet ((n + 1)! cartes de n + 1 entiers) ne dépend que du nombre
+ * d’animaux. Il est écrit une fois dans un fichier binaire versionné, puis chaque
+ * lancement projette ce fichier en mémoire au lieu de régénérer le paquet : le
+ * démarrage ne coûte plus que la vérification de l’en-tête, les pages sont lues
+ * à la demande et le cache de pages du système est partagé entre tous les
+ * processus qui jouent la même configuration.
+ *
+ * Format (entiers dans l’ordre de la machine qui a écrit le fichier) :
+ * - un en-tête `EntetePaquet` ;
+ * - à partir de `decalage` (aligné sur 4 Kio), les cartes bout à bout, comme dans `Cartes`.
+ *
+ * Un fichier dont l’en-tête ne correspond pas (version, nombre d’animaux, taille
+ * des entiers, ordre des octets, taille) est ignoré et réécrit.
+ */
+
+#pragma once
+
+#include "cartes.h"
+
+/** @brief Version du format ; à incrémenter à chaque changement de disposition. */
+enum { VERSION_PAQUET = 1 };
+
+/**
+ * @brief En-tête du fichier de paquet.
+ */
+typedef struct {
+    char magie[8];        /**< `"SAEPAQT"` suivi d’un octet nul. */
+    uint32_t version;     /**< `VERSION_PAQUET`. */
+    uint32_t ordre;       /**< `0x01020304`, pour rejeter un fichier écrit avec un autre ordre des octets. */
+    uint32_t taille_int;  /**< `sizeof(int)` de la machine qui a écrit le fichier. */
+    int32_t n;            /**< Nombre d’animaux. */
+    int64_t nb_cartes;    /**< Nombre de cartes. */
+    uint64_t decalage;    /**< Position des cartes dans le fichier. */
+} EntetePaquet;
+
+/**
+ * @brief Projette un fichier de paquet en mémoire.
+ *
+ * En cas de succès, le paquet ne possède pas ses cartes : `detruireCartes` supprime la projection.
+ *
+ * @param[out] cartes Paquet initialisé sur la projection.
+ * @param[in] n Nombre d’animaux attendu.
+ * @param[in] chemin Fichier de paquet.
+ * @return `1` si le fichier existe et correspond, `0` sinon (`cartes` n’est alors pas initialisé).
+ */
+int projeterPaquet(Cartes* cartes, int n, const char* chemin);
+
+/**
+ * @brief Écrit un paquet dans un fichier de paquet.
+ *
+ * Le fichier est écrit sous un nom temporaire puis renommé : un lecteur concurrent
+ * voit l’ancien fichier ou le nouveau, jamais un fichier partiel.
+ *
+ * @param[in] cartes Paquet complet.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] chemin Fichier de paquet.
+ * @return `1` si l’écriture réussit, `0` sinon.
+ */
+int ecrirePaquet(const Cartes* cartes, int n, const char* chemin);
+
+/**
+ * @brief Charge le paquet complet : projection du fichier s’il correspond, génération et écriture sinon.
+ *
+ * Un échec d’écriture n’est pas une erreur : le paquet généré reste en mémoire.
+ *
+ * @param[out] cartes Paquet à initialiser.
+ * @param[in] animaux Animaux de la configuration.
+ * @param[in] chemin Fichier de paquet, ou `NULL` pour toujours générer.
+ * @return `1` si le paquet a été projeté, `0` s’il a été généré.
+ */
+int chargerPaquet(Cartes* cartes, Animaux* animaux, const char* chemin);
+
+/**
+ * @brief Supprime la projection d’un paquet (appelée par `detruireCartes`).
+ *
+ * @param[in,out] cartes Paquet projeté.
+ */
+void libererProjectionPaquet(Cartes* cartes);
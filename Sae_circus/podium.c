@@ -1,97 +1,73 @@
 #include "podium.h"
 
 int initPodium(Podium* p, int capacite) {
-	return initVecteur(p, capacite);
+	return initPourVecteurInt(p, capacite, MEMOIRE_PODIUMS);
 }
 
 int ajouterPodiumAnimal(Podium* p, int index_animal){
-	int* it = (int*)malloc(sizeof(int));
-	*it = index_animal;
-	return ajouter(p, it);
+	return ajouterVecteurInt(p, index_animal);
 }
 
 void supprimerPodiumAnimal(Podium* p, int index_animal) {
-	supprimer(p, index_animal);
+	supprimerVecteurInt(p, index_animal);
 
 }
 
 int presentAuPodium(Podium* p, int index_animal) {
 	if (!p) return 0;
-	for (int i = 0; i < p->nbElements; ++i) {
-		int* it = (int*)obtenir(p, i);
-		if (it && *it == index_animal) return 1;
+	for (int64_t i = 0; i < p->nbElements; ++i) {
+		if (p->elements[i] == index_animal) return 1;
 	}
 	return 0;
 }
 
-int comparer2Podiums(Podium* p_1, Podium* p_2) {
+int comparer2Podiums(const Podium* p_1, const Podium* p_2) {
 	if (p_1->nbElements != p_2->nbElements) {
 		return 0;
 	}
-	for (int i = 0; i < p_1->nbElements; ++i) {
-		int* it1 = (int*)obtenir(p_1, i);
-		int* it2 = (int*)obtenir(p_2, i);
-		if (*it1 != *it2) return 0;
-	}
-	return 1;
+	return p_1->nbElements == 0
+		|| memcmp(p_1->elements, p_2->elements, sizeof(int) * (size_t)p_1->nbElements) == 0;
 }
 
 Podium* clonePodium(const Podium* src) {
 	if (!src) return NULL;
-	Podium* p = (Podium*)malloc(sizeof(Podium));
+	Podium* p = (Podium*)allouerMemoire(MEMOIRE_PODIUMS, sizeof(Podium));
+	if (!p) return NULL;
 	
-	initPodium(p, src->capacite > 0 ? src->capacite : 1);
-		
-	for (int i = 0; i < src->nbElements; ++i) {
-		int* it = (int*)obtenir(src, i);
-		if (it) {
-			
-			ajouterPodiumAnimal(p, *it);
-		}
-	}
+	initPodium(p, src->nbElements > 0 ? (int)src->nbElements : 1);
+	ajouterPlusieursVecteurInt(p, src->elements, src->nbElements);
 	return p;
 }
 
 void freePodium(Podium* p) {
-	for (int i = 0; i < p->nbElements; ++i) {
-		free(p->elements[i]);
-	}
-	detruireVecteur(p);
+	detruireVecteurInt(p);
+}
+
+void freeClonePodium(Podium* p) {
+	if (!p) return;
+	detruireVecteurInt(p);
+	libererMemoire(MEMOIRE_PODIUMS, p, sizeof(Podium));
 }
 
 void clearPodium(Podium* p) {
 	if (!p) return;
-	for (int i = 0; i < p->nbElements; ++i) {
-		free(p->elements[i]);
-		p->elements[i] = NULL;
-	}
-	p->nbElements = 0;
+	viderVecteurInt(p);
 }
 
 
 int maxTaillePodiums(const Podium* p_b, const Podium* p_r, const Podium* t_b, const Podium* t_r) {
-	int max = 0;
+	int64_t max = 0;
 	if (p_b && p_b->nbElements > max) max = p_b->nbElements;
 	if (p_r && p_r->nbElements > max) max = p_r->nbElements;
 	if (t_b && t_b->nbElements > max) max = t_b->nbElements;
 	if (t_r && t_r->nbElements > max) max = t_r->nbElements;
-	return max;
+	return (int)max;
 }
 
 int remplacerContenuPodium(Podium* dest, const Podium* src) {
 	
-	freePodium(dest);
-
-	
-	for (int i = 0; i < src->nbElements; ++i) {
-		int* it_src = (int*)obtenir(src, i);
-
-		int* it = (int*)malloc(sizeof(int));
-		
-		*it = *it_src;
-		ajouterPodiumAnimal(dest, it);
-	}
-	return 1;
+	viderVecteurInt(dest);
+	return ajouterPlusieursVecteurInt(dest, src->elements, src->nbElements);
 }
 
 
@@ -105,10 +81,9 @@ int trouverAnimalPlusLongue(Animaux* animaux, Podium* podium, int type) {
 	else {
 		max = 5;
 	}
-	for (int i = 0; i < podium->nbElements; ++i) {
-		int* animal_id = obtenir(podium, i);
-		Animal* a = obtenirAnimal(animaux, *animal_id);
-		int taille_a = strlen(a->nom_animal);
+	for (int64_t i = 0; i < podium->nbElements; ++i) {
+		Animal* a = obtenirAnimal(animaux, podium->elements[i]);
+		int taille_a = (int)a->nom_animal.longueur;
 		if (taille_a > max) {
 			max = taille_a;
 		}
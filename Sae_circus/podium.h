@@ -2,7 +2,8 @@
  * @file podium.h
  * @brief Gestion des podiums : initialisation, manipulation, clonage et comparaison.
  *
- * Un podium est représenté par un `Vecteur` stockant des indices d’animaux.
+ * Un podium est représenté par un `VecteurInt` stockant des indices d’animaux
+ * par valeur, du bas (indice 0) vers le haut.
  * Ce module fournit les opérations pour gérer ces podiums.
  */
 
@@ -15,7 +16,7 @@
 /**
  * @brief Type représentant un podium.
  */
-typedef Vecteur Podium;
+typedef VecteurInt Podium;
 
 /**
  * @brief Initialise un podium.
@@ -38,6 +39,8 @@ int ajouterPodiumAnimal(Podium* p, int index_animal);
 /**
  * @brief Supprime un animal à une position donnée.
  *
+ * Les animaux situés au-dessus descendent d’un niveau.
+ *
  * @param[in,out] p Podium cible.
  * @param[in] index_animal Position à supprimer.
  */
@@ -59,7 +62,7 @@ int presentAuPodium(Podium* p, int index_animal);
  * @param[in] p_2 Second podium.
  * @return `1` si les deux podiums sont identiques, `0` sinon.
  */
-int comparer2Podiums(Podium* p_1, Podium* p_2);
+int comparer2Podiums(const Podium* p_1, const Podium* p_2);
 
 /**
  * @brief Crée une copie d’un podium.
@@ -70,12 +73,19 @@ int comparer2Podiums(Podium* p_1, Podium* p_2);
 Podium* clonePodium(const Podium* src);
 
 /**
- * @brief Libère un podium et son contenu.
+ * @brief Libère le contenu d’un podium (mais pas la structure elle-même).
  *
  * @param[in,out] p Podium à libérer.
  */
 void freePodium(Podium* p);
 
+/**
+ * @brief Libère un podium créé par `clonePodium` (contenu et structure).
+ *
+ * @param[in,out] p Podium à libérer, ou `NULL`.
+ */
+void freeClonePodium(Podium* p);
+
 /**
  * @brief Vide le contenu d’un podium.
  *
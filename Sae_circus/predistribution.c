@@ -0,0 +1,89 @@
+#include "predistribution.h"
+#include "trace.h"
+
+
+static int bouclePredistribution(void* arg) {
+	Predistribution* p = (Predistribution*)arg;
+	nommerFilTrace("predistribution");
+	mtx_lock(&p->verrou);
+	for (;;) {
+		while (!p->arret && (!p->demande || p->prete)) {
+			cnd_wait(&p->signal, &p->verrou);
+		}
+		if (p->arret) break;
+		mtx_unlock(&p->verrou);
+
+		/* sans mémoire pour la table, la donne est prête sans ses distances */
+		if (p->avec_distances && p->distances.cles) {
+			debutTrace("analyse donne");
+			calculerDistances(&p->distances, p->cible, p->n, p->commandes, DISTANCE_INFINIE);
+			p->distance_depart = distanceMinimale(&p->distances, p->depart);
+			finTrace("analyse donne");
+		}
+		else {
+			p->avec_distances = 0;
+		}
+
+		mtx_lock(&p->verrou);
+		p->prete = 1;
+		cnd_broadcast(&p->signal);
+	}
+	mtx_unlock(&p->verrou);
+	return 0;
+}
+
+int demarrerPredistribution(Predistribution* p, int n, const Commandes* commandes) {
+	p->demande = 0;
+	p->prete = 0;
+	p->arret = 0;
+	p->n = n;
+	p->commandes = commandes;
+	p->depart = CLE_INVALIDE;
+	p->cible = CLE_INVALIDE;
+	p->avec_distances = 0;
+	p->distance_depart = 0;
+	initTableDistances(&p->distances, MAX_ETATS_DISTANCE);
+	mtx_init(&p->verrou, mtx_plain);
+	cnd_init(&p->signal);
+	if (thrd_create(&p->fil, bouclePredistribution, p) != thrd_success) {
+		cnd_destroy(&p->signal);
+		mtx_destroy(&p->verrou);
+		detruireTableDistances(&p->distances);
+		return 0;
+	}
+	return 1;
+}
+
+void demanderDonne(Predistribution* p, CleEtat depart, CleEtat cible, int avec_distances) {
+	mtx_lock(&p->verrou);
+	p->depart = depart;
+	p->cible = cible;
+	p->avec_distances = avec_distances;
+	p->demande = 1;
+	p->prete = 0;
+	mtx_unlock(&p->verrou);
+	cnd_signal(&p->signal);
+}
+
+int recupererDonne(Predistribution* p) {
+	mtx_lock(&p->verrou);
+	while (p->demande && !p->prete) {
+		cnd_wait(&p->signal, &p->verrou);
+	}
+	int prete = p->demande;
+	p->demande = 0;
+	p->prete = 0;
+	mtx_unlock(&p->verrou);
+	return prete;
+}
+
+void arreterPredistribution(Predistribution* p) {
+	mtx_lock(&p->verrou);
+	p->arret = 1;
+	mtx_unlock(&p->verrou);
+	cnd_broadcast(&p->signal);
+	thrd_join(p->fil, NULL);
+	cnd_destroy(&p->signal);
+	mtx_destroy(&p->verrou);
+	detruireTableDistances(&p->distances);
+}
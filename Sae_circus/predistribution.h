@@ -0,0 +1,78 @@
+/**
+ * @file predistribution.h
+ * @brief Calcul anticipé, sur un thread auxiliaire, de l’analyse de la donne suivante.
+ *
+ * Dès qu’un tour commence, la partie tire déjà les cartes du tour suivant et
+ * confie leur analyse (distances à la cible, distance de la situation de départ)
+ * au fil de prédistribution, pendant que les joueurs réfléchissent. Au tour
+ * suivant, la partie échange simplement sa table de distances avec celle du fil :
+ * la redistribution ne coûte plus que la copie des cartes sur les podiums.
+ *
+ * Le fil ne lit que la configuration partagée et sa propre table ; la partie
+ * n’accède à cette table qu’après `recupererDonne`, quand le fil est inactif.
+ */
+
+#pragma once
+
+#include <threads.h>
+#include "distance.h"
+
+/**
+ * @brief Fil de prédistribution et donne en cours d’analyse.
+ */
+typedef struct {
+    thrd_t fil;
+    mtx_t verrou;               /**< Protège `demande`, `prete` et `arret`. */
+    cnd_t signal;               /**< Signalé à l’arrivée d’une demande, à la fin d’une analyse ou à l’arrêt. */
+    int demande;                /**< `1` tant qu’une donne attend ou subit son analyse. */
+    int prete;                  /**< `1` si la dernière donne demandée est analysée. */
+    int arret;
+
+    CleEtat depart;             /**< Situation de départ de la donne. */
+    CleEtat cible;              /**< Situation cible de la donne. */
+    int avec_distances;         /**< `1` si les distances de la donne sont demandées. */
+    TableDistances distances;   /**< Distances à `cible` (échangée avec celle de la partie). */
+    int distance_depart;        /**< Distance de `depart` à `cible`. */
+
+    int n;                      /**< Nombre d’animaux. */
+    const Commandes* commandes; /**< Commandes autorisées (configuration partagée, en lecture seule). */
+} Predistribution;
+
+/**
+ * @brief Démarre le fil de prédistribution.
+ *
+ * @param[out] p Prédistribution à démarrer.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] commandes Commandes autorisées (doivent rester valides jusqu’à `arreterPredistribution`).
+ * @return `1` si le démarrage réussit, `0` sinon (rien n’est alors à libérer).
+ * @pre `n <= MAX_ANIMAUX_CLE`.
+ */
+int demarrerPredistribution(Predistribution* p, int n, const Commandes* commandes);
+
+/**
+ * @brief Confie une donne au fil ; l’appel ne bloque pas.
+ *
+ * @param[in,out] p Prédistribution inactive (aucune demande en cours).
+ * @param[in] depart Situation de départ de la donne.
+ * @param[in] cible Situation cible de la donne.
+ * @param[in] avec_distances `1` pour calculer les distances à la cible.
+ */
+void demanderDonne(Predistribution* p, CleEtat depart, CleEtat cible, int avec_distances);
+
+/**
+ * @brief Attend la fin de l’analyse de la dernière donne demandée.
+ *
+ * Au retour, le fil est inactif : `p->distances` et `p->distance_depart` peuvent être lus
+ * ou échangés jusqu’à la prochaine `demanderDonne`.
+ *
+ * @param[in,out] p Prédistribution.
+ * @return `1` si une donne est analysée, `0` si aucune n’a été demandée.
+ */
+int recupererDonne(Predistribution* p);
+
+/**
+ * @brief Arrête le fil et libère la prédistribution.
+ *
+ * @param[in,out] p Prédistribution démarrée.
+ */
+void arreterPredistribution(Predistribution* p);
@@ -0,0 +1,230 @@
+#include <sys/types.h>
+#include <sys/stat.h>
+#include "rechargement.h"
+#include "trace.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+
+void retenirConfig(ConfigPartagee* config) {
+	atomic_fetch_add_explicit(&config->references, 1, memory_order_relaxed);
+}
+
+void relacherConfig(ConfigPartagee* config) {
+	if (config && atomic_fetch_sub_explicit(&config->references, 1, memory_order_acq_rel) == 1) {
+		detruireGame(&config->modele);
+		free(config);
+	}
+}
+
+static ConfigPartagee* chargerConfigPartagee(const char* fichier) {
+	ConfigPartagee* config = (ConfigPartagee*)malloc(sizeof(ConfigPartagee));
+	if (!config) return NULL;
+	if (chargerConfigGame(&config->modele, fichier) != 0) {
+		free(config);
+		return NULL;
+	}
+	config->generation = 0;
+	atomic_init(&config->references, 1);
+	return config;
+}
+
+static int arretDemande(Rechargeur* r) {
+	mtx_lock(&r->verrou);
+	int arret = r->arret;
+	mtx_unlock(&r->verrou);
+	return arret;
+}
+
+/* date et taille du fichier, pour la surveillance sans inotify */
+static void consulterFichier(const char* chemin, time_t* modification, long long* taille) {
+	struct stat infos;
+	*modification = 0;
+	*taille = -1;
+	if (stat(chemin, &infos) == 0) {
+		*modification = infos.st_mtime;
+		*taille = (long long)infos.st_size;
+	}
+}
+
+/* attend une modification du fichier en le consultant à chaque période ; 0 à l’arrêt */
+static int attendreParConsultation(Rechargeur* r) {
+	mtx_lock(&r->verrou);
+	while (!r->arret) {
+		struct timespec limite;
+		timespec_get(&limite, TIME_UTC);
+		limite.tv_sec += r->intervalle_ms / 1000;
+		limite.tv_nsec += (long)(r->intervalle_ms % 1000) * 1000000L;
+		if (limite.tv_nsec >= 1000000000L) {
+			++limite.tv_sec;
+			limite.tv_nsec -= 1000000000L;
+		}
+		cnd_timedwait(&r->signal, &r->verrou, &limite);
+		if (r->arret) break;
+
+		time_t modification;
+		long long taille;
+		consulterFichier(r->fichier, &modification, &taille);
+		if (modification != r->modification || taille != r->taille) {
+			r->modification = modification;
+			r->taille = taille;
+			mtx_unlock(&r->verrou);
+			return 1;
+		}
+	}
+	mtx_unlock(&r->verrou);
+	return 0;
+}
+
+#ifdef __linux__
+/* surveille le répertoire : un éditeur remplace souvent le fichier par un renommage */
+static int ouvrirInotify(const char* chemin) {
+	const char* separateur = strrchr(chemin, '/');
+	size_t longueur = separateur ? (size_t)(separateur - chemin) : 1;
+	char* repertoire = (char*)malloc(longueur + 2);
+	if (!repertoire) return -1;
+	if (separateur) {
+		memcpy(repertoire, chemin, longueur);
+		if (longueur == 0) repertoire[longueur++] = '/';
+	}
+	else {
+		repertoire[0] = '.';
+	}
+	repertoire[longueur] = '\0';
+
+	int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd >= 0 && inotify_add_watch(fd, repertoire, IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		close(fd);
+		fd = -1;
+	}
+	free(repertoire);
+	return fd;
+}
+
+/* attend qu’une écriture du fichier se termine ; l’arrêt est vu à chaque période */
+static int attendreParInotify(Rechargeur* r) {
+	const char* separateur = strrchr(r->fichier, '/');
+	const char* nom = separateur ? separateur + 1 : r->fichier;
+	_Alignas(struct inotify_event) char evenements[4096];
+	while (!arretDemande(r)) {
+		struct pollfd attente = { r->inotify, POLLIN, 0 };
+		if (poll(&attente, 1, r->intervalle_ms) <= 0) continue;
+
+		int modifie = 0;
+		ssize_t lu;
+		while ((lu = read(r->inotify, evenements, sizeof(evenements))) > 0) {
+			for (char* p = evenements; p < evenements + lu; ) {
+				const struct inotify_event* e = (const struct inotify_event*)p;
+				if (e->len > 0 && strcmp(e->name, nom) == 0) modifie = 1;
+				p += sizeof(struct inotify_event) + e->len;
+			}
+		}
+		if (modifie) return 1;
+	}
+	return 0;
+}
+#endif
+
+static void fermerInotify(Rechargeur* r) {
+#ifdef __linux__
+	if (r->inotify >= 0) close(r->inotify);
+#endif
+	r->inotify = -1;
+}
+
+static int boucleRechargeur(void* arg) {
+	Rechargeur* r = (Rechargeur*)arg;
+	nommerFilTrace("surveillance config");
+#ifdef __linux__
+	if (r->inotify >= 0) {
+		while (attendreParInotify(r)) {
+			rechargerConfig(r);
+		}
+		return 0;
+	}
+#endif
+	while (attendreParConsultation(r)) {
+		rechargerConfig(r);
+	}
+	return 0;
+}
+
+int demarrerRechargeur(Rechargeur* r, const char* fichier, int intervalle_ms) {
+	r->fichier = strdup(fichier);
+	if (!r->fichier) return 0;
+	r->inotify = -1;
+#ifdef __linux__
+	if (intervalle_ms > 0) r->inotify = ouvrirInotify(fichier);
+#endif
+	consulterFichier(fichier, &r->modification, &r->taille);
+	r->courante = chargerConfigPartagee(fichier);
+	if (!r->courante) {
+		fermerInotify(r);
+		free(r->fichier);
+		return 0;
+	}
+	atomic_init(&r->generation, 0);
+	r->intervalle_ms = intervalle_ms;
+	r->arret = 0;
+	r->nb_rechargements = 0;
+	r->nb_echecs = 0;
+	mtx_init(&r->verrou, mtx_plain);
+	cnd_init(&r->signal);
+	/* sans fil de surveillance, la configuration reste celle du démarrage */
+	r->surveille = intervalle_ms > 0 && thrd_create(&r->fil, boucleRechargeur, r) == thrd_success;
+	return 1;
+}
+
+uint64_t generationConfig(Rechargeur* r) {
+	return atomic_load_explicit(&r->generation, memory_order_acquire);
+}
+
+ConfigPartagee* acquerirConfig(Rechargeur* r) {
+	mtx_lock(&r->verrou);
+	ConfigPartagee* config = r->courante;
+	retenirConfig(config);
+	mtx_unlock(&r->verrou);
+	return config;
+}
+
+int rechargerConfig(Rechargeur* r) {
+	debutTrace("rechargement");
+	ConfigPartagee* config = chargerConfigPartagee(r->fichier);
+	finTrace("rechargement");
+	mtx_lock(&r->verrou);
+	if (!config) {
+		++r->nb_echecs;
+		mtx_unlock(&r->verrou);
+		return 0;
+	}
+	ConfigPartagee* ancienne = r->courante;
+	config->generation = ancienne->generation + 1;
+	r->courante = config;
+	atomic_store_explicit(&r->generation, config->generation, memory_order_release);
+	++r->nb_rechargements;
+	mtx_unlock(&r->verrou);
+	relacherConfig(ancienne);
+	return 1;
+}
+
+void arreterRechargeur(Rechargeur* r) {
+	if (r->surveille) {
+		mtx_lock(&r->verrou);
+		r->arret = 1;
+		mtx_unlock(&r->verrou);
+		cnd_broadcast(&r->signal);
+		thrd_join(r->fil, NULL);
+		r->surveille = 0;
+	}
+	fermerInotify(r);
+	relacherConfig(r->courante);
+	r->courante = NULL;
+	cnd_destroy(&r->signal);
+	mtx_destroy(&r->verrou);
+	free(r->fichier);
+	r->fichier = NULL;
+}
@@ -0,0 +1,116 @@
+/**
+ * @file rechargement.h
+ * @brief Configuration partagée rechargée à chaud quand son fichier change.
+ *
+ * Une configuration chargée (animaux, commandes, paquet) est immuable et
+ * partagée par comptage de références : chaque salle qui l’utilise en retient
+ * une, comme chaque demande de robot en cours. Un fil de surveillance attend les
+ * modifications du fichier (inotify sous Linux, date de modification ailleurs),
+ * construit entièrement la nouvelle configuration sans bloquer personne, puis la
+ * publie en remplaçant un pointeur. Les lecteurs ne prennent le verrou que pour
+ * retenir la configuration courante, quand sa génération a changé ; l’ancienne
+ * est libérée par le dernier qui la relâche.
+ *
+ * Une configuration invalide est ignorée : la précédente reste publiée.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+#include "game.h"
+
+/** @brief Période de surveillance par défaut (ms) : délai maximal d’arrêt du fil, et de détection sans inotify. */
+enum { INTERVALLE_RECHARGEMENT_MS = 200 };
+
+/**
+ * @brief Configuration immuable partagée.
+ */
+typedef struct {
+    Game modele;             /**< Configuration chargée (voir `chargerConfigGame`), modèle de `initGamePartagee`. */
+    uint64_t generation;     /**< `0` pour la configuration initiale, puis `1` de plus à chaque rechargement. */
+    atomic_int references;
+} ConfigPartagee;
+
+/**
+ * @brief Fichier de configuration surveillé et dernière configuration publiée.
+ */
+typedef struct {
+    char* fichier;
+    mtx_t verrou;                 /**< Protège `courante`, `arret` et les compteurs. */
+    cnd_t signal;                 /**< Signalé à l’arrêt. */
+    ConfigPartagee* courante;     /**< Dernière configuration publiée (le rechargeur en retient une référence). */
+    atomic_uint_fast64_t generation; /**< Génération de `courante`, lisible sans verrou. */
+    thrd_t fil;
+    int surveille;                /**< `1` si le fil de surveillance tourne. */
+    int inotify;                  /**< Descripteur inotify (Linux), `-1` pour une surveillance par consultation. */
+    time_t modification;          /**< Date de modification du fichier avant le dernier chargement (consultation). */
+    long long taille;             /**< Taille du fichier avant le dernier chargement (consultation). */
+    int arret;
+    int intervalle_ms;
+    uint64_t nb_rechargements;    /**< Configurations publiées depuis le démarrage. */
+    uint64_t nb_echecs;           /**< Modifications dont le chargement a échoué. */
+} Rechargeur;
+
+/**
+ * @brief Ajoute une référence à une configuration.
+ *
+ * @param[in,out] config Configuration déjà retenue par l’appelant.
+ */
+void retenirConfig(ConfigPartagee* config);
+
+/**
+ * @brief Retire une référence ; la dernière libère la configuration.
+ *
+ * @param[in,out] config Configuration, ou `NULL`.
+ */
+void relacherConfig(ConfigPartagee* config);
+
+/**
+ * @brief Charge la configuration puis démarre la surveillance de son fichier.
+ *
+ * La surveillance est mise en place avant le chargement : une modification
+ * survenue pendant celui-ci provoque un rechargement.
+ *
+ * @param[out] r Rechargeur.
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] intervalle_ms Période de surveillance (ms), `0` pour ne pas surveiller le fichier.
+ * @return `1` si la configuration initiale est chargée, `0` sinon (rien n’est alors à libérer).
+ */
+int demarrerRechargeur(Rechargeur* r, const char* fichier, int intervalle_ms);
+
+/**
+ * @brief Génération de la dernière configuration publiée, sans verrou.
+ *
+ * @param[in] r Rechargeur.
+ * @return La génération courante.
+ */
+uint64_t generationConfig(Rechargeur* r);
+
+/**
+ * @brief Retient la dernière configuration publiée.
+ *
+ * @param[in,out] r Rechargeur.
+ * @return La configuration, à relâcher par `relacherConfig`.
+ */
+ConfigPartagee* acquerirConfig(Rechargeur* r);
+
+/**
+ * @brief Recharge le fichier et publie la nouvelle configuration (appelée par le fil de surveillance).
+ *
+ * Le chargement, génération du paquet comprise, se fait sans verrou.
+ *
+ * @param[in,out] r Rechargeur.
+ * @return `1` si une nouvelle configuration est publiée, `0` si le fichier est invalide.
+ */
+int rechargerConfig(Rechargeur* r);
+
+/**
+ * @brief Arrête la surveillance et relâche la configuration courante.
+ *
+ * Les configurations encore retenues restent valides jusqu’à leur dernier `relacherConfig`.
+ *
+ * @param[in,out] r Rechargeur.
+ */
+void arreterRechargeur(Rechargeur* r);
@@ -0,0 +1,574 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "reseau.h"
+
+#ifdef __linux__
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+
+enum {
+	NB_EVENEMENTS = 64,
+	TAILLE_LECTURE = 64 * 1024,
+	LIGNE_MAX = 16 * 1024 * 1024,     /* au-delà, la connexion est fermée */
+	SORTIE_MAX = 64 * 1024 * 1024     /* client qui ne lit plus ses réponses */
+};
+
+typedef struct {
+	int fd;
+	uint32_t numero;   /**< Distingue deux connexions ayant successivement le même fd. */
+	int ecoute_sortie; /**< EPOLLOUT est demandé. */
+	int fermee;        /**< Fermée, libérée à la fin du lot d’événements courant. */
+	int lecture_finie; /**< Le client a fermé son sens d’écriture : on n’attend plus que ses réponses. */
+	int64_t en_cours;  /**< Lignes transmises aux salles et pas encore acquittées. */
+	Tampon entree;
+	Tampon sortie;
+	size_t envoye;     /**< Octets de `sortie` déjà envoyés. */
+} Connexion;
+
+typedef struct Reponse {
+	int64_t client;
+	int salle;
+	int acquittement;  /**< Fin du traitement d’une ligne du client, sans texte. */
+	size_t longueur;
+	struct Reponse* suivant;
+	char texte[];
+} Reponse;
+
+typedef struct {
+	Serveur serveur;
+	int epoll;
+	int ecoute;
+	int reveil;        /**< eventfd signalé par les travailleurs quand des réponses attendent. */
+
+	mtx_t verrou;      /**< Protège la file des réponses. */
+	Reponse* tete;
+	Reponse* queue;
+
+	Connexion** connexions; /**< Indexées par fd. */
+	Vecteur fermees;        /**< Connexions fermées en attente de libération. */
+	int nb_connexions;      /**< Taille du tableau `connexions`. */
+	uint32_t prochain_numero;
+} Reseau;
+
+/* le signal peut être reçu par n’importe quel thread : atomique sans verrou, sûr dans un gestionnaire */
+static atomic_int arret_demande;
+/* eventfd signalé par le gestionnaire pour réveiller la boucle, quel que soit le thread qui reçoit
+   le signal ; créé une fois et jamais fermé, pour qu’un gestionnaire en cours n’écrive jamais
+   dans un descripteur réattribué */
+static atomic_int reveil_signal = -1;
+
+static void demanderArret(int signal) {
+	(void)signal;
+	int erreur = errno;
+	atomic_store(&arret_demande, 1);
+	int fd = atomic_load(&reveil_signal);
+	if (fd >= 0) {
+		/* write est sûr dans un gestionnaire de signal */
+		uint64_t un = 1;
+		ssize_t ecrit = write(fd, &un, sizeof(un));
+		(void)ecrit;
+	}
+	errno = erreur;
+}
+
+static int64_t identifiantClient(const Connexion* c) {
+	return ((int64_t)c->numero << 32) | (uint32_t)c->fd;
+}
+
+static void publierReponse(Reseau* r, int64_t client, int salle, const char* texte, size_t longueur, int acquittement) {
+	Reponse* rep = (Reponse*)malloc(sizeof(Reponse) + longueur);
+	if (!rep) return;
+	rep->client = client;
+	rep->salle = salle;
+	rep->acquittement = acquittement;
+	rep->longueur = longueur;
+	rep->suivant = NULL;
+	if (longueur > 0) memcpy(rep->texte, texte, longueur);
+
+	mtx_lock(&r->verrou);
+	int etait_vide = (r->tete == NULL);
+	if (r->queue) {
+		r->queue->suivant = rep;
+	}
+	else {
+		r->tete = rep;
+	}
+	r->queue = rep;
+	mtx_unlock(&r->verrou);
+
+	if (etait_vide) {
+		uint64_t un = 1;
+		ssize_t ecrit = write(r->reveil, &un, sizeof(un));
+		(void)ecrit;
+	}
+}
+
+/* Appelée depuis les travailleurs. */
+static void repondreReseau(void* contexte, int64_t client, int salle, const char* texte, size_t longueur) {
+	if (client < 0) return;
+	publierReponse((Reseau*)contexte, client, salle, texte, longueur, 0);
+}
+
+/* Appelée depuis les travailleurs, après la réponse à la ligne (même file) : l’ordre est conservé. */
+static void acquitterReseau(void* contexte, int64_t client) {
+	publierReponse((Reseau*)contexte, client, -1, NULL, 0, 1);
+}
+
+static void surveiller(Reseau* r, Connexion* c, int sortie) {
+	struct epoll_event ev;
+	ev.events = (c->lecture_finie ? 0 : EPOLLIN) | (sortie ? EPOLLOUT : 0);
+	ev.data.ptr = c;
+	epoll_ctl(r->epoll, EPOLL_CTL_MOD, c->fd, &ev);
+	c->ecoute_sortie = sortie;
+}
+
+static void fermerConnexion(Reseau* r, Connexion* c) {
+	epoll_ctl(r->epoll, EPOLL_CTL_DEL, c->fd, NULL);
+	close(c->fd);
+	r->connexions[c->fd] = NULL;
+	c->fermee = 1;
+	ajouter(&r->fermees, c);
+}
+
+/* Un lot d’événements peut encore désigner une connexion fermée : on ne libère qu’après le lot. */
+static void libererFermees(Reseau* r) {
+	for (int i = 0; i < r->fermees.nbElements; ++i) {
+		Connexion* c = obtenir(&r->fermees, i);
+		detruireTampon(&c->entree);
+		detruireTampon(&c->sortie);
+		free(c);
+	}
+	r->fermees.nbElements = 0;
+}
+
+/* Retourne 0 si la connexion a été fermée. */
+static int ecrireConnexion(Reseau* r, Connexion* c) {
+	while (c->envoye < c->sortie.taille) {
+		ssize_t n = send(c->fd, c->sortie.donnees + c->envoye, c->sortie.taille - c->envoye, MSG_NOSIGNAL);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+			fermerConnexion(r, c);
+			return 0;
+		}
+		c->envoye += (size_t)n;
+	}
+	/* le début envoyé n’est retiré qu’une fois le tampon vidé, ou quand il en occupe la moitié :
+	   les envois partiels ne recopient pas à chaque fois tout ce qui reste */
+	if (c->envoye == c->sortie.taille) {
+		c->sortie.taille = 0;
+		c->envoye = 0;
+	}
+	else if (c->envoye >= c->sortie.taille / 2) {
+		consommerTampon(&c->sortie, c->envoye);
+		c->envoye = 0;
+	}
+	if (c->sortie.taille - c->envoye > SORTIE_MAX) {
+		fermerConnexion(r, c);
+		return 0;
+	}
+	/* client à demi fermé : la connexion se termine quand toutes ses réponses sont parties */
+	if (c->lecture_finie && c->en_cours == 0 && c->sortie.taille == 0) {
+		fermerConnexion(r, c);
+		return 0;
+	}
+	if ((c->sortie.taille > 0) != c->ecoute_sortie) {
+		surveiller(r, c, c->sortie.taille > 0);
+	}
+	return 1;
+}
+
+static void accepterConnexions(Reseau* r) {
+	for (;;) {
+		int fd = accept4(r->ecoute, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0) {
+			if (errno == EINTR) continue;
+			return;
+		}
+		if (fd >= r->nb_connexions) {
+			int taille = r->nb_connexions * 2;
+			while (taille <= fd) taille *= 2;
+			Connexion** tab = (Connexion**)realloc(r->connexions, sizeof(Connexion*) * taille);
+			if (!tab) {
+				close(fd);
+				continue;
+			}
+			memset(tab + r->nb_connexions, 0, sizeof(Connexion*) * (taille - r->nb_connexions));
+			r->connexions = tab;
+			r->nb_connexions = taille;
+		}
+
+		Connexion* c = (Connexion*)malloc(sizeof(Connexion));
+		if (!c) {
+			close(fd);
+			continue;
+		}
+		c->fd = fd;
+		c->numero = r->prochain_numero++;
+		c->ecoute_sortie = 0;
+		c->fermee = 0;
+		c->lecture_finie = 0;
+		c->en_cours = 0;
+		initTampon(&c->entree);
+		initTampon(&c->sortie);
+		c->envoye = 0;
+		r->connexions[fd] = c;
+
+		struct epoll_event ev;
+		ev.events = EPOLLIN;
+		ev.data.ptr = c;
+		epoll_ctl(r->epoll, EPOLL_CTL_ADD, fd, &ev);
+	}
+}
+
+/* Découpe les lignes complètes reçues et les transmet aux salles. */
+static void transmettreLignes(Reseau* r, Connexion* c) {
+	size_t debut = 0;
+	char* fin;
+	while ((fin = memchr(c->entree.donnees + debut, '\n', c->entree.taille - debut)) != NULL) {
+		char* ligne = c->entree.donnees + debut;
+		size_t longueur = (size_t)(fin - ligne);
+		debut += longueur + 1;
+		if (longueur > 0 && ligne[longueur - 1] == '\r') --longueur;
+		if (longueur == 0) continue;
+		ligne[longueur] = '\0';
+
+		if (envoyerLigneServeur(&r->serveur, ligne, identifiantClient(c))) {
+			++c->en_cours;
+		}
+		else {
+			Sortie s = sortieTampon(&c->sortie);
+			salleInexistante(&s, -1);
+		}
+	}
+	if (debut > 0) {
+		consommerTampon(&c->entree, debut);
+	}
+}
+
+static void lireConnexion(Reseau* r, Connexion* c) {
+	char tampon[TAILLE_LECTURE];
+	for (;;) {
+		ssize_t n = recv(c->fd, tampon, sizeof(tampon), 0);
+		if (n > 0) {
+			if (!ajouterTampon(&c->entree, tampon, (size_t)n)) {
+				fermerConnexion(r, c);
+				return;
+			}
+			/* les lignes sont transmises au fil de la lecture : seule une ligne trop longue
+			   peut faire grossir l’entrée, et elle est bornée même si le client écrit sans cesse */
+			if (memchr(tampon, '\n', (size_t)n)) {
+				transmettreLignes(r, c);
+			}
+			if (c->entree.taille > LIGNE_MAX) {
+				fermerConnexion(r, c);
+				return;
+			}
+			continue;
+		}
+		if (n < 0 && errno == EINTR) continue;
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+		/* fin de flux ou erreur : les lignes complètes sont tout de même traitées */
+		transmettreLignes(r, c);
+		if (n < 0) {
+			fermerConnexion(r, c);
+			return;
+		}
+		/* le client ne fait que fermer son sens d’écriture : ses réponses lui sont encore envoyées */
+		c->lecture_finie = 1;
+		if (ecrireConnexion(r, c)) {
+			surveiller(r, c, c->sortie.taille > 0);
+		}
+		return;
+	}
+
+	if (c->sortie.taille > c->envoye) {
+		ecrireConnexion(r, c);
+	}
+}
+
+static void distribuerReponses(Reseau* r) {
+	uint64_t compteur;
+	ssize_t lu = read(r->reveil, &compteur, sizeof(compteur));
+	(void)lu;
+
+	mtx_lock(&r->verrou);
+	Reponse* rep = r->tete;
+	r->tete = NULL;
+	r->queue = NULL;
+	mtx_unlock(&r->verrou);
+
+	/* les réponses d’une même connexion sont regroupées avant l’écriture */
+	Reponse* premiere = rep;
+	while (rep) {
+		int fd = (int)(uint32_t)rep->client;
+		uint32_t numero = (uint32_t)(rep->client >> 32);
+		Connexion* c = (fd < r->nb_connexions) ? r->connexions[fd] : NULL;
+		if (c && c->numero == numero && rep->acquittement) {
+			--c->en_cours;
+		}
+		else if (c && c->numero == numero) {
+			Sortie s = sortieTampon(&c->sortie);
+			imprimer(&s, "[salle %d]\n", rep->salle);
+			ajouterTampon(&c->sortie, rep->texte, rep->longueur);
+		}
+		rep = rep->suivant;
+	}
+
+	rep = premiere;
+	while (rep) {
+		Reponse* suivant = rep->suivant;
+		int fd = (int)(uint32_t)rep->client;
+		Connexion* c = (fd < r->nb_connexions) ? r->connexions[fd] : NULL;
+		if (c && c->numero == (uint32_t)(rep->client >> 32)
+			&& (c->sortie.taille > c->envoye || (c->lecture_finie && c->en_cours == 0))) {
+			ecrireConnexion(r, c);
+		}
+		free(rep);
+		rep = suivant;
+	}
+}
+
+static int ouvrirEcoute(const char* chemin) {
+	struct sockaddr_un adresse;
+	if (strlen(chemin) >= sizeof(adresse.sun_path)) return -1;
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (fd < 0) return -1;
+
+	memset(&adresse, 0, sizeof(adresse));
+	adresse.sun_family = AF_UNIX;
+	strcpy(adresse.sun_path, chemin);
+	unlink(chemin);
+	if (bind(fd, (struct sockaddr*)&adresse, sizeof(adresse)) < 0 || listen(fd, SOMAXCONN) < 0) {
+		close(fd);
+		return -1;
+	}
+	return fd;
+}
+
+/* libère ce que lancerReseau a ouvert, serveur déjà arrêté ou jamais démarré */
+static void fermerReseau(Reseau* r, const char* chemin) {
+	if (r->connexions) {
+		for (int fd = 0; fd < r->nb_connexions; ++fd) {
+			if (r->connexions[fd]) fermerConnexion(r, r->connexions[fd]);
+		}
+	}
+	libererFermees(r);
+	detruireVecteur(&r->fermees);
+	while (r->tete) {
+		Reponse* suivant = r->tete->suivant;
+		free(r->tete);
+		r->tete = suivant;
+	}
+	free(r->connexions);
+	if (r->epoll >= 0) close(r->epoll);
+	if (r->reveil >= 0) close(r->reveil);
+	if (r->ecoute >= 0) {
+		close(r->ecoute);
+		unlink(chemin);
+	}
+	mtx_destroy(&r->verrou);
+}
+
+int lancerReseau(const char* chemin, const char* fichier, int nb_travailleurs, int delai_ms) {
+	static int marque_ecoute, marque_reveil, marque_signal;
+	Reseau r;
+	memset(&r, 0, sizeof(r));
+	atomic_store(&arret_demande, 0);
+	mtx_init(&r.verrou, mtx_plain);
+
+	r.ecoute = ouvrirEcoute(chemin);
+	r.reveil = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	r.epoll = epoll_create1(EPOLL_CLOEXEC);
+	r.nb_connexions = 64;
+	r.connexions = (Connexion**)calloc(r.nb_connexions, sizeof(Connexion*));
+	initVecteur(&r.fermees, 8);
+	if (r.ecoute < 0 || r.reveil < 0 || r.epoll < 0 || !r.connexions
+		|| initServeur(&r.serveur, fichier, nb_travailleurs, graineHorloge(), delai_ms, repondreReseau, &r) != 0) {
+		perror("lancerReseau");
+		fermerReseau(&r, chemin);
+		return -1;
+	}
+	r.serveur.acquitter = acquitterReseau;
+
+	struct epoll_event ev;
+	ev.events = EPOLLIN;
+	ev.data.ptr = &marque_ecoute;
+	epoll_ctl(r.epoll, EPOLL_CTL_ADD, r.ecoute, &ev);
+	ev.data.ptr = &marque_reveil;
+	epoll_ctl(r.epoll, EPOLL_CTL_ADD, r.reveil, &ev);
+
+	if (atomic_load(&reveil_signal) < 0) {
+		atomic_store(&reveil_signal, eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC));
+	}
+	int fd_signal = atomic_load(&reveil_signal);
+	if (fd_signal >= 0) {
+		uint64_t compteur;
+		ssize_t lu = read(fd_signal, &compteur, sizeof(compteur));
+		(void)lu;
+		ev.data.ptr = &marque_signal;
+		epoll_ctl(r.epoll, EPOLL_CTL_ADD, fd_signal, &ev);
+	}
+	struct sigaction action;
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = demanderArret;
+	sigaction(SIGINT, &action, NULL);
+	sigaction(SIGTERM, &action, NULL);
+
+	struct epoll_event evenements[NB_EVENEMENTS];
+	while (!atomic_load(&arret_demande)) {
+		int n = epoll_wait(r.epoll, evenements, NB_EVENEMENTS, -1);
+		if (n < 0) {
+			if (errno == EINTR) continue;
+			break;
+		}
+		for (int i = 0; i < n; ++i) {
+			void* cible = evenements[i].data.ptr;
+			if (cible == &marque_ecoute) {
+				accepterConnexions(&r);
+			}
+			else if (cible == &marque_reveil) {
+				distribuerReponses(&r);
+			}
+			else if (cible == &marque_signal) {
+				/* l’indicateur est relu en haut de la boucle */
+				uint64_t compteur;
+				ssize_t lu = read(fd_signal, &compteur, sizeof(compteur));
+				(void)lu;
+			}
+			else {
+				Connexion* c = (Connexion*)cible;
+				uint32_t e = evenements[i].events;
+				if (c->fermee) continue;
+				if (e & EPOLLOUT) {
+					if (!ecrireConnexion(&r, c)) continue;
+				}
+				if (c->lecture_finie) {
+					/* le client est parti : ses réponses ne peuvent plus lui parvenir */
+					if (e & (EPOLLHUP | EPOLLERR)) fermerConnexion(&r, c);
+				}
+				else if (e & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+					lireConnexion(&r, c);
+				}
+			}
+		}
+		libererFermees(&r);
+	}
+
+	arreterServeur(&r.serveur);
+	afficherStatistiquesCache(sortieStandard(), &r.serveur.stats_cache);
+	afficherMemoire(sortieStandard());
+	fermerReseau(&r, chemin);
+	return 0;
+}
+
+static double secondes(void) {
+	struct timespec ts;
+	timespec_get(&ts, TIME_UTC);
+	return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int chargeReseau(const char* chemin, int nb_salles, int nb_lignes) {
+	static const char* coups[] = { "KI", "NI", "SOMA", "LO", "MANI" };
+	struct sockaddr_un adresse;
+	if (nb_salles < 1 || strlen(chemin) >= sizeof(adresse.sun_path)) return -1;
+
+	int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	memset(&adresse, 0, sizeof(adresse));
+	adresse.sun_family = AF_UNIX;
+	strcpy(adresse.sun_path, chemin);
+	if (fd < 0 || connect(fd, (struct sockaddr*)&adresse, sizeof(adresse)) < 0) {
+		perror("chargeReseau");
+		if (fd >= 0) close(fd);
+		return -1;
+	}
+	fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+	Tampon envoi;
+	initTampon(&envoi);
+	Sortie s = sortieTampon(&envoi);
+	for (int i = 0; i < nb_salles; ++i) {
+		imprimer(&s, "%d ouvrir a b\n", i);
+	}
+	for (int i = 0; i < nb_lignes; ++i) {
+		imprimer(&s, "%d %c %s\n", i % nb_salles, (i / nb_salles) % 2 ? 'b' : 'a', coups[i % 5]);
+	}
+	for (int i = 0; i < nb_salles; ++i) {
+		imprimer(&s, "%d fermer\n", i);
+	}
+
+	long attendues = 2L * nb_salles + nb_lignes;
+	long recues = 0;
+	size_t envoye = 0;
+	const char* entete = "[salle ";
+	int correspondance = 0;
+	int debut_ligne = 1;
+	char tampon[TAILLE_LECTURE];
+	double debut = secondes();
+
+	while (recues < attendues) {
+		struct pollfd p = { fd, POLLIN | (envoye < envoi.taille ? POLLOUT : 0), 0 };
+		if (poll(&p, 1, 5000) <= 0) break;
+		if ((p.revents & POLLOUT) && envoye < envoi.taille) {
+			ssize_t n = send(fd, envoi.donnees + envoye, envoi.taille - envoye, MSG_NOSIGNAL);
+			if (n > 0) envoye += (size_t)n;
+		}
+		if (p.revents & (POLLIN | POLLHUP)) {
+			ssize_t n = recv(fd, tampon, sizeof(tampon), 0);
+			if (n <= 0) break;
+			/* compte les en-têtes « [salle » en début de ligne, même coupés entre deux lectures */
+			for (ssize_t i = 0; i < n; ++i) {
+				char ch = tampon[i];
+				if (debut_ligne || correspondance > 0) {
+					if (ch == entete[correspondance]) {
+						if (entete[++correspondance] == '\0') {
+							++recues;
+							correspondance = 0;
+						}
+					}
+					else {
+						correspondance = 0;
+					}
+				}
+				debut_ligne = (ch == '\n');
+			}
+		}
+	}
+
+	double duree = secondes() - debut;
+	printf("%ld/%ld reponses, %d lignes en %.3f s (%.0f lignes/s)\n",
+		recues, attendues, nb_lignes + 2 * nb_salles, duree, (nb_lignes + 2 * nb_salles) / duree);
+	detruireTampon(&envoi);
+	close(fd);
+	return recues == attendues ? 0 : -1;
+}
+
+#else
+
+int lancerReseau(const char* chemin, const char* fichier, int nb_travailleurs, int delai_ms) {
+	(void)chemin; (void)fichier; (void)nb_travailleurs; (void)delai_ms;
+	fprintf(stderr, "Le frontal reseau n'est disponible que sous Linux\n");
+	return -1;
+}
+
+int chargeReseau(const char* chemin, int nb_salles, int nb_lignes) {
+	(void)chemin; (void)nb_salles; (void)nb_lignes;
+	fprintf(stderr, "Le frontal reseau n'est disponible que sous Linux\n");
+	return -1;
+}
+
+#endif
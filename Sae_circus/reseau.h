@@ -0,0 +1,51 @@
+/**
+ * @file reseau.h
+ * @brief Frontal réseau du mode serveur : socket Unix locale et boucle d’événements epoll.
+ *
+ * Un seul thread accepte les connexions, lit les lignes `<salle> ...` de tous les
+ * clients, les découpe et les transmet aux salles (voir `serveur.h`). Les réponses
+ * des salles reviennent par une file commune réveillant la boucle (eventfd), puis
+ * sont copiées dans le tampon d’écriture de la connexion émettrice et envoyées
+ * sans jamais bloquer.
+ *
+ * Un client qui ferme son sens d’écriture (`shutdown(SHUT_WR)`) reçoit encore les
+ * réponses à toutes ses lignes : chaque ligne transmise est acquittée par son
+ * travailleur après sa réponse, et la connexion n’est fermée qu’une fois toutes
+ * ses lignes acquittées et leurs réponses envoyées.
+ *
+ * Disponible sous Linux uniquement ; ailleurs les fonctions retournent `-1`.
+ */
+
+#pragma once
+#pragma warning(push)
+#pragma warning(disable:4996)
+
+#include "serveur.h"
+
+/**
+ * @brief Lance le serveur multi-salles derrière une socket Unix.
+ *
+ * La boucle tourne jusqu’à la réception de SIGINT ou SIGTERM, par n’importe quel
+ * thread du processus ; les salles encore ouvertes sont alors fermées.
+ *
+ * @param[in] chemin Chemin de la socket (un fichier existant est remplacé).
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] nb_travailleurs Nombre de threads du pool.
+ * @param[in] delai_ms Durée maximale d’un tour (ms), `0` sans limite.
+ * @return `0` à l’arrêt normal, `-1` en cas d’erreur (tout ce qui a été ouvert est alors libéré).
+ */
+int lancerReseau(const char* chemin, const char* fichier, int nb_travailleurs, int delai_ms);
+
+/**
+ * @brief Client de test : ouvre des salles puis envoie des coups et mesure le débit.
+ *
+ * Le client ouvre `nb_salles` salles, envoie `nb_lignes` coups répartis sur ces salles,
+ * ferme les salles et attend toutes les réponses. Le débit (lignes par seconde)
+ * est affiché sur `stdout`.
+ *
+ * @param[in] chemin Chemin de la socket du serveur.
+ * @param[in] nb_salles Nombre de salles à ouvrir.
+ * @param[in] nb_lignes Nombre de coups à envoyer.
+ * @return `0` si toutes les réponses ont été reçues, `-1` sinon.
+ */
+int chargeReseau(const char* chemin, int nb_salles, int nb_lignes);
@@ -0,0 +1,223 @@
+#include "robot.h"
+#include "minuterie.h"
+#include "trace.h"
+
+
+void coupAuHasard(Aleatoire* alea, int n, const Commandes* commandes, Sequence* coup) {
+	viderSequence(coup);
+	int64_t longueur = 1 + (int64_t)aleatoireBorne(alea, (uint64_t)n + 1);
+	for (int64_t i = 0; i < longueur && commandes->nbElements > 0; ++i) {
+		const Commande* c = &commandes->elements[aleatoireBorne(alea, (uint64_t)commandes->nbElements)];
+		int code = codeCommande(c->nom_commande.texte);
+		if (code >= 0) ajouterSequence(coup, (uint8_t)code);
+	}
+}
+
+int calculerCoupRobot(TableDistances* table, Aleatoire* alea, int niveau, CleEtat depart, CleEtat cible,
+	int n, const Commandes* commandes, Sequence* coup) {
+	if (niveau > 0 && table->cles && depart != cible) {
+		calculerDistances(table, cible, n, commandes, niveau);
+		if (cheminOptimal(table, depart, coup)) return 1;
+	}
+	/* hors de portée : quelques commandes autorisées au hasard */
+	coupAuHasard(alea, n, commandes, coup);
+	return 0;
+}
+
+/* « nom commandes » */
+static char* ecrireCoup(const char* nom, const Sequence* coup) {
+	size_t longueur = strlen(nom);
+	char* ligne = (char*)malloc(longueur + 2 + 2 * (size_t)coup->nbElements);
+	if (!ligne) return NULL;
+	memcpy(ligne, nom, longueur);
+	ligne[longueur++] = ' ';
+	for (int64_t i = 0; i < coup->nbElements; ++i) {
+		memcpy(&ligne[longueur], nomCommande(coup->elements[i]), 2);
+		longueur += 2;
+	}
+	ligne[longueur] = '\0';
+	return ligne;
+}
+
+static void libererDemande(DemandeRobot* d) {
+	relacherConfig(d->config);
+	free(d->ligne);
+	free(d);
+}
+
+/* insère un coup calculé dans la file triée par échéance */
+static void rangerPret(MoteurRobots* m, DemandeRobot* d) {
+	DemandeRobot** lien = &m->prets;
+	while (*lien && (*lien)->echeance <= d->echeance) {
+		lien = &(*lien)->suivant;
+	}
+	d->suivant = *lien;
+	*lien = d;
+}
+
+static void attendreJusqua(MoteurRobots* m, uint64_t echeance) {
+	uint64_t maintenant = maintenantMs();
+	if (echeance <= maintenant) return;
+	uint64_t delai = echeance - maintenant;
+
+	struct timespec limite;
+	timespec_get(&limite, TIME_UTC);
+	limite.tv_sec += (time_t)(delai / 1000);
+	limite.tv_nsec += (long)(delai % 1000) * 1000000L;
+	if (limite.tv_nsec >= 1000000000L) {
+		++limite.tv_sec;
+		limite.tv_nsec -= 1000000000L;
+	}
+	cnd_timedwait(&m->signal, &m->verrou, &limite);
+}
+
+static int boucleRobot(void* arg) {
+	MoteurRobots* m = (MoteurRobots*)arg;
+	nommerFilTrace("robot");
+	/* sans mémoire pour la table (table.cles == NULL), le robot joue au hasard */
+	TableDistances table;
+	initTableDistances(&table, MAX_ETATS_DISTANCE);
+	Sequence coup;
+	initSequence(&coup, 16);
+
+	mtx_lock(&m->verrou);
+	Aleatoire alea;
+	initAleatoire(&alea, m->graine);
+	m->graine = aleatoireSuivant(&alea);
+
+	while (!m->arret) {
+		if (m->prets && m->prets->echeance <= maintenantMs()) {
+			DemandeRobot* d = m->prets;
+			m->prets = d->suivant;
+			mtx_unlock(&m->verrou);
+			m->envoyer(m->contexte, d->salle, d->tour, d->ligne);
+			libererDemande(d);
+			mtx_lock(&m->verrou);
+		}
+		else if (m->tete) {
+			DemandeRobot* d = m->tete;
+			m->tete = d->suivant;
+			if (!m->tete) m->queue = NULL;
+			mtx_unlock(&m->verrou);
+
+			const Commandes* commandes = d->config ? d->config->modele.commandes : m->commandes;
+			debutTrace("coup robot");
+			calculerCoupRobot(&table, &alea, d->niveau, d->depart, d->cible, d->n, commandes, &coup);
+			d->ligne = ecrireCoup(d->nom, &coup);
+			finTrace("coup robot");
+
+			mtx_lock(&m->verrou);
+			if (d->ligne) {
+				rangerPret(m, d);
+				/* un autre fil attend peut-être une échéance plus lointaine */
+				cnd_broadcast(&m->signal);
+			}
+			else {
+				libererDemande(d);
+			}
+		}
+		else if (m->prets) {
+			attendreJusqua(m, m->prets->echeance);
+		}
+		else {
+			cnd_wait(&m->signal, &m->verrou);
+		}
+	}
+	mtx_unlock(&m->verrou);
+
+	detruireSequence(&coup);
+	detruireTableDistances(&table);
+	return 0;
+}
+
+int demarrerRobots(MoteurRobots* moteur, int nb_fils, const Commandes* commandes,
+	EnvoyerRobot envoyer, void* contexte, uint64_t graine) {
+	moteur->tete = NULL;
+	moteur->queue = NULL;
+	moteur->prets = NULL;
+	moteur->arret = 0;
+	moteur->graine = graine;
+	moteur->commandes = commandes;
+	moteur->envoyer = envoyer;
+	moteur->contexte = contexte;
+	moteur->nb_fils = 0;
+	moteur->fils = (thrd_t*)malloc(sizeof(thrd_t) * (size_t)nb_fils);
+	if (!moteur->fils) return 0;
+	mtx_init(&moteur->verrou, mtx_plain);
+	cnd_init(&moteur->signal);
+
+	for (int i = 0; i < nb_fils; ++i) {
+		if (thrd_create(&moteur->fils[i], boucleRobot, moteur) != thrd_success) {
+			arreterRobots(moteur);
+			detruireRobots(moteur);
+			return 0;
+		}
+		++moteur->nb_fils;
+	}
+	return 1;
+}
+
+void solliciterRobot(MoteurRobots* moteur, int salle, const Robot* robot, CleEtat depart, CleEtat cible,
+	int n, uint64_t tour, uint64_t debut_tour, ConfigPartagee* config) {
+	DemandeRobot* d = (DemandeRobot*)malloc(sizeof(DemandeRobot) + robot->nom.longueur + 1);
+	if (!d) return;
+	d->salle = salle;
+	d->tour = tour;
+	d->niveau = robot->niveau;
+	d->n = n;
+	d->depart = depart;
+	d->cible = cible;
+	d->echeance = debut_tour + (uint64_t)(robot->budget_ms > 0 ? robot->budget_ms : 0);
+	d->config = config;
+	d->ligne = NULL;
+	d->suivant = NULL;
+	if (config) retenirConfig(config);
+	memcpy(d->nom, robot->nom.texte, robot->nom.longueur + 1);
+
+	mtx_lock(&moteur->verrou);
+	if (moteur->arret) {
+		mtx_unlock(&moteur->verrou);
+		libererDemande(d);
+		return;
+	}
+	if (moteur->queue) {
+		moteur->queue->suivant = d;
+	}
+	else {
+		moteur->tete = d;
+	}
+	moteur->queue = d;
+	mtx_unlock(&moteur->verrou);
+	cnd_signal(&moteur->signal);
+}
+
+void arreterRobots(MoteurRobots* moteur) {
+	mtx_lock(&moteur->verrou);
+	moteur->arret = 1;
+	mtx_unlock(&moteur->verrou);
+	cnd_broadcast(&moteur->signal);
+	for (int i = 0; i < moteur->nb_fils; ++i) {
+		thrd_join(moteur->fils[i], NULL);
+	}
+	moteur->nb_fils = 0;
+}
+
+static void libererDemandes(DemandeRobot* d) {
+	while (d) {
+		DemandeRobot* suivant = d->suivant;
+		libererDemande(d);
+		d = suivant;
+	}
+}
+
+void detruireRobots(MoteurRobots* moteur) {
+	libererDemandes(moteur->tete);
+	libererDemandes(moteur->prets);
+	moteur->tete = NULL;
+	moteur->queue = NULL;
+	moteur->prets = NULL;
+	free(moteur->fils);
+	moteur->fils = NULL;
+	cnd_destroy(&moteur->signal);
+	mtx_destroy(&moteur->verrou);
+}
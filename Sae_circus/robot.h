@@ -0,0 +1,158 @@
+/**
+ * @file robot.h
+ * @brief Joueurs automatiques (robots) dont les coups sont calculés sur des threads dédiés.
+ *
+ * Un robot est un joueur ordinaire de la partie : ses coups sont des lignes
+ * « nom commandes » envoyées par le même chemin que celles des humains. Au début
+ * de chaque tour, le propriétaire de la partie sollicite ses robots ; un fil du
+ * moteur calcule le coup sans toucher à la partie (seules la situation de départ
+ * et la cible sont transmises), puis l’envoie à l’échéance fixée par le budget
+ * du robot. Le propriétaire n’est donc jamais bloqué par le calcul. Chaque coup
+ * porte le numéro du tour pour lequel il a été calculé : un coup arrivé après la
+ * fin de son tour doit être écarté par le propriétaire.
+ *
+ * Le niveau d’un robot est la profondeur de sa recherche : un robot de niveau k
+ * joue une solution optimale si la cible est à au plus k commandes, et une
+ * suite de commandes au hasard sinon (niveau 0 : toujours au hasard).
+ */
+
+#pragma once
+
+#include <threads.h>
+#include "distance.h"
+#include "aleatoire.h"
+#include "rechargement.h"
+
+/** @brief Nombre de fils de calcul du moteur d’un serveur. */
+enum { NB_FILS_ROBOTS = 2 };
+
+/**
+ * @brief Robot inscrit dans une partie.
+ */
+typedef struct {
+    Nom nom;        /**< Nom du joueur (interné dans la partie). */
+    int niveau;     /**< Profondeur maximale de la recherche (`0` : coups au hasard). */
+    int budget_ms;  /**< Délai de réponse après le début du tour (ms). */
+} Robot;
+
+VECTEUR_DEF(VecteurRobot, Robot)
+
+/**
+ * @brief Fonction recevant le coup d’un robot (« nom commandes ») pour une salle.
+ *
+ * `tour` est celui passé à `solliciterRobot` : le destinataire écarte le coup si
+ * la salle est passée à un autre tour avant son échéance.
+ */
+typedef void (*EnvoyerRobot)(void* contexte, int salle, uint64_t tour, const char* ligne);
+
+/**
+ * @brief Demande de coup, puis coup calculé en attente de son échéance.
+ */
+typedef struct DemandeRobot {
+    int salle;                   /**< Identifiant transmis à `EnvoyerRobot`. */
+    uint64_t tour;               /**< Tour pour lequel le coup est calculé, transmis à `EnvoyerRobot`. */
+    int niveau;
+    int n;                       /**< Nombre d’animaux. */
+    CleEtat depart;
+    CleEtat cible;
+    uint64_t echeance;           /**< Heure d’envoi du coup (ms, horloge monotone). */
+    ConfigPartagee* config;      /**< Configuration de la salle (référence retenue), ou `NULL` pour les commandes du moteur. */
+    char* ligne;                 /**< Coup calculé, `NULL` tant qu’il ne l’est pas. */
+    struct DemandeRobot* suivant;
+    char nom[];                  /**< Copie du nom du robot. */
+} DemandeRobot;
+
+/**
+ * @brief Moteur de robots : fils de calcul et files de demandes.
+ */
+typedef struct {
+    thrd_t* fils;
+    int nb_fils;
+    mtx_t verrou;               /**< Protège les files, `arret` et `graine`. */
+    cnd_t signal;               /**< Signalé à l’arrivée d’une demande, d’un coup calculé ou à l’arrêt. */
+    DemandeRobot* tete;         /**< Demandes à calculer, dans l’ordre d’arrivée. */
+    DemandeRobot* queue;
+    DemandeRobot* prets;        /**< Coups calculés, par échéance croissante. */
+    int arret;
+    uint64_t graine;            /**< Graine du prochain fil démarré. */
+    const Commandes* commandes; /**< Commandes autorisées (configuration partagée, en lecture seule). */
+    EnvoyerRobot envoyer;
+    void* contexte;             /**< Contexte transmis à `envoyer`. */
+} MoteurRobots;
+
+/**
+ * @brief Tire un coup au hasard : 1 à n + 1 commandes autorisées.
+ *
+ * @param[in,out] alea Générateur.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] commandes Commandes autorisées.
+ * @param[out] coup Séquence vidée puis remplie.
+ */
+void coupAuHasard(Aleatoire* alea, int n, const Commandes* commandes, Sequence* coup);
+
+/**
+ * @brief Calcule le coup d’un robot.
+ *
+ * @param[in,out] table Table de distances de travail (ou table non allouée : coups au hasard).
+ * @param[in,out] alea Générateur des coups au hasard.
+ * @param[in] niveau Niveau du robot.
+ * @param[in] depart Situation de départ.
+ * @param[in] cible Situation cible.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] commandes Commandes autorisées.
+ * @param[out] coup Séquence vidée puis remplie (au moins une commande).
+ * @return `1` si le coup est une solution optimale, `0` s’il est joué au hasard.
+ */
+int calculerCoupRobot(TableDistances* table, Aleatoire* alea, int niveau, CleEtat depart, CleEtat cible,
+    int n, const Commandes* commandes, Sequence* coup);
+
+/**
+ * @brief Démarre les fils d’un moteur de robots.
+ *
+ * @param[out] moteur Moteur à démarrer.
+ * @param[in] nb_fils Nombre de fils de calcul.
+ * @param[in] commandes Commandes autorisées par défaut (doivent rester valides jusqu’à `arreterRobots`),
+ *                      ou `NULL` si chaque demande apporte sa configuration.
+ * @param[in] envoyer Fonction recevant les coups.
+ * @param[in] contexte Contexte transmis à `envoyer`.
+ * @param[in] graine Graine des coups au hasard.
+ * @return `1` si le démarrage réussit, `0` sinon (le moteur n’a alors rien à libérer).
+ * @pre `nb_fils >= 1`.
+ */
+int demarrerRobots(MoteurRobots* moteur, int nb_fils, const Commandes* commandes,
+    EnvoyerRobot envoyer, void* contexte, uint64_t graine);
+
+/**
+ * @brief Demande le coup d’un robot pour le tour qui vient de commencer.
+ *
+ * L’appel ne bloque que le temps d’ajouter la demande ; il est sans effet après `arreterRobots`.
+ *
+ * @param[in,out] moteur Moteur.
+ * @param[in] salle Identifiant transmis à `envoyer` avec le coup.
+ * @param[in] robot Robot qui doit jouer.
+ * @param[in] depart Situation de départ du tour.
+ * @param[in] cible Situation cible du tour.
+ * @param[in] n Nombre d’animaux.
+ * @param[in] tour Numéro du tour, transmis à `envoyer` avec le coup.
+ * @param[in] debut_tour Heure du début du tour (ms), à laquelle s’ajoute le budget du robot.
+ * @param[in,out] config Configuration de la salle, retenue jusqu’à l’envoi du coup, ou `NULL`
+ *                pour les commandes passées à `demarrerRobots`.
+ */
+void solliciterRobot(MoteurRobots* moteur, int salle, const Robot* robot, CleEtat depart, CleEtat cible,
+    int n, uint64_t tour, uint64_t debut_tour, ConfigPartagee* config);
+
+/**
+ * @brief Arrête les fils du moteur ; les coups pas encore envoyés sont abandonnés.
+ *
+ * Après l’arrêt, `envoyer` n’est plus appelée et `solliciterRobot` peut encore être appelée.
+ *
+ * @param[in,out] moteur Moteur.
+ */
+void arreterRobots(MoteurRobots* moteur);
+
+/**
+ * @brief Libère un moteur arrêté.
+ *
+ * @param[in,out] moteur Moteur arrêté par `arreterRobots`, que plus personne ne sollicite.
+ */
+void detruireRobots(MoteurRobots* moteur);
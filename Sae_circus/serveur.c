@@ -0,0 +1,455 @@
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "serveur.h"
+#include "trace.h"
+
+
+static Salle* trouverSalle(Travailleur* t, int id, int* position) {
+	for (int i = 0; i < t->salles.nbElements; ++i) {
+		Salle* salle = obtenir(&t->salles, i);
+		if (salle->id == id) {
+			if (position) *position = i;
+			return salle;
+		}
+	}
+	return NULL;
+}
+
+static void libererSalle(Salle* salle) {
+	detruireVecteurRobot(&salle->robots);
+	detruireGame(&salle->game);
+	relacherConfig(salle->config);
+	relacherConfig(salle->config_suivante);
+	free(salle);
+}
+
+/* les résultats du cache ne valent que pour les commandes d’une configuration */
+static void brancherCache(Travailleur* t, Salle* salle) {
+	uint64_t generation = salle->config->generation;
+	if (generation > t->generation_cache) {
+		viderCache(&t->cache);
+		t->generation_cache = generation;
+	}
+	salle->game.cache = t->cache.entrees && generation == t->generation_cache ? &t->cache : NULL;
+}
+
+/* à appeler avant et après chaque traitement d’une salle : suit la dernière configuration
+   publiée, adoptée à la prochaine distribution ; renvoie 1 si la salle vient de l’adopter */
+static int suivreConfig(Travailleur* t, Salle* salle) {
+	int adoptee = 0;
+	if (salle->config_suivante && !salle->game.modele_suivant) {
+		relacherConfig(salle->config);
+		salle->config = salle->config_suivante;
+		salle->config_suivante = NULL;
+		adoptee = 1;
+	}
+	Rechargeur* r = &t->serveur->config;
+	const ConfigPartagee* attendue = salle->config_suivante ? salle->config_suivante : salle->config;
+	if (generationConfig(r) != attendue->generation) {
+		ConfigPartagee* config = acquerirConfig(r);
+		relacherConfig(salle->config_suivante);
+		salle->config_suivante = config;
+		changerModele(&salle->game, &config->modele);
+	}
+	brancherCache(t, salle);
+	return adoptee;
+}
+
+static void repondre(Travailleur* t, int64_t client, int salle);
+
+/* au début d’un tour, demande leur coup aux robots de la salle */
+static void solliciterRobots(Travailleur* t, Salle* salle) {
+	Game* game = &salle->game;
+	if (salle->robots.nbElements == 0 || salle->tour_robots == game->numero_tour
+		|| game->cle_cible == CLE_INVALIDE || !t->serveur->robots_demarres) {
+		return;
+	}
+	salle->tour_robots = game->numero_tour;
+	CleEtat depart = empaqueterPodiums(game->podium_b, game->podium_r);
+	for (int64_t i = 0; i < salle->robots.nbElements; ++i) {
+		solliciterRobot(&t->serveur->robots, salle->id, &salle->robots.elements[i], depart, game->cle_cible,
+			(int)game->animaux->nbElements, game->numero_tour, game->debut_tour, salle->config);
+	}
+}
+
+static void expirerSalle(void* contexte) {
+	Salle* salle = (Salle*)contexte;
+	Travailleur* t = salle->travailleur;
+	suivreConfig(t, salle);
+	expirerTour(&salle->game);
+	if (suivreConfig(t, salle)) {
+		CommandesPresentes(&t->sortie, salle->game.commandes);
+	}
+	afficherPodiums(&t->sortie, salle->game.animaux, salle->game.podium_b, salle->game.podium_r,
+		salle->game.target_b, salle->game.target_r);
+	repondre(t, salle->dernier_client, salle->id);
+	solliciterRobots(t, salle);
+}
+
+/* « +nom:niveau:budget_ms » : retire le préfixe du nom et ajoute le robot à `robots` */
+static void lireRobot(char* mot, VecteurRobot* robots) {
+	if (mot[0] != '+') return;
+	memmove(mot, mot + 1, strlen(mot));
+	Robot robot = { { NULL, 0, 0 }, 1, 0 };
+	char* separateur = strchr(mot, ':');
+	if (separateur) {
+		*separateur = '\0';
+		char* fin = NULL;
+		robot.niveau = (int)strtol(separateur + 1, &fin, 10);
+		if (*fin == ':') robot.budget_ms = (int)strtol(fin + 1, NULL, 10);
+	}
+	/* le nom sera celui interné dans la partie */
+	robot.nom.texte = mot;
+	ajouterVecteurRobot(robots, robot);
+}
+
+static void ouvrirSalle(Travailleur* t, int64_t client, int id, char* noms_ligne) {
+	if (trouverSalle(t, id, NULL)) {
+		salleDejaOuverte(&t->sortie, id);
+		return;
+	}
+
+	int nb_joueurs = 0;
+	char** noms = splitLineAndCount(noms_ligne, &nb_joueurs);
+	VecteurRobot robots;
+	initVecteurRobot(&robots, 0);
+	for (int i = 0; i < nb_joueurs; ++i) {
+		lireRobot(noms[i], &robots);
+	}
+	if (nb_joueurs < 2) {
+		pasAssesDesJoueurs(&t->sortie);
+	}
+	else {
+		Serveur* serveur = t->serveur;
+		Salle* salle = (Salle*)malloc(sizeof(Salle));
+		if (!salle) {
+			detruireVecteurRobot(&robots);
+			libererMots(noms, nb_joueurs);
+			return;
+		}
+		uint64_t graine = serveur->graine ^ ((uint64_t)id * 0x9E3779B97F4A7C15ULL);
+		salle->id = id;
+		salle->travailleur = t;
+		salle->dernier_client = client;
+		salle->robots = robots;
+		salle->tour_robots = 0;
+		salle->config = acquerirConfig(&serveur->config);
+		salle->config_suivante = NULL;
+		initVecteurRobot(&robots, 0);
+		if (initGamePartagee(&salle->game, &salle->config->modele, nb_joueurs, noms, graine) == 0) {
+			salle->game.sortie = &t->sortie;
+			brancherCache(t, salle);
+			if (serveur->analyses) {
+				attacherAnalyses(&salle->game, serveur->analyses, id);
+			}
+			if (serveur->delai_ms > 0) {
+				salle->game.echeance.rappel = expirerSalle;
+				salle->game.echeance.contexte = salle;
+				attacherMinuterie(&salle->game, &t->roue, serveur->delai_ms);
+			}
+			for (int64_t i = 0; i < salle->robots.nbElements; ++i) {
+				Robot* robot = &salle->robots.elements[i];
+				robot->nom = obtenirJoueurParNom(salle->game.joueurs, robot->nom.texte)->nom;
+			}
+			ajouter(&t->salles, salle);
+			solliciterRobots(t, salle);
+			CommandesPresentes(&t->sortie, salle->game.commandes);
+			afficherPodiums(&t->sortie, salle->game.animaux, salle->game.podium_b, salle->game.podium_r,
+				salle->game.target_b, salle->game.target_r);
+		}
+		else {
+			libererSalle(salle);
+		}
+	}
+
+	detruireVecteurRobot(&robots);
+	libererMots(noms, nb_joueurs);
+}
+
+static void fermerSalle(Travailleur* t, Salle* salle, int position) {
+	afficherResultats(&t->sortie, salle->game.joueurs);
+	if (salle->game.delai_ms > 0) {
+		afficherLatences(&t->sortie, salle->game.joueurs);
+	}
+	supprimer(&t->salles, position);
+	libererSalle(salle);
+}
+
+static int estMot(const char* texte, size_t longueur, const char* mot) {
+	return longueur == strlen(mot) && strncmp(texte, mot, longueur) == 0;
+}
+
+static void repondre(Travailleur* t, int64_t client, int salle) {
+	if (t->reponse.taille > 0) {
+		t->serveur->repondre(t->serveur->contexte, client, salle, t->reponse.donnees, t->reponse.taille);
+		t->reponse.taille = 0;
+	}
+}
+
+static void traiterMessage(Travailleur* t, Message* m) {
+	char* reste = m->ligne + strspn(m->ligne, " \t");
+	size_t longueur = strcspn(reste, " \t");
+	int position = 0;
+	Salle* salle = trouverSalle(t, m->salle, &position);
+
+	/* coup d’un robot calculé pour un tour déjà terminé : il n’a plus de sens */
+	if (m->tour >= 0 && (!salle || (uint64_t)m->tour != salle->game.numero_tour)) {
+		return;
+	}
+	/* les coups des robots (client -1) ne détournent pas les réponses spontanées */
+	if (salle && m->client >= 0) {
+		salle->dernier_client = m->client;
+	}
+	if (estMot(reste, longueur, "ouvrir")) {
+		ouvrirSalle(t, m->client, m->salle, reste + longueur);
+	}
+	else if (salle == NULL) {
+		salleInexistante(&t->sortie, m->salle);
+	}
+	else if (estMot(reste, longueur, "fermer")) {
+		fermerSalle(t, salle, position);
+	}
+	else {
+		suivreConfig(t, salle);
+		traiterLigne(&salle->game, reste);
+		if (suivreConfig(t, salle)) {
+			CommandesPresentes(&t->sortie, salle->game.commandes);
+		}
+		afficherPodiums(&t->sortie, salle->game.animaux, salle->game.podium_b, salle->game.podium_r,
+			salle->game.target_b, salle->game.target_r);
+	}
+	repondre(t, m->client, m->salle);
+	/* la salle a pu être fermée : on la cherche de nouveau */
+	salle = trouverSalle(t, m->salle, NULL);
+	if (salle) {
+		solliciterRobots(t, salle);
+	}
+}
+
+static int boucleTravailleur(void* arg) {
+	Travailleur* t = (Travailleur*)arg;
+	int arret = 0;
+	nommerFilTrace("travailleur");
+
+	while (!arret) {
+		mtx_lock(&t->verrou);
+		while (t->tete == NULL && !t->arret) {
+			int64_t delai = delaiRoue(&t->roue, maintenantMs());
+			if (delai < 0) {
+				cnd_wait(&t->signal, &t->verrou);
+				continue;
+			}
+			if (delai == 0) break;
+
+			struct timespec limite;
+			timespec_get(&limite, TIME_UTC);
+			limite.tv_sec += delai / 1000;
+			limite.tv_nsec += (long)(delai % 1000) * 1000000L;
+			if (limite.tv_nsec >= 1000000000L) {
+				++limite.tv_sec;
+				limite.tv_nsec -= 1000000000L;
+			}
+			if (cnd_timedwait(&t->signal, &t->verrou, &limite) == thrd_timedout) break;
+		}
+		Message* lot = t->tete;
+		t->tete = NULL;
+		t->queue = NULL;
+		arret = t->arret && lot == NULL;
+		mtx_unlock(&t->verrou);
+
+		/* les tours expirés sont redistribués avant de traiter les coups arrivés ensuite */
+		debutTrace("expirations");
+		avancerRoue(&t->roue, maintenantMs());
+		finTrace("expirations");
+
+		while (lot) {
+			Message* suivant = lot->suivant;
+			debutTrace("message");
+			traiterMessage(t, lot);
+			finTrace("message");
+			if (lot->client >= 0 && t->serveur->acquitter) {
+				t->serveur->acquitter(t->serveur->contexte, lot->client);
+			}
+			free(lot->ligne);
+			free(lot);
+			lot = suivant;
+		}
+	}
+
+	while (t->salles.nbElements > 0) {
+		Salle* salle = obtenir(&t->salles, t->salles.nbElements - 1);
+		int id = salle->id;
+		fermerSalle(t, salle, t->salles.nbElements - 1);
+		repondre(t, -1, id);
+	}
+	return 0;
+}
+
+/* ajoute un message à la file du travailleur de sa salle */
+static int deposerMessage(Serveur* serveur, int salle, int64_t client, int64_t tour, const char* ligne) {
+	Message* m = (Message*)malloc(sizeof(Message));
+	if (!m) return 0;
+	m->salle = salle;
+	m->client = client;
+	m->tour = tour;
+	m->ligne = strdup(ligne);
+	m->suivant = NULL;
+	if (!m->ligne) {
+		free(m);
+		return 0;
+	}
+
+	Travailleur* t = &serveur->travailleurs[m->salle % serveur->nb_travailleurs];
+	mtx_lock(&t->verrou);
+	if (t->queue) {
+		t->queue->suivant = m;
+	}
+	else {
+		t->tete = m;
+	}
+	t->queue = m;
+	mtx_unlock(&t->verrou);
+	cnd_signal(&t->signal);
+	return 1;
+}
+
+/* coup d’un robot : même chemin qu’une ligne reçue d’un client, avec le tour pour lequel il a été calculé */
+static void envoyerRobot(void* contexte, int salle, uint64_t tour, const char* ligne) {
+	deposerMessage((Serveur*)contexte, salle, -1, (int64_t)tour, ligne);
+}
+
+/* libère ce qu’un travailleur possède ; son fil est arrêté ou n’a pas démarré */
+static void detruireTravailleur(Travailleur* t) {
+	detruireVecteur(&t->salles);
+	detruireTampon(&t->reponse);
+	detruireCache(&t->cache);
+	cnd_destroy(&t->signal);
+	mtx_destroy(&t->verrou);
+}
+
+int initServeur(Serveur* serveur, const char* fichier, int nb_travailleurs, uint64_t graine,
+	int delai_ms, RepondreSalle repondre, void* contexte) {
+	if (nb_travailleurs < 1) return -1;
+	if (!demarrerRechargeur(&serveur->config, fichier, INTERVALLE_RECHARGEMENT_MS)) return -1;
+
+	serveur->nb_travailleurs = nb_travailleurs;
+	serveur->graine = graine;
+	serveur->delai_ms = delai_ms;
+	serveur->repondre = repondre;
+	serveur->contexte = contexte;
+	serveur->analyses = NULL;
+	serveur->acquitter = NULL;
+	memset(&serveur->stats_cache, 0, sizeof(serveur->stats_cache));
+	/* chaque demande apporte la configuration de sa salle */
+	serveur->robots_demarres = demarrerRobots(&serveur->robots, NB_FILS_ROBOTS, NULL, envoyerRobot, serveur, graine);
+	serveur->travailleurs = (Travailleur*)calloc(nb_travailleurs, sizeof(Travailleur));
+	if (!serveur->travailleurs) {
+		serveur->nb_travailleurs = 0;
+		arreterServeur(serveur);
+		return -1;
+	}
+
+	for (int i = 0; i < nb_travailleurs; ++i) {
+		Travailleur* t = &serveur->travailleurs[i];
+		t->serveur = serveur;
+		mtx_init(&t->verrou, mtx_plain);
+		cnd_init(&t->signal);
+		initVecteur(&t->salles, 4);
+		initTampon(&t->reponse);
+		t->sortie = sortieTampon(&t->reponse);
+		initRoue(&t->roue, 10, maintenantMs());
+		initCache(&t->cache, TAILLE_CACHE_DEFAUT);
+		t->generation_cache = 0;
+		if (thrd_create(&t->fil, boucleTravailleur, t) != thrd_success) {
+			/* les travailleurs déjà démarrés sont arrêtés comme à l’arrêt du serveur */
+			detruireTravailleur(t);
+			serveur->nb_travailleurs = i;
+			arreterServeur(serveur);
+			return -1;
+		}
+	}
+	return 0;
+}
+
+int envoyerLigneServeur(Serveur* serveur, const char* ligne, int64_t client) {
+	char* fin = NULL;
+	long salle = strtol(ligne, &fin, 10);
+	if (fin == ligne || salle < 0 || salle > INT_MAX) return 0;
+	return deposerMessage(serveur, (int)salle, client, -1, fin);
+}
+
+void arreterServeur(Serveur* serveur) {
+	/* plus aucun coup de robot ne doit arriver dans les files des travailleurs */
+	if (serveur->robots_demarres) {
+		arreterRobots(&serveur->robots);
+	}
+	for (int i = 0; i < serveur->nb_travailleurs; ++i) {
+		Travailleur* t = &serveur->travailleurs[i];
+		mtx_lock(&t->verrou);
+		t->arret = 1;
+		mtx_unlock(&t->verrou);
+		cnd_signal(&t->signal);
+	}
+	for (int i = 0; i < serveur->nb_travailleurs; ++i) {
+		Travailleur* t = &serveur->travailleurs[i];
+		thrd_join(t->fil, NULL);
+		StatistiquesCache* total = &serveur->stats_cache;
+		total->consultations += t->cache.stats.consultations;
+		total->succes += t->cache.stats.succes;
+		total->insertions += t->cache.stats.insertions;
+		total->evictions += t->cache.stats.evictions;
+		total->nb_entrees += t->cache.stats.nb_entrees;
+		total->octets += t->cache.stats.octets;
+		detruireTravailleur(t);
+	}
+	free(serveur->travailleurs);
+	serveur->travailleurs = NULL;
+	if (serveur->robots_demarres) {
+		detruireRobots(&serveur->robots);
+		serveur->robots_demarres = 0;
+	}
+	arreterRechargeur(&serveur->config);
+}
+
+static void repondreStdout(void* contexte, int64_t client, int salle, const char* texte, size_t longueur) {
+	(void)client;
+	mtx_t* verrou = (mtx_t*)contexte;
+	mtx_lock(verrou);
+	printf("[salle %d]\n", salle);
+	fwrite(texte, 1, longueur, stdout);
+	fflush(stdout);
+	mtx_unlock(verrou);
+}
+
+int lancerServeur(const char* fichier, int nb_travailleurs, int delai_ms, FILE* entree) {
+	Serveur serveur;
+	mtx_t verrou;
+	mtx_init(&verrou, mtx_plain);
+
+	if (initServeur(&serveur, fichier, nb_travailleurs, graineHorloge(), delai_ms, repondreStdout, &verrou) != 0) {
+		mtx_destroy(&verrou);
+		return -1;
+	}
+
+	char* ligne;
+	while ((ligne = readFullLine(entree)) != NULL) {
+		if (strcmp(ligne, "!memoire") == 0) {
+			mtx_lock(&verrou);
+			afficherMemoire(sortieStandard());
+			fflush(stdout);
+			mtx_unlock(&verrou);
+		}
+		else if (!envoyerLigneServeur(&serveur, ligne, 0)) {
+			salleInexistante(sortieStandard(), -1);
+		}
+		free(ligne);
+	}
+
+	arreterServeur(&serveur);
+	afficherStatistiquesCache(sortieStandard(), &serveur.stats_cache);
+	afficherMemoire(sortieStandard());
+	mtx_destroy(&verrou);
+	return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * @file serveur.h
+ * @brief Mode serveur : plusieurs salles de jeu indépendantes sur un pool de threads.
+ *
+ * Chaque salle est une `Game` complète (joueurs, podiums, générateur) qui partage
+ * avec les autres salles la configuration immuable chargée une seule fois
+ * (animaux, commandes, cartes). Un nombre fixe de travailleurs exécute les salles :
+ * la salle `id` est épinglée sur le travailleur `id % nb_travailleurs`, qui est
+ * le seul à la lire ou la modifier. L’état des salles n’a donc besoin d’aucun verrou ;
+ * seule la file de messages de chaque travailleur est protégée.
+ *
+ * Protocole (une ligne par message) :
+ * - `<salle> ouvrir <joueur1> <joueur2> ...` : crée la salle ; un nom de la forme
+ *   `+<nom>:<niveau>:<budget_ms>` inscrit un robot (voir `robot.h`) nommé `<nom>`,
+ * - `<salle> <joueur> <commandes>`            : joue un coup,
+ * - `<salle> fermer`                          : affiche les résultats et détruit la salle.
+ *
+ * La configuration est rechargée à chaud quand son fichier change (voir
+ * `rechargement.h`) : chaque salle retient la configuration qu’elle utilise et
+ * adopte la nouvelle à sa prochaine distribution, en gardant ses joueurs et leurs
+ * points. Le cache d’un travailleur ne sert qu’aux salles de la configuration la
+ * plus récente qu’il ait vue.
+ *
+ * Avec un délai de tour, chaque travailleur arme l’échéance de ses salles dans sa
+ * propre roue de minuterie et attend ses messages au plus jusqu’à la prochaine
+ * échéance ; un tour expiré est redistribué et la salle répond à son dernier client.
+ */
+
+#pragma once
+#pragma warning(push)
+#pragma warning(disable:4996)
+
+#include <threads.h>
+#include "game.h"
+#include "rechargement.h"
+#include "robot.h"
+#include "vecteur.h"
+
+/**
+ * @brief Fonction recevant la réponse d’une salle après le traitement d’un message.
+ *
+ * `client` est celui passé à `envoyerLigneServeur` pour ce message, ou `-1` pour
+ * les résultats affichés à l’arrêt du serveur.
+ */
+typedef void (*RepondreSalle)(void* contexte, int64_t client, int salle, const char* texte, size_t longueur);
+
+/**
+ * @brief Fonction appelée quand le message d’un client (`client >= 0`) a été traité.
+ *
+ * L’appel suit la réponse au message (s’il y en a une) sur le même travailleur :
+ * un frontal qui compte ses messages en vol sait ainsi quand toutes les réponses
+ * d’un client lui sont parvenues.
+ */
+typedef void (*AcquitterMessage)(void* contexte, int64_t client);
+
+/**
+ * @brief Message en attente dans la file d’un travailleur.
+ */
+typedef struct Message {
+    int salle;               /**< Identifiant de la salle destinataire. */
+    int64_t client;          /**< Émetteur, à qui la réponse est destinée. */
+    int64_t tour;            /**< Tour pour lequel un robot a calculé son coup, `-1` pour une ligne reçue. */
+    char* ligne;             /**< Reste de la ligne (après l’identifiant). */
+    struct Message* suivant; /**< Message suivant dans la file. */
+} Message;
+
+struct Serveur;
+struct Travailleur;
+
+/**
+ * @brief Salle de jeu hébergée par le serveur.
+ */
+typedef struct {
+    int id;                           /**< Identifiant de la salle. */
+    Game game;                        /**< Partie de la salle. */
+    ConfigPartagee* config;           /**< Configuration de la partie (référence retenue). */
+    ConfigPartagee* config_suivante;  /**< Configuration à adopter à la prochaine distribution (référence retenue), ou `NULL`. */
+    struct Travailleur* travailleur;  /**< Travailleur sur lequel la salle est épinglée. */
+    int64_t dernier_client;           /**< Destinataire des messages spontanés (expiration). */
+    VecteurRobot robots;              /**< Robots inscrits parmi les joueurs. */
+    uint64_t tour_robots;             /**< Dernier tour pour lequel les robots ont été sollicités. */
+} Salle;
+
+/**
+ * @brief Thread du pool, propriétaire exclusif de ses salles.
+ */
+typedef struct Travailleur {
+    struct Serveur* serveur;
+    thrd_t fil;
+    mtx_t verrou;    /**< Protège `tete`, `queue` et `arret`. */
+    cnd_t signal;    /**< Signalé à l’arrivée d’un message ou à l’arrêt. */
+    Message* tete;
+    Message* queue;
+    int arret;
+
+    Vecteur salles;  /**< Salles (`Salle*`) épinglées sur ce travailleur. */
+    Tampon reponse;  /**< Réponse en cours de construction. */
+    Sortie sortie;   /**< Sortie écrivant dans `reponse`, partagée par ses salles. */
+    RoueMinuterie roue; /**< Échéances des tours de ses salles. */
+    CacheCompositions cache; /**< Résultats des chaînes jouées dans ses salles (vide si son allocation a échoué). */
+    uint64_t generation_cache; /**< Génération de la configuration dont le cache contient les résultats. */
+} Travailleur;
+
+/**
+ * @brief Serveur multi-salles.
+ */
+typedef struct Serveur {
+    Rechargeur config;           /**< Configuration partagée par les salles, rechargée quand son fichier change. */
+    Travailleur* travailleurs;
+    int nb_travailleurs;
+    uint64_t graine;             /**< Graine de base, combinée à l’identifiant de chaque salle. */
+    int delai_ms;                /**< Durée maximale d’un tour (ms), `0` sans limite. */
+    RepondreSalle repondre;
+    void* contexte;              /**< Contexte transmis à `repondre` et `acquitter`. */
+    AcquitterMessage acquitter;  /**< Appelée après chaque message d’un client, ou `NULL` (à fixer avant d’envoyer des lignes). */
+    StatistiquesCache stats_cache; /**< Compteurs cumulés des caches des travailleurs, remplis à l’arrêt. */
+    MoteurRobots robots;         /**< Calcul des coups des robots ; leurs coups reviennent dans la file de leur salle. */
+    int robots_demarres;         /**< `1` si le moteur de robots a démarré. */
+    Analyses* analyses;          /**< Flux des bilans de tours de toutes les salles, ou `NULL` (à fixer avant d’ouvrir des salles). */
+} Serveur;
+
+/**
+ * @brief Charge la configuration partagée, démarre sa surveillance et les travailleurs.
+ *
+ * @param[out] serveur Serveur à initialiser.
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] nb_travailleurs Nombre de threads du pool.
+ * @param[in] graine Graine de base des salles.
+ * @param[in] delai_ms Durée maximale d’un tour (ms), `0` sans limite.
+ * @param[in] repondre Fonction recevant les réponses des salles (appelée depuis les travailleurs).
+ * @param[in] contexte Contexte transmis à `repondre`.
+ * @return `0` si le démarrage réussit, `-1` sinon (tout ce qui a été démarré est alors arrêté).
+ * @pre `nb_travailleurs >= 1`.
+ */
+int initServeur(Serveur* serveur, const char* fichier, int nb_travailleurs, uint64_t graine,
+    int delai_ms, RepondreSalle repondre, void* contexte);
+
+/**
+ * @brief Transmet une ligne du protocole au travailleur de la salle concernée.
+ *
+ * La ligne est copiée ; l’appel ne bloque que le temps d’ajouter le message à la file.
+ *
+ * @param[in,out] serveur Serveur.
+ * @param[in] ligne Ligne `<salle> ...`.
+ * @param[in] client Identifiant de l’émetteur, transmis tel quel à `repondre`.
+ * @return `1` si la ligne est transmise, `0` si elle ne commence pas par un identifiant de salle
+ *         (entier de `0` à `INT_MAX`) ou en cas de manque de mémoire.
+ */
+int envoyerLigneServeur(Serveur* serveur, const char* ligne, int64_t client);
+
+/**
+ * @brief Traite les messages restants, ferme toutes les salles et arrête les travailleurs.
+ *
+ * @param[in,out] serveur Serveur à arrêter.
+ */
+void arreterServeur(Serveur* serveur);
+
+/**
+ * @brief Lance le serveur en lisant les lignes du protocole sur un flux, jusqu’à sa fin.
+ *
+ * Les réponses sont écrites sur `stdout`, précédées de l’identifiant de la salle,
+ * puis les compteurs des caches de résultats à l’arrêt.
+ *
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] nb_travailleurs Nombre de threads du pool.
+ * @param[in] delai_ms Durée maximale d’un tour (ms), `0` sans limite.
+ * @param[in] entree Flux d’entrée.
+ * @return `0` à la fin normale, `-1` si le serveur n’a pas pu démarrer.
+ */
+int lancerServeur(const char* fichier, int nb_travailleurs, int delai_ms, FILE* entree);
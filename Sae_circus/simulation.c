@@ -0,0 +1,260 @@
+#include "simulation.h"
+#include "robot.h"
+
+/* part de la simulation jouée par un fil */
+typedef struct {
+	const Game* modele;
+	const ParametresSimulation* parametres;
+	int64_t nb_tours;
+	uint64_t graine;
+	ResultatSimulation resultat;
+	int erreur;
+} FilSimulation;
+
+static void compter(int64_t* histogramme, int valeur) {
+	if (valeur < 0 || valeur >= TAILLE_HISTOGRAMME) valeur = TAILLE_HISTOGRAMME - 1;
+	++histogramme[valeur];
+}
+
+/* « nom commandes » dans un tampon agrandi au besoin */
+static char* ecrireLigne(char** tampon, size_t* capacite, const char* nom, const Sequence* coup) {
+	size_t longueur = strlen(nom);
+	size_t taille = longueur + 2 + 2 * (size_t)coup->nbElements;
+	if (taille > *capacite) {
+		char* nouveau = (char*)realloc(*tampon, taille);
+		if (!nouveau) return NULL;
+		*tampon = nouveau;
+		*capacite = taille;
+	}
+	char* ligne = *tampon;
+	memcpy(ligne, nom, longueur);
+	ligne[longueur++] = ' ';
+	for (int64_t i = 0; i < coup->nbElements; ++i) {
+		memcpy(&ligne[longueur], nomCommande(coup->elements[i]), 2);
+		longueur += 2;
+	}
+	ligne[longueur] = '\0';
+	return ligne;
+}
+
+/* points et victoires d’une partie ; une partie interrompue ne compte pas de victoire */
+static void bilanPartie(const Game* game, int nb_strategies, char** noms, int terminee, ResultatSimulation* r) {
+	int meilleur = 0;
+	for (int i = 0; i < nb_strategies; ++i) {
+		const Joueur* j = obtenirJoueurParNom(game->joueurs, noms[i]);
+		r->points[i] += j->points;
+		if (j->points > meilleur) meilleur = j->points;
+	}
+	if (!terminee) return;
+	++r->nb_parties;
+	for (int i = 0; i < nb_strategies; ++i) {
+		if (obtenirJoueurParNom(game->joueurs, noms[i])->points == meilleur) ++r->victoires[i];
+	}
+}
+
+static int boucleSimulation(void* arg) {
+	FilSimulation* f = (FilSimulation*)arg;
+	const ParametresSimulation* p = f->parametres;
+	int nb = p->nb_strategies;
+	ResultatSimulation* r = &f->resultat;
+
+	char tampons_noms[MAX_STRATEGIES][12];
+	char* noms[MAX_STRATEGIES];
+	for (int i = 0; i < nb; ++i) {
+		snprintf(tampons_noms[i], sizeof(tampons_noms[i]), "b%d", i);
+		noms[i] = tampons_noms[i];
+	}
+	int ordre[MAX_STRATEGIES];
+
+	Aleatoire alea;
+	initAleatoire(&alea, f->graine);
+	/* sans mémoire pour la table, les distances sont inconnues et tous les robots jouent au hasard */
+	TableDistances table;
+	initTableDistances(&table, MAX_ETATS_DISTANCE);
+	Sequence coup;
+	initSequence(&coup, 16);
+	char* ligne = NULL;
+	size_t capacite = 0;
+
+	Game game;
+	int en_cours = 0;
+	int tours_partie = 0;
+	int n = (int)f->modele->animaux->nbElements;
+
+	while (r->nb_tours < f->nb_tours) {
+		if (!en_cours) {
+			if (initGamePartagee(&game, f->modele, nb, noms, aleatoireSuivant(&alea)) != 0) {
+				detruireGame(&game);
+				f->erreur = 1;
+				break;
+			}
+			game.sortie = sortieNulle();
+			en_cours = 1;
+			tours_partie = 0;
+		}
+
+		/* distance optimale de la donne */
+		int d = -1;
+		if (table.cles && game.cle_cible != CLE_INVALIDE) {
+			calculerDistances(&table, game.cle_cible, n, game.commandes, DISTANCE_INFINIE);
+			d = distanceMinimale(&table, empaqueterPodiums(game.podium_b, game.podium_r));
+			if (d > table.profondeur) d = -1;
+		}
+		compter(r->optimales, d);
+
+		/* chaque robot encore autorisé joue une fois, dans un ordre tiré au hasard */
+		for (int i = 0; i < nb; ++i) {
+			ordre[i] = i;
+		}
+		for (int i = nb - 1; i > 0; --i) {
+			int k = (int)aleatoireBorne(&alea, (uint64_t)i + 1);
+			int t = ordre[i];
+			ordre[i] = ordre[k];
+			ordre[k] = t;
+		}
+		uint64_t numero = game.numero_tour;
+		int coups = 0;
+		for (int i = 0; i < nb && game.numero_tour == numero; ++i) {
+			int s = ordre[i];
+			if (peutJouer(game.joueurs, noms[s]) != 1) continue;
+			if (d <= 0 || d > p->niveaux[s] || !cheminOptimal(&table, empaqueterPodiums(game.podium_b, game.podium_r), &coup)) {
+				coupAuHasard(&alea, n, game.commandes, &coup);
+			}
+			if (!ecrireLigne(&ligne, &capacite, noms[s], &coup)) {
+				f->erreur = 1;
+				break;
+			}
+			traiterLigne(&game, ligne);
+			++coups;
+		}
+		if (f->erreur) break;
+		/* plus personne ne peut jouer : le tour est redistribué comme à son expiration */
+		if (game.numero_tour == numero) {
+			expirerTour(&game);
+			++r->nb_expirations;
+		}
+		compter(r->longueurs, coups);
+		++r->nb_tours;
+
+		if (++tours_partie == p->tours_par_partie) {
+			bilanPartie(&game, nb, noms, 1, r);
+			detruireGame(&game);
+			en_cours = 0;
+		}
+	}
+	if (en_cours) {
+		bilanPartie(&game, nb, noms, 0, r);
+		detruireGame(&game);
+	}
+
+	free(ligne);
+	detruireSequence(&coup);
+	detruireTableDistances(&table);
+	return 0;
+}
+
+int simuler(const Game* modele, const ParametresSimulation* parametres, ResultatSimulation* resultat) {
+	assert(parametres->nb_strategies >= 1 && parametres->nb_strategies <= MAX_STRATEGIES);
+	assert(parametres->nb_fils >= 1);
+	memset(resultat, 0, sizeof(*resultat));
+
+	int nb_fils = parametres->nb_fils;
+	FilSimulation* fils = (FilSimulation*)calloc((size_t)nb_fils, sizeof(FilSimulation));
+	thrd_t* threads = (thrd_t*)malloc(sizeof(thrd_t) * (size_t)nb_fils);
+	if (!fils || !threads) {
+		free(fils);
+		free(threads);
+		return -1;
+	}
+
+	uint64_t debut = maintenantMs();
+	int nb_demarres = 0;
+	for (int i = 0; i < nb_fils; ++i) {
+		fils[i].modele = modele;
+		fils[i].parametres = parametres;
+		fils[i].nb_tours = parametres->nb_tours / nb_fils + (i < parametres->nb_tours % nb_fils ? 1 : 0);
+		fils[i].graine = parametres->graine ^ ((uint64_t)(i + 1) * 0x9E3779B97F4A7C15ULL);
+		if (thrd_create(&threads[i], boucleSimulation, &fils[i]) != thrd_success) {
+			fils[i].erreur = 1;
+			break;
+		}
+		++nb_demarres;
+	}
+
+	int erreur = nb_demarres < nb_fils;
+	for (int i = 0; i < nb_demarres; ++i) {
+		thrd_join(threads[i], NULL);
+		const ResultatSimulation* r = &fils[i].resultat;
+		erreur |= fils[i].erreur;
+		resultat->nb_tours += r->nb_tours;
+		resultat->nb_parties += r->nb_parties;
+		resultat->nb_expirations += r->nb_expirations;
+		for (int k = 0; k < TAILLE_HISTOGRAMME; ++k) {
+			resultat->longueurs[k] += r->longueurs[k];
+			resultat->optimales[k] += r->optimales[k];
+		}
+		for (int k = 0; k < parametres->nb_strategies; ++k) {
+			resultat->points[k] += r->points[k];
+			resultat->victoires[k] += r->victoires[k];
+		}
+	}
+	resultat->secondes = (double)(maintenantMs() - debut) / 1000.0;
+
+	free(fils);
+	free(threads);
+	return erreur ? -1 : 0;
+}
+
+/* plus petite valeur v telle qu’une fraction q des tours soit <= v */
+static int quantile(const int64_t* histogramme, int64_t total, double q) {
+	int64_t seuil = (int64_t)(q * (double)total);
+	int64_t cumul = 0;
+	for (int v = 0; v < TAILLE_HISTOGRAMME; ++v) {
+		cumul += histogramme[v];
+		if (cumul > seuil) return v;
+	}
+	return TAILLE_HISTOGRAMME - 1;
+}
+
+static void afficherHistogramme(const Sortie* s, const char* titre, const int64_t* histogramme) {
+	int64_t total = 0;
+	double somme = 0.0;
+	int max = 0;
+	for (int v = 0; v < TAILLE_HISTOGRAMME; ++v) {
+		total += histogramme[v];
+		somme += (double)v * (double)histogramme[v];
+		if (histogramme[v] > 0) max = v;
+	}
+	if (total == 0) return;
+	imprimer(s, "%s : moyenne %.2f, p50 %d, p90 %d, p99 %d, max %d%s\n", titre, somme / (double)total,
+		quantile(histogramme, total, 0.5), quantile(histogramme, total, 0.9), quantile(histogramme, total, 0.99),
+		max, histogramme[TAILLE_HISTOGRAMME - 1] > 0 ? " (derniere case : au moins)" : "");
+}
+
+void afficherSimulation(const Sortie* s, const ParametresSimulation* parametres, const ResultatSimulation* resultat) {
+	double debit = resultat->secondes > 0.0 ? (double)resultat->nb_tours / resultat->secondes : 0.0;
+	imprimer(s, "Simulation : %lld tours en %.2f s sur %d fils (%.0f tours/s), %lld parties, %lld tours redistribues\n",
+		(long long)resultat->nb_tours, resultat->secondes, parametres->nb_fils, debit,
+		(long long)resultat->nb_parties, (long long)resultat->nb_expirations);
+	afficherHistogramme(s, "Coups par tour", resultat->longueurs);
+	afficherHistogramme(s, "Distance optimale", resultat->optimales);
+	for (int i = 0; i < parametres->nb_strategies; ++i) {
+		double par_tour = resultat->nb_tours ? (double)resultat->points[i] / (double)resultat->nb_tours : 0.0;
+		imprimer(s, "b%d (niveau %d) : %lld points (%.3f par tour), %lld victoires\n", i, parametres->niveaux[i],
+			(long long)resultat->points[i], par_tour, (long long)resultat->victoires[i]);
+	}
+}
+
+int lancerSimulation(const char* fichier, const ParametresSimulation* parametres) {
+	Game modele;
+	if (chargerConfigGame(&modele, fichier) != 0) {
+		return -1;
+	}
+	ResultatSimulation resultat;
+	int code = simuler(&modele, parametres, &resultat);
+	if (code == 0) {
+		afficherSimulation(sortieStandard(), parametres, &resultat);
+	}
+	detruireGame(&modele);
+	return code;
+}
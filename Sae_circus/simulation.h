@@ -0,0 +1,79 @@
+/**
+ * @file simulation.h
+ * @brief Simulateur de tournois entre robots, réparti sur plusieurs threads.
+ *
+ * Chaque fil joue des parties complètes sans affichage (sortie nulle) avec son
+ * propre générateur : les coups des robots passent par `traiterLigne`, si bien
+ * que les règles de score sont exactement celles du jeu (`ajouterPointJoueur`,
+ * point au dernier joueur, redistribution quand plus personne ne peut jouer,
+ * comme à l’expiration d’un tour). Les fils ne partagent que la configuration ;
+ * leurs résultats sont additionnés à la fin.
+ *
+ * Sert à régler une configuration (nombre d’animaux, commandes autorisées)
+ * avant de la déployer : tours par seconde, longueur des tours, distance
+ * optimale des cartes tirées et points obtenus par chaque stratégie.
+ */
+
+#pragma once
+
+#include "game.h"
+
+enum {
+    MAX_STRATEGIES = 16,       /**< Nombre maximal de joueurs (une stratégie chacun) par partie. */
+    TAILLE_HISTOGRAMME = 32    /**< Nombre de cases des histogrammes ; la dernière regroupe le reste. */
+};
+
+/**
+ * @brief Paramètres d’une simulation.
+ */
+typedef struct {
+    int nb_fils;                    /**< Nombre de threads. */
+    int64_t nb_tours;               /**< Nombre total de tours à jouer. */
+    int tours_par_partie;           /**< Nombre de tours d’une partie. */
+    int nb_strategies;              /**< Nombre de joueurs par partie. */
+    int niveaux[MAX_STRATEGIES];    /**< Niveau du robot (voir `robot.h`) de chaque joueur. */
+    uint64_t graine;                /**< Graine de base, combinée au numéro de chaque fil. */
+} ParametresSimulation;
+
+/**
+ * @brief Résultats d’une simulation (ou d’un de ses fils).
+ */
+typedef struct {
+    int64_t nb_tours;                          /**< Tours joués. */
+    int64_t nb_parties;                        /**< Parties terminées. */
+    int64_t nb_expirations;                    /**< Tours redistribués faute de joueur pouvant jouer. */
+    int64_t longueurs[TAILLE_HISTOGRAMME];     /**< Tours par nombre de coups joués. */
+    int64_t optimales[TAILLE_HISTOGRAMME];     /**< Tours par distance optimale de départ (dernière case : inconnue ou plus). */
+    int64_t points[MAX_STRATEGIES];            /**< Points marqués par chaque stratégie. */
+    int64_t victoires[MAX_STRATEGIES];         /**< Parties gagnées (ex aequo compris) par chaque stratégie. */
+    double secondes;                           /**< Durée de la simulation. */
+} ResultatSimulation;
+
+/**
+ * @brief Joue une simulation à partir d’une configuration chargée.
+ *
+ * @param[in] modele Partie modèle (voir `chargerConfigGame`), partagée en lecture seule.
+ * @param[in] parametres Paramètres de la simulation.
+ * @param[out] resultat Résultats cumulés de tous les fils.
+ * @return `0` si la simulation réussit, `-1` sinon.
+ * @pre `1 <= parametres->nb_strategies <= MAX_STRATEGIES` et `parametres->nb_fils >= 1`.
+ */
+int simuler(const Game* modele, const ParametresSimulation* parametres, ResultatSimulation* resultat);
+
+/**
+ * @brief Affiche le résumé d’une simulation.
+ *
+ * @param[in] s Sortie sur laquelle écrire.
+ * @param[in] parametres Paramètres de la simulation.
+ * @param[in] resultat Résultats.
+ */
+void afficherSimulation(const Sortie* s, const ParametresSimulation* parametres, const ResultatSimulation* resultat);
+
+/**
+ * @brief Charge une configuration, lance une simulation et affiche son résumé sur `stdout`.
+ *
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] parametres Paramètres de la simulation.
+ * @return `0` si la simulation réussit, `-1` sinon.
+ */
+int lancerSimulation(const char* fichier, const ParametresSimulation* parametres);
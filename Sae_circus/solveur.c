@@ -0,0 +1,525 @@
+#include "solveur.h"
+#include "trace.h"
+
+/* taille des blocs lus sur l’entrée */
+enum { TAILLE_BLOC_SOLVEUR = 1 << 16 };
+
+/* profondeur maximale des valeurs ignorées d’une requête (champs inconnus) */
+enum { PROFONDEUR_JSON_MAX = 32 };
+
+
+/* ---------------------------------------------------------------------------
+ * Lecture d’une requête
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+	const char* c;
+	const char* fin;
+} LecteurJson;
+
+static void sauterBlancs(LecteurJson* l) {
+	while (l->c < l->fin && (*l->c == ' ' || *l->c == '\t' || *l->c == '\r' || *l->c == '\n')) ++l->c;
+}
+
+/* consomme le caractère attendu (après les blancs) */
+static int lireSymbole(LecteurJson* l, char attendu) {
+	sauterBlancs(l);
+	if (l->c == l->fin || *l->c != attendu) return 0;
+	++l->c;
+	return 1;
+}
+
+/* chaîne entre guillemets : `*debut` et `*longueur` désignent son contenu, échappements non décodés */
+static int lireChaineJson(LecteurJson* l, const char** debut, size_t* longueur) {
+	if (!lireSymbole(l, '"')) return 0;
+	*debut = l->c;
+	while (l->c < l->fin && *l->c != '"') {
+		if (*l->c == '\\' && ++l->c == l->fin) return 0;
+		++l->c;
+	}
+	if (l->c == l->fin) return 0;
+	*longueur = (size_t)(l->c - *debut);
+	++l->c;
+	return 1;
+}
+
+static int sauterValeurJson(LecteurJson* l, int profondeur) {
+	sauterBlancs(l);
+	if (l->c == l->fin || profondeur > PROFONDEUR_JSON_MAX) return 0;
+	const char* debut;
+	size_t longueur;
+	char ouvrant = *l->c;
+	if (ouvrant == '"') return lireChaineJson(l, &debut, &longueur);
+	if (ouvrant == '[' || ouvrant == '{') {
+		char fermant = ouvrant == '[' ? ']' : '}';
+		++l->c;
+		if (lireSymbole(l, fermant)) return 1;
+		do {
+			if (ouvrant == '{' && (!lireChaineJson(l, &debut, &longueur) || !lireSymbole(l, ':'))) return 0;
+			if (!sauterValeurJson(l, profondeur + 1)) return 0;
+		} while (lireSymbole(l, ','));
+		return lireSymbole(l, fermant);
+	}
+	/* nombre, true, false ou null */
+	debut = l->c;
+	while (l->c < l->fin && *l->c != ',' && *l->c != '}' && *l->c != ']'
+		&& *l->c != ' ' && *l->c != '\t' && *l->c != '\r' && *l->c != '\n') ++l->c;
+	return l->c > debut;
+}
+
+/* indice de l’animal de ce nom, -1 s’il n’existe pas */
+static int indiceAnimal(const Animaux* animaux, const char* nom, size_t longueur) {
+	for (int i = 0; i < animaux->nbElements; ++i) {
+		const char* texte = animaux->elements[i].nom_animal.texte;
+		if (strncmp(texte, nom, longueur) == 0 && texte[longueur] == '\0') return i;
+	}
+	return -1;
+}
+
+/* tableau de noms d’animaux, ajoutés à `animaux` ; `vus` marque les animaux déjà placés */
+static int lirePodiumJson(LecteurJson* l, const Animaux* config, uint8_t* animaux, int* nb, uint32_t* vus,
+	const char** erreur) {
+	if (!lireSymbole(l, '[')) return 0;
+	if (lireSymbole(l, ']')) return 1;
+	do {
+		const char* nom;
+		size_t longueur;
+		if (!lireChaineJson(l, &nom, &longueur)) return 0;
+		int i = indiceAnimal(config, nom, longueur);
+		if (i < 0) {
+			*erreur = "animal inconnu";
+			return 0;
+		}
+		if (*vus & (1u << i)) {
+			*erreur = "animal repete";
+			return 0;
+		}
+		*vus |= 1u << i;
+		animaux[(*nb)++] = (uint8_t)i;
+	} while (lireSymbole(l, ','));
+	return lireSymbole(l, ']');
+}
+
+/* `{"b":[...],"r":[...]}`, empaqueté ; tous les animaux doivent y être, une fois chacun */
+static int lireSituationJson(LecteurJson* l, const Animaux* config, CleEtat* cle, const char** erreur) {
+	uint8_t b[MAX_ANIMAUX_CLE], r[MAX_ANIMAUX_CLE];
+	int nb_b = 0, nb_r = 0;
+	uint32_t vus = 0;
+	int lu_b = 0, lu_r = 0;
+	if (!lireSymbole(l, '{')) return 0;
+	if (!lireSymbole(l, '}')) {
+		do {
+			const char* cle_json;
+			size_t longueur;
+			if (!lireChaineJson(l, &cle_json, &longueur) || !lireSymbole(l, ':')) return 0;
+			if (longueur == 1 && (*cle_json == 'b' || *cle_json == 'r')) {
+				int* lu = *cle_json == 'b' ? &lu_b : &lu_r;
+				if (*lu) return 0;
+				*lu = 1;
+				if (!lirePodiumJson(l, config, *cle_json == 'b' ? b : r, *cle_json == 'b' ? &nb_b : &nb_r, &vus, erreur)) {
+					return 0;
+				}
+			}
+			else if (!sauterValeurJson(l, 1)) {
+				return 0;
+			}
+		} while (lireSymbole(l, ','));
+		if (!lireSymbole(l, '}')) return 0;
+	}
+	if (nb_b + nb_r != config->nbElements) {
+		*erreur = "podiums incomplets";
+		return 0;
+	}
+	*cle = (CleEtat)nb_b;
+	for (int k = 0; k < nb_b + nb_r; ++k) {
+		*cle |= (CleEtat)(k < nb_b ? b[k] : r[k - nb_b]) << (4 + 4 * k);
+	}
+	return 1;
+}
+
+/* ---------------------------------------------------------------------------
+ * Résolution d’une requête
+ * ------------------------------------------------------------------------- */
+
+int initContexteSolveur(ContexteSolveur* c, const Game* modele, int64_t max_etats) {
+	int n = (int)modele->animaux->nbElements;
+	memset(c, 0, sizeof(*c));
+	if (n > MAX_ANIMAUX_CLE) return 0;
+	c->modele = modele;
+
+	/* il n’y a que (n + 1) * n! situations ; le parcours réserve la place de tous les
+	   prédécesseurs d’un niveau avant de l’explorer, d’où la marge de NB_OPS par situation */
+	int64_t situations = n + 1;
+	for (int k = 2; k <= n && situations <= MAX_ETATS_DISTANCE; ++k) situations *= k;
+	situations *= NB_OPS + 1;
+	if (max_etats <= 0) max_etats = MAX_ETATS_DISTANCE;
+	c->max_etats = max_etats < situations ? max_etats : situations;
+	return initSequence(&c->chemin, 16);
+}
+
+void detruireContexteSolveur(ContexteSolveur* c) {
+	for (int s = 0; s <= MAX_ANIMAUX_CLE; ++s) {
+		if (c->tables[s].cles) detruireTableDistances(&c->tables[s]);
+	}
+	detruireSequence(&c->chemin);
+}
+
+/* renomme les animaux pour que la cible devienne 0, 1, …, n-1 (même split) ; `depart` suit le renommage */
+static CleEtat renommerCible(CleEtat cible, CleEtat* depart, int n) {
+	uint8_t rang[MAX_ANIMAUX_CLE];
+	CleEtat canonique = cible & 0xF;
+	for (int k = 0; k < n; ++k) {
+		rang[(cible >> (4 + 4 * k)) & 0xF] = (uint8_t)k;
+		canonique |= (CleEtat)k << (4 + 4 * k);
+	}
+	CleEtat renomme = *depart & 0xF;
+	for (int k = 0; k < n; ++k) {
+		renomme |= (CleEtat)rang[(*depart >> (4 + 4 * k)) & 0xF] << (4 + 4 * k);
+	}
+	*depart = renomme;
+	return canonique;
+}
+
+static int ecrireTexte(Tampon* t, const char* texte) {
+	return ajouterTampon(t, texte, strlen(texte));
+}
+
+int resoudreRequete(ContexteSolveur* c, const char* requete, size_t longueur, Tampon* reponse) {
+	const Animaux* animaux = c->modele->animaux;
+	int n = (int)animaux->nbElements;
+	LecteurJson l = { requete, requete + longueur };
+	const char* id = NULL;
+	size_t longueur_id = 0;
+	CleEtat depart = CLE_INVALIDE, cible = CLE_INVALIDE;
+	const char* erreur = "requete mal formee";
+	int valide = 0;
+	++c->bilan.nb_requetes;
+
+	if (lireSymbole(&l, '{')) {
+		valide = 1;
+		if (!lireSymbole(&l, '}')) {
+			do {
+				const char* cle_json;
+				size_t longueur_cle;
+				if (!lireChaineJson(&l, &cle_json, &longueur_cle) || !lireSymbole(&l, ':')) {
+					valide = 0;
+				}
+				else if (longueur_cle == 2 && memcmp(cle_json, "id", 2) == 0) {
+					sauterBlancs(&l);
+					id = l.c;
+					valide = sauterValeurJson(&l, 1);
+					longueur_id = (size_t)(l.c - id);
+					if (!valide) id = NULL;
+				}
+				else if (longueur_cle == 6 && memcmp(cle_json, "depart", 6) == 0) {
+					valide = lireSituationJson(&l, animaux, &depart, &erreur);
+				}
+				else if (longueur_cle == 5 && memcmp(cle_json, "cible", 5) == 0) {
+					valide = lireSituationJson(&l, animaux, &cible, &erreur);
+				}
+				else {
+					valide = sauterValeurJson(&l, 1);
+				}
+			} while (valide && lireSymbole(&l, ','));
+			valide = valide && lireSymbole(&l, '}');
+		}
+		sauterBlancs(&l);
+		if (valide && l.c != l.fin) valide = 0;
+	}
+	if (valide && (depart == CLE_INVALIDE || cible == CLE_INVALIDE)) {
+		erreur = "depart ou cible manquant";
+		valide = 0;
+	}
+
+	int ok = ecrireTexte(reponse, "{");
+	if (id) {
+		ok = ok && ecrireTexte(reponse, "\"id\":") && ajouterTampon(reponse, id, longueur_id) && ecrireTexte(reponse, ",");
+	}
+	if (valide) {
+		CleEtat canonique = renommerCible(cible, &depart, n);
+		TableDistances* table = &c->tables[canonique & 0xF];
+		if (!table->cles) {
+			if (!initTableDistances(table, c->max_etats)) return 0;
+			calculerDistances(table, canonique, n, c->modele->commandes, DISTANCE_INFINIE);
+			++c->bilan.nb_tables;
+		}
+
+		int d = distanceMinimale(table, depart);
+		if (d == DISTANCE_INFINIE) {
+			++c->bilan.nb_inaccessibles;
+			return ok && ecrireTexte(reponse, "\"longueur\":null,\"sequence\":null}\n");
+		}
+		if (d > table->profondeur) {
+			/* la table est incomplète : la distance n’est qu’un minorant */
+			erreur = "hors de la table des distances";
+		}
+		else {
+			if (!cheminOptimal(table, depart, &c->chemin)) return 0;
+			char texte[48];
+			snprintf(texte, sizeof(texte), "\"longueur\":%d,\"sequence\":\"", d);
+			ok = ok && ecrireTexte(reponse, texte);
+			for (int64_t i = 0; i < c->chemin.nbElements && ok; ++i) {
+				ok = ajouterTampon(reponse, nomCommande(c->chemin.elements[i]), 2);
+			}
+			++c->bilan.nb_resolues;
+			return ok && ecrireTexte(reponse, "\"}\n");
+		}
+	}
+	++c->bilan.nb_erreurs;
+	return ok && ecrireTexte(reponse, "\"erreur\":\"") && ecrireTexte(reponse, erreur) && ecrireTexte(reponse, "\"}\n");
+}
+
+/* ---------------------------------------------------------------------------
+ * Résolution d’un flux
+ * ------------------------------------------------------------------------- */
+
+typedef struct {
+	Tampon entree;  /* lignes du lot, chacune terminée par \n */
+	Tampon sortie;  /* réponses, dans le même ordre */
+	int resolu;
+	int erreur;
+} LotSolveur;
+
+/* lots en vol : le lot de numéro k occupe la case k % nb_lots */
+typedef struct {
+	mtx_t verrou;
+	cnd_t publie;        /* signalé à la publication d’un lot et à la fin de l’entrée */
+	cnd_t resolu;        /* signalé quand un lot est résolu */
+	LotSolveur* lots;
+	int nb_lots;
+	uint64_t nb_publies; /* lots publiés par le fil appelant */
+	uint64_t nb_pris;    /* lots pris par un fil de résolution */
+	uint64_t nb_ecrits;  /* lots écrits (fil appelant seul) */
+	int fin;
+} FileLots;
+
+typedef struct {
+	FileLots* file;
+	ContexteSolveur contexte;
+} FilSolveur;
+
+static int resoudreLot(ContexteSolveur* c, LotSolveur* lot) {
+	const char* ligne = lot->entree.donnees;
+	const char* fin = ligne + lot->entree.taille;
+	lot->sortie.taille = 0;
+	while (ligne < fin) {
+		const char* saut = (const char*)memchr(ligne, '\n', (size_t)(fin - ligne));
+		if (!resoudreRequete(c, ligne, (size_t)(saut - ligne), &lot->sortie)) return 0;
+		ligne = saut + 1;
+	}
+	return 1;
+}
+
+static int boucleSolveur(void* arg) {
+	FilSolveur* f = (FilSolveur*)arg;
+	FileLots* file = f->file;
+	nommerFilTrace("solveur");
+
+	mtx_lock(&file->verrou);
+	for (;;) {
+		while (!file->fin && file->nb_pris == file->nb_publies) {
+			cnd_wait(&file->publie, &file->verrou);
+		}
+		if (file->nb_pris == file->nb_publies) break;
+		LotSolveur* lot = &file->lots[file->nb_pris++ % (uint64_t)file->nb_lots];
+		mtx_unlock(&file->verrou);
+
+		debutTrace("lot solveur");
+		int ok = resoudreLot(&f->contexte, lot);
+		finTrace("lot solveur");
+
+		mtx_lock(&file->verrou);
+		lot->erreur = !ok;
+		lot->resolu = 1;
+		cnd_signal(&file->resolu);
+	}
+	mtx_unlock(&file->verrou);
+	return 0;
+}
+
+/* écrit le plus ancien lot publié, en attendant sa résolution si `attendre` ; 0 s’il n’est pas prêt */
+static int ecrireLotSuivant(FileLots* file, FILE* sortie, int attendre, int* erreur) {
+	LotSolveur* lot = &file->lots[file->nb_ecrits % (uint64_t)file->nb_lots];
+	mtx_lock(&file->verrou);
+	while (attendre && !lot->resolu) {
+		cnd_wait(&file->resolu, &file->verrou);
+	}
+	int pret = lot->resolu;
+	mtx_unlock(&file->verrou);
+	if (!pret) return 0;
+
+	if (lot->erreur || fwrite(lot->sortie.donnees, 1, lot->sortie.taille, sortie) != lot->sortie.taille) {
+		*erreur = 1;
+	}
+	lot->entree.taille = 0;
+	lot->resolu = 0;
+	++file->nb_ecrits;
+	return 1;
+}
+
+static void publierLot(FileLots* file) {
+	mtx_lock(&file->verrou);
+	++file->nb_publies;
+	mtx_unlock(&file->verrou);
+	cnd_signal(&file->publie);
+}
+
+int resoudreFlux(const Game* modele, const ParametresSolveur* parametres, FILE* entree, FILE* sortie,
+	BilanSolveur* bilan) {
+	assert(parametres->nb_fils >= 1);
+	memset(bilan, 0, sizeof(*bilan));
+	uint64_t debut = maintenantMs();
+
+	int nb_fils = parametres->nb_fils;
+	FileLots file;
+	memset(&file, 0, sizeof(file));
+	file.nb_lots = nb_fils * LOTS_PAR_FIL_SOLVEUR;
+	file.lots = (LotSolveur*)calloc((size_t)file.nb_lots, sizeof(LotSolveur));
+	FilSolveur* fils = (FilSolveur*)calloc((size_t)nb_fils, sizeof(FilSolveur));
+	thrd_t* threads = (thrd_t*)malloc(sizeof(thrd_t) * (size_t)nb_fils);
+	char* bloc = (char*)malloc(TAILLE_BLOC_SOLVEUR);
+	if (!file.lots || !fils || !threads || !bloc) {
+		free(file.lots);
+		free(fils);
+		free(threads);
+		free(bloc);
+		return -1;
+	}
+	for (int i = 0; i < file.nb_lots; ++i) {
+		initTampon(&file.lots[i].entree);
+		initTampon(&file.lots[i].sortie);
+	}
+	mtx_init(&file.verrou, mtx_plain);
+	cnd_init(&file.publie);
+	cnd_init(&file.resolu);
+
+	int erreur = 0;
+	int nb_initialises = 0;
+	for (; nb_initialises < nb_fils && !erreur; ++nb_initialises) {
+		fils[nb_initialises].file = &file;
+		erreur = !initContexteSolveur(&fils[nb_initialises].contexte, modele, parametres->max_etats);
+	}
+	int nb_demarres = 0;
+	for (; nb_demarres < nb_fils && !erreur; ++nb_demarres) {
+		erreur = thrd_create(&threads[nb_demarres], boucleSolveur, &fils[nb_demarres]) != thrd_success;
+	}
+	if (erreur && nb_demarres > 0) --nb_demarres;
+
+	/* lecture par blocs : `reste` garde la ligne commencée à la fin du bloc précédent */
+	Tampon reste;
+	initTampon(&reste);
+	LotSolveur* lot = NULL;
+	int nb_lignes = 0;
+	int fin_entree = erreur;
+	while (!fin_entree) {
+		size_t lu = fread(bloc, 1, TAILLE_BLOC_SOLVEUR, entree);
+		if (lu == 0) {
+			fin_entree = 1;
+			erreur |= ferror(entree) != 0;
+			/* dernière ligne sans saut de ligne */
+			if (reste.taille > 0 && !ajouterTampon(&reste, "\n", 1)) erreur = 1;
+		}
+		else if (!ajouterTampon(&reste, bloc, lu)) {
+			erreur = 1;
+			break;
+		}
+
+		size_t coupe = 0;
+		for (;;) {
+			if (!lot) {
+				/* la case du prochain lot se libère quand son précédent occupant est écrit */
+				while (file.nb_publies - file.nb_ecrits == (uint64_t)file.nb_lots) {
+					ecrireLotSuivant(&file, sortie, 1, &erreur);
+				}
+				lot = &file.lots[file.nb_publies % (uint64_t)file.nb_lots];
+				nb_lignes = 0;
+			}
+			/* les lignes complètes du tampon, jusqu’à remplir le lot, sont copiées d’un bloc */
+			const char* curseur = reste.donnees + coupe;
+			const char* fin = reste.donnees + reste.taille;
+			while (nb_lignes < LIGNES_PAR_LOT_SOLVEUR && curseur < fin) {
+				const char* saut = (const char*)memchr(curseur, '\n', (size_t)(fin - curseur));
+				if (!saut) break;
+				curseur = saut + 1;
+				++nb_lignes;
+			}
+			size_t taille = (size_t)(curseur - (reste.donnees + coupe));
+			if (taille > 0 && !ajouterTampon(&lot->entree, reste.donnees + coupe, taille)) {
+				erreur = 1;
+				fin_entree = 1;
+				break;
+			}
+			coupe += taille;
+			if (nb_lignes < LIGNES_PAR_LOT_SOLVEUR) break;
+			publierLot(&file);
+			lot = NULL;
+			while (file.nb_ecrits < file.nb_publies && ecrireLotSuivant(&file, sortie, 0, &erreur)) {
+			}
+		}
+		consommerTampon(&reste, coupe);
+	}
+	if (lot && nb_lignes > 0) publierLot(&file);
+
+	mtx_lock(&file.verrou);
+	file.fin = 1;
+	mtx_unlock(&file.verrou);
+	cnd_broadcast(&file.publie);
+	while (nb_demarres > 0 && file.nb_ecrits < file.nb_publies) {
+		ecrireLotSuivant(&file, sortie, 1, &erreur);
+	}
+	if (fflush(sortie) != 0) erreur = 1;
+
+	for (int i = 0; i < nb_demarres; ++i) {
+		thrd_join(threads[i], NULL);
+	}
+	for (int i = 0; i < nb_initialises; ++i) {
+		const BilanSolveur* b = &fils[i].contexte.bilan;
+		bilan->nb_requetes += b->nb_requetes;
+		bilan->nb_resolues += b->nb_resolues;
+		bilan->nb_inaccessibles += b->nb_inaccessibles;
+		bilan->nb_erreurs += b->nb_erreurs;
+		bilan->nb_tables += b->nb_tables;
+		detruireContexteSolveur(&fils[i].contexte);
+	}
+	bilan->secondes = (double)(maintenantMs() - debut) / 1000.0;
+
+	detruireTampon(&reste);
+	for (int i = 0; i < file.nb_lots; ++i) {
+		detruireTampon(&file.lots[i].entree);
+		detruireTampon(&file.lots[i].sortie);
+	}
+	cnd_destroy(&file.resolu);
+	cnd_destroy(&file.publie);
+	mtx_destroy(&file.verrou);
+	free(file.lots);
+	free(fils);
+	free(threads);
+	free(bloc);
+	return erreur ? -1 : 0;
+}
+
+void afficherSolveur(const Sortie* s, const ParametresSolveur* parametres, const BilanSolveur* bilan) {
+	double debit = bilan->secondes > 0.0 ? (double)bilan->nb_requetes / bilan->secondes : 0.0;
+	imprimer(s, "Solveur : %lld requetes en %.2f s sur %d fils (%.0f requetes/s), %lld resolues, "
+		"%lld inaccessibles, %lld erreurs, %lld tables de distances\n",
+		(long long)bilan->nb_requetes, bilan->secondes, parametres->nb_fils, debit, (long long)bilan->nb_resolues,
+		(long long)bilan->nb_inaccessibles, (long long)bilan->nb_erreurs, (long long)bilan->nb_tables);
+}
+
+static void ecrireErreurStandard(void* contexte, const char* texte, size_t longueur) {
+	(void)contexte;
+	fwrite(texte, 1, longueur, stderr);
+}
+
+int lancerSolveur(const char* fichier, const ParametresSolveur* parametres) {
+	Game modele;
+	if (chargerConfigGame(&modele, fichier) != 0) {
+		return -1;
+	}
+	BilanSolveur bilan;
+	int code = resoudreFlux(&modele, parametres, stdin, stdout, &bilan);
+	Sortie erreurs = { ecrireErreurStandard, NULL };
+	afficherSolveur(&erreurs, parametres, &bilan);
+	detruireGame(&modele);
+	return code;
+}
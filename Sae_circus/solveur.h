@@ -0,0 +1,127 @@
+/**
+ * @file solveur.h
+ * @brief Résolution par lots de requêtes (départ, cible) lues et écrites en JSONL.
+ *
+ * Chaque ligne d’entrée est une requête ; les podiums sont donnés par les noms
+ * des animaux de la configuration, du bas vers le haut :
+ * `{"id":1,"depart":{"b":["OURS"],"r":["ELEPHANT","PIGEON"]},"cible":{"b":[],"r":["PIGEON","OURS","ELEPHANT"]}}`
+ *
+ * Chaque ligne de sortie est la réponse à la requête de même rang, `id` recopié tel quel :
+ * - `{"id":1,"longueur":3,"sequence":"KILOSO"}` : une plus courte séquence et sa longueur ;
+ * - `{"id":1,"longueur":null,"sequence":null}` : cible inaccessible avec les commandes autorisées ;
+ * - `{"id":1,"erreur":"animal inconnu"}` : requête refusée (ligne mal formée, animal inconnu ou répété…).
+ *
+ * Les commandes ne dépendent pas de l’identité des animaux : en renommant les
+ * animaux pour que la cible devienne la situation `0, 1, …, n-1` de même split,
+ * toutes les cibles de même split partagent une seule table de distances. Chaque
+ * fil garde ainsi au plus `n + 1` tables, calculées à la première requête qui les
+ * demande, et chaque requête ne coûte qu’une remontée de la table.
+ *
+ * Le fil appelant lit l’entrée par blocs et la découpe en lots de lignes ; les
+ * fils de résolution prennent les lots dans l’ordre et le fil appelant écrit
+ * leurs réponses dans ce même ordre, si bien que la sortie suit l’entrée.
+ */
+
+#pragma once
+
+#include <stdio.h>
+#include "game.h"
+
+enum {
+    LIGNES_PAR_LOT_SOLVEUR = 512,  /**< Requêtes traitées d’un bloc par un fil. */
+    LOTS_PAR_FIL_SOLVEUR = 4       /**< Lots en vol par fil (lus, en cours de résolution ou à écrire). */
+};
+
+/**
+ * @brief Paramètres du solveur.
+ */
+typedef struct {
+    int nb_fils;          /**< Nombre de fils de résolution. */
+    int64_t max_etats;    /**< Situations par table de distances (`0` : toutes jusqu’à `MAX_ETATS_DISTANCE`). */
+} ParametresSolveur;
+
+/**
+ * @brief Bilan d’une résolution.
+ */
+typedef struct {
+    int64_t nb_requetes;      /**< Lignes lues. */
+    int64_t nb_resolues;      /**< Requêtes ayant reçu une séquence. */
+    int64_t nb_inaccessibles; /**< Requêtes dont la cible est inaccessible. */
+    int64_t nb_erreurs;       /**< Requêtes refusées, ou hors de la table si elle est incomplète. */
+    int64_t nb_tables;        /**< Tables de distances calculées (tous fils confondus). */
+    double secondes;          /**< Durée de la résolution. */
+} BilanSolveur;
+
+/**
+ * @brief État d’un fil de résolution : tables de distances, chemin et compteurs.
+ */
+typedef struct {
+    const Game* modele;                          /**< Partie modèle (animaux et commandes autorisées). */
+    int64_t max_etats;                           /**< Situations par table. */
+    TableDistances tables[MAX_ANIMAUX_CLE + 1];  /**< Table de chaque split de cible, `cles == NULL` tant qu’elle n’est pas calculée. */
+    Sequence chemin;                             /**< Dernière séquence reconstruite. */
+    BilanSolveur bilan;                          /**< Compteurs du fil. */
+} ContexteSolveur;
+
+/**
+ * @brief Initialise l’état d’un fil de résolution (aucune table n’est encore calculée).
+ *
+ * @param[out] c État à initialiser.
+ * @param[in] modele Partie modèle, qui doit rester valide aussi longtemps que l’état.
+ * @param[in] max_etats Situations par table (`0` : toutes jusqu’à `MAX_ETATS_DISTANCE`).
+ * @return `1` si l’initialisation réussit, `0` sinon (ou si la configuration compte
+ *         plus de `MAX_ANIMAUX_CLE` animaux).
+ */
+int initContexteSolveur(ContexteSolveur* c, const Game* modele, int64_t max_etats);
+
+/**
+ * @brief Libère les tables et le chemin d’un état de résolution.
+ *
+ * @param[in,out] c État à libérer.
+ */
+void detruireContexteSolveur(ContexteSolveur* c);
+
+/**
+ * @brief Répond à une requête, en calculant au besoin la table du split de sa cible.
+ *
+ * @param[in,out] c État du fil.
+ * @param[in] requete Ligne de requête (sans saut de ligne, pas forcément terminée par `\0`).
+ * @param[in] longueur Longueur de la ligne.
+ * @param[out] reponse Tampon recevant la réponse (à la suite de son contenu), saut de ligne compris.
+ * @return `1` si la réponse est écrite, `0` en cas de manque de mémoire.
+ */
+int resoudreRequete(ContexteSolveur* c, const char* requete, size_t longueur, Tampon* reponse);
+
+/**
+ * @brief Répond à toutes les requêtes d’un flux, dans l’ordre.
+ *
+ * @param[in] modele Partie modèle (voir `chargerConfigGame`), partagée en lecture seule.
+ * @param[in] parametres Paramètres du solveur.
+ * @param[in] entree Flux de requêtes.
+ * @param[out] sortie Flux des réponses.
+ * @param[out] bilan Compteurs cumulés de tous les fils.
+ * @return `0` si toutes les réponses sont écrites, `-1` sinon.
+ * @pre `parametres->nb_fils >= 1`.
+ */
+int resoudreFlux(const Game* modele, const ParametresSolveur* parametres, FILE* entree, FILE* sortie,
+    BilanSolveur* bilan);
+
+/**
+ * @brief Affiche le bilan d’une résolution.
+ *
+ * @param[in] s Sortie des messages.
+ * @param[in] parametres Paramètres du solveur.
+ * @param[in] bilan Bilan.
+ */
+void afficherSolveur(const Sortie* s, const ParametresSolveur* parametres, const BilanSolveur* bilan);
+
+/**
+ * @brief Charge une configuration et répond aux requêtes de l’entrée standard sur la sortie standard.
+ *
+ * Le bilan est affiché sur la sortie d’erreur.
+ *
+ * @param[in] fichier Fichier de configuration.
+ * @param[in] parametres Paramètres du solveur.
+ * @return `0` si la résolution réussit, `-1` sinon.
+ */
+int lancerSolveur(const char* fichier, const ParametresSolveur* parametres);
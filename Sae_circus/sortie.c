@@ -0,0 +1,93 @@
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sortie.h"
+
+
+enum { TAILLE_TAMPON_SORTIE = 256 };
+
+static void ecrireStdout(void* contexte, const char* texte, size_t longueur) {
+	(void)contexte;
+	fwrite(texte, 1, longueur, stdout);
+}
+
+const Sortie* sortieStandard(void) {
+	static const Sortie standard = { ecrireStdout, NULL };
+	return &standard;
+}
+
+const Sortie* sortieNulle(void) {
+	static const Sortie nulle = { NULL, NULL };
+	return &nulle;
+}
+
+void imprimer(const Sortie* s, const char* format, ...) {
+	char tampon[TAILLE_TAMPON_SORTIE];
+	va_list args;
+	if (!s->ecrire) return;
+
+	va_start(args, format);
+	int n = vsnprintf(tampon, sizeof(tampon), format, args);
+	va_end(args);
+	if (n < 0) return;
+
+	if ((size_t)n < sizeof(tampon)) {
+		s->ecrire(s->contexte, tampon, (size_t)n);
+		return;
+	}
+
+	char* grand = (char*)malloc((size_t)n + 1);
+	if (!grand) return;
+	va_start(args, format);
+	vsnprintf(grand, (size_t)n + 1, format, args);
+	va_end(args);
+	s->ecrire(s->contexte, grand, (size_t)n);
+	free(grand);
+}
+
+void initTampon(Tampon* t) {
+	t->donnees = NULL;
+	t->taille = 0;
+	t->capacite = 0;
+}
+
+int ajouterTampon(Tampon* t, const char* texte, size_t longueur) {
+	if (t->taille + longueur > t->capacite) {
+		size_t capacite = t->capacite ? t->capacite : TAILLE_TAMPON_SORTIE;
+		while (capacite < t->taille + longueur) {
+			capacite *= 2;
+		}
+		char* donnees = (char*)realloc(t->donnees, capacite);
+		if (!donnees) return 0;
+		t->donnees = donnees;
+		t->capacite = capacite;
+	}
+	memcpy(t->donnees + t->taille, texte, longueur);
+	t->taille += longueur;
+	return 1;
+}
+
+void consommerTampon(Tampon* t, size_t n) {
+	if (n == t->taille) {
+		t->taille = 0;
+		return;
+	}
+	memmove(t->donnees, t->donnees + n, t->taille - n);
+	t->taille -= n;
+}
+
+void detruireTampon(Tampon* t) {
+	free(t->donnees);
+	initTampon(t);
+}
+
+static void ecrireTampon(void* contexte, const char* texte, size_t longueur) {
+	ajouterTampon((Tampon*)contexte, texte, longueur);
+}
+
+Sortie sortieTampon(Tampon* t) {
+	Sortie s = { ecrireTampon, t };
+	return s;
+}
@@ -0,0 +1,100 @@
+/**
+ * @file sortie.h
+ * @brief Destination des messages affichés par le jeu.
+ *
+ * Une `Sortie` associe une fonction d’écriture à un contexte. La sortie standard
+ * écrit sur `stdout` ; une sortie sur `Tampon` accumule les messages en mémoire,
+ * ce qui permet au mode serveur de renvoyer d’un bloc la réponse d’une salle.
+ */
+
+#pragma once
+#pragma warning(push)
+#pragma warning(disable:4996)
+
+#include <stddef.h>
+
+/**
+ * @brief Fonction recevant un morceau de texte à écrire.
+ */
+typedef void (*EcrireSortie)(void* contexte, const char* texte, size_t longueur);
+
+/**
+ * @brief Destination d’écriture.
+ */
+typedef struct {
+    EcrireSortie ecrire; /**< Fonction d’écriture, `NULL` pour ignorer les messages. */
+    void* contexte;      /**< Contexte transmis à `ecrire`. */
+} Sortie;
+
+/**
+ * @brief Retourne la sortie écrivant sur `stdout`.
+ *
+ * @return Un pointeur vers une sortie partagée, valide pendant tout le programme.
+ */
+const Sortie* sortieStandard(void);
+
+/**
+ * @brief Retourne une sortie qui ignore tout ce qui lui est écrit (sans même le formater).
+ *
+ * @return Un pointeur vers une sortie partagée, valide pendant tout le programme.
+ */
+const Sortie* sortieNulle(void);
+
+/**
+ * @brief Écrit un texte formaté (à la manière de `printf`) sur une sortie.
+ *
+ * @param[in] s Sortie.
+ * @param[in] format Chaîne de format.
+ * @pre `s` et `format` ne sont pas `NULL`.
+ */
+void imprimer(const Sortie* s, const char* format, ...);
+
+/**
+ * @brief Zone mémoire extensible accumulant du texte.
+ */
+typedef struct {
+    char* donnees;   /**< Texte accumulé (non terminé par `\0`). */
+    size_t taille;   /**< Nombre d’octets utilisés. */
+    size_t capacite; /**< Nombre d’octets alloués. */
+} Tampon;
+
+/**
+ * @brief Initialise un tampon vide.
+ *
+ * @param[out] t Tampon à initialiser.
+ */
+void initTampon(Tampon* t);
+
+/**
+ * @brief Ajoute des octets à la fin d’un tampon.
+ *
+ * @param[in,out] t Tampon.
+ * @param[in] texte Octets à ajouter.
+ * @param[in] longueur Nombre d’octets.
+ * @return `1` si l’ajout réussit, `0` en cas de manque de mémoire.
+ */
+int ajouterTampon(Tampon* t, const char* texte, size_t longueur);
+
+/**
+ * @brief Retire les `n` premiers octets d’un tampon.
+ *
+ * @param[in,out] t Tampon.
+ * @param[in] n Nombre d’octets à retirer.
+ * @pre `n <= t->taille`.
+ */
+void consommerTampon(Tampon* t, size_t n);
+
+/**
+ * @brief Libère la mémoire d’un tampon.
+ *
+ * @param[in,out] t Tampon à libérer.
+ */
+void detruireTampon(Tampon* t);
+
+/**
+ * @brief Construit une sortie écrivant à la fin d’un tampon.
+ *
+ * @param[in] t Tampon recevant le texte.
+ * @return La sortie associée.
+ */
+Sortie sortieTampon(Tampon* t);
@@ -1,20 +1,110 @@
 #include "game.h"
+#include "lot.h"
+#include "robot.h"
+#include "simulation.h"
+#include "solveur.h"
+#include "reseau.h"
+#include "predistribution.h"
+#include "paquet.h"
+#include "journal.h"
+#include "instantane.h"
+#include "rechargement.h"
+#include "trace.h"
 #include <assert.h>
+#ifdef __linux__
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
 
 static void test_animal() {
     Animaux animaux;
+    Arene arene;
+    PoolNoms noms;
+    initArene(&arene, 256);
+    assert(initPoolNoms(&noms, 9, 3, &arene) == 1);
     assert(initAnimaux(&animaux, 1) == 1);
 
-    ajouterAnimal(&animaux, "p1");
-    ajouterAnimal(&animaux, "p2");
-    ajouterAnimal(&animaux, "p3");
+    ajouterAnimal(&animaux, "p1", &noms);
+    ajouterAnimal(&animaux, "p2", &noms);
+    ajouterAnimal(&animaux, "p3", &noms);
 
     Animal* p1 = obtenirAnimal(&animaux, 0);
     assert(p1 != NULL);
-    assert(strcmp(p1->nom_animal, "p1") == 0);
+    assert(strcmp(p1->nom_animal.texte, "p1") == 0);
+    assert(p1->nom_animal.longueur == 2);
 
-    
-    
+    detruireVecteurAnimal(&animaux);
+    detruireArene(&arene);
+}
+
+/* Tests pour l'arne (alignement, gros blocs, rutilisation) */
+static void test_arene() {
+    Arene arene;
+    initArene(&arene, 256);
+
+    char* petit = allouerArene(&arene, 3);
+    int* aligne = allouerArene(&arene, sizeof(int));
+    assert(petit != NULL && aligne != NULL);
+    assert(((size_t)aligne % 16) == 0);
+
+    /* une demande plus grande que le bloc reoit son propre bloc */
+    char* gros = allouerArene(&arene, 4096);
+    assert(gros != NULL);
+    memset(gros, 1, 4096);
+    char* suite = allouerArene(&arene, 8);
+    assert(suite == (char*)aligne + 16);
+
+    char* copie = copierChaineArene(&arene, "OURS");
+    assert(strcmp(copie, "OURS") == 0);
+
+    detruireArene(&arene);
+    assert(arene.bloc == NULL);
+    assert(allouerArene(&arene, 8) != NULL);
+    detruireArene(&arene);
+}
+
+/* Tests pour la rserve de noms (internement, capacit) */
+static void test_noms() {
+    Arene arene;
+    PoolNoms noms;
+    Nom ours, elephant, encore;
+    initArene(&arene, 256);
+    assert(initPoolNoms(&noms, 14, 2, &arene) == 1);
+
+    assert(internerNom(&noms, "OURS", &ours) == 1);
+    assert(internerNom(&noms, "ELEPHANT", &elephant) == 1);
+    assert(internerNom(&noms, "OURS", &encore) == 1);
+    assert(memeNom(&ours, &encore) == 1);
+    assert(memeNom(&ours, &elephant) == 0);
+    assert(noms.taille == 14);
+    assert(nomEgal(&elephant, "ELEPHANT", 8, hacherNom("ELEPHANT", 8)) == 1);
+
+    /* la rserve est pleine */
+    assert(internerNom(&noms, "PIGEON", &encore) == 0);
+    detruireArene(&arene);
+}
+
+/* Tests pour les vecteurs typs (ajout group, suppressions) */
+static void test_vecteurtype() {
+    VecteurInt v;
+    const int valeurs[] = { 10, 11, 12, 13, 14 };
+    assert(initVecteurInt(&v, 0) == 1);
+    assert(ajouterPlusieursVecteurInt(&v, valeurs, 5) == 1);
+    assert(v.nbElements == 5 && v.capacite >= 5);
+
+    supprimerVecteurInt(&v, 1);        /* 10 12 13 14 */
+    assert(v.nbElements == 4 && *obtenirVecteurInt(&v, 1) == 12 && v.elements[3] == 14);
+
+    supprimerEchangeVecteurInt(&v, 0); /* 14 12 13 */
+    assert(v.nbElements == 3 && v.elements[0] == 14 && v.elements[2] == 13);
+
+    assert(reserverVecteurInt(&v, 100) == 1 && v.capacite >= 100);
+    viderVecteurInt(&v);
+    assert(v.nbElements == 0);
+    detruireVecteurInt(&v);
 }
 
 /* Tests pour Podium */
@@ -34,17 +124,49 @@ static void test_podium() {
     assert(comparer2Podiums(&p, clone) == 1);
 
     /* cleanup : freePodium libre les lments int* et detruireVecteur */
-    freePodium(clone);
+    freeClonePodium(clone);
     freePodium(&p);
 }
 
+/* Tests pour les cls d'tat (aller-retour, carte, split) */
+static void test_etat() {
+    Podium b, r;
+    assert(initPodium(&b, 1) == 1 && initPodium(&r, 1) == 1);
+    ajouterPodiumAnimal(&b, 2);
+    ajouterPodiumAnimal(&b, 0);
+    ajouterPodiumAnimal(&r, 1);
+
+    CleEtat cle = empaqueterPodiums(&b, &r);
+    const int carte[] = { 2, 2, 0, 1 };
+    assert(cle == empaqueterCarte(carte, 3));
+
+    /* mme ordre, split diffrent : cl diffrente */
+    const int autre[] = { 1, 2, 0, 1 };
+    assert(cle != empaqueterCarte(autre, 3));
+
+    Podium b2, r2;
+    assert(initPodium(&b2, 1) == 1 && initPodium(&r2, 1) == 1);
+    assert(depaqueterPodiums(cle, 3, &b2, &r2) == 1);
+    assert(comparer2Podiums(&b, &b2) == 1 && comparer2Podiums(&r, &r2) == 1);
+    assert(hacherCleEtat(cle) != hacherCleEtat(empaqueterCarte(autre, 3)));
+
+    freePodium(&b);
+    freePodium(&r);
+    freePodium(&b2);
+    freePodium(&r2);
+}
+
 /* Tests pour Joueur */
 static void test_joueur() {
     Joueurs js;
+    Arene arene;
+    PoolNoms noms;
+    initArene(&arene, 256);
+    assert(initPoolNoms(&noms, 10, 2, &arene) == 1);
     assert(initJoueurs(&js, 1) == 1);
 
-    ajouterJoueur(&js, "alice");
-    ajouterJoueur(&js, "bob");
+    assert(ajouterJoueur(&js, "alice", &noms) == 1);
+    assert(ajouterJoueur(&js, "bob", &noms) == 1);
 
     Joueur* a = obtenirJoueurParNom(&js, "alice");
     Joueur* b = obtenirJoueurParNom(&js, "bob");
@@ -52,33 +174,46 @@ static void test_joueur() {
     assert(joueurExiste(&js, "alice") == 1);
     assert(peutJouer(&js, "alice") == 1);
 
-    ajouterPointJoueur(&js, "alice");
+    Nom nom_a = a->nom;
+    Nom nom_b = b->nom;
+    b = ajouterPointJoueur(&js, b);
+    assert(memeNom(&b->nom, &nom_b) && b->points == 1);
+    ajouterPointJoueur(&js, b);
+    ajouterPointJoueur(&js, obtenirJoueurParNom(&js, "alice"));
     assert(obtenirJoueurParNom(&js, "alice")->points == 1);
 
+    /* classement : bob (2) devant alice (1) ; les joueurs sont dplacs par valeur */
+    a = obtenirJoueurParNom(&js, "alice");
+    b = obtenirJoueurParNom(&js, "bob");
+    assert(obtenirJoueur(&js, 0) == b);
+    assert(rangJoueur(&js, b) == 1);
+    assert(rangJoueur(&js, a) == 2);
+    Joueur* top[2];
+    assert(meilleursJoueurs(&js, 5, top) == 2 && top[0] == b && top[1] == a);
+    assert(memeNom(&top[0]->nom, &nom_b) && memeNom(&top[1]->nom, &nom_a));
+
     remetreTours(&js);
     for (int i = 0; i < js.nbElements; ++i) {
         Joueur* j = obtenirJoueur(&js, i);
         assert(j->tour == 1);
     }
 
-    /* cleanup : librer chaque joueur puis le vecteur */
-    for (int i = 0; i < js.nbElements; ++i) {
-        Joueur* j = obtenirJoueur(&js, i);
-        if (j) {
-            free(j->nom);
-            free(j);
-        }
-    }
-    detruireVecteur(&js);
+    /* cleanup : les noms vivent dans l'arne */
+    detruireVecteurJoueur(&js);
+    detruireArene(&arene);
 }
 
 /* Tests pour Commandes (vrification + excution basique) */
 static void test_commandes() {
     Commandes cmds;
+    Arene arene;
+    PoolNoms noms;
+    initArene(&arene, 256);
+    assert(initPoolNoms(&noms, 6, 2, &arene) == 1);
     assert(initCommandes(&cmds, 1) == 1);
 
-    ajouterCommande(&cmds, "KI");
-    ajouterCommande(&cmds, "LO");
+    assert(ajouterCommande(&cmds, "KI", &noms) == 1);
+    assert(ajouterCommande(&cmds, "LO", &noms) == 1);
 
     assert(verifierCommande(&cmds, "KI") == 1);
     assert(verifierCommande(&cmds, "XX") == 0);
@@ -95,34 +230,1470 @@ static void test_commandes() {
     int res = executerLigneCommandes(&cmds, "KI", &pb, &pr);
     assert(res == 1); /* doit russir */
 
-    /* cleanup commandes : librer Commande* cres */
-    for (int i = 0; i < cmds.nbElements; ++i) {
-        Commande* c = obtenirCommande(&cmds, i);
-        if (c) {
-            free(c->nom_commande);
-            free(c);
-        }
-    }
-    detruireVecteur(&cmds);
+    /* cleanup commandes : les noms vivent dans l'arne */
+    detruireVecteurCommande(&cmds);
+    detruireArene(&arene);
 
     freePodium(&pb);
     freePodium(&pr);
 }
 
+/* Tests pour l'valuation par lots (compare  executerLigneCommandes) */
+static void test_lot() {
+    static const char* codes[] = { "KI", "LO", "SO", "NI", "MA" };
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 7) == 0);
+
+    enum { NB = 300 };
+    Sequence seqs[NB];
+    char textes[NB][2 * 12 + 1];
+    ResultatSequence res[NB];
+    Aleatoire alea;
+    initAleatoire(&alea, 11);
+    for (int i = 0; i < NB; ++i) {
+        int longueur = (int)aleatoireBorne(&alea, 13);
+        for (int k = 0; k < longueur; ++k) {
+            memcpy(&textes[i][2 * k], codes[aleatoireBorne(&alea, 5)], 2);
+        }
+        textes[i][2 * longueur] = '\0';
+        assert(initSequence(&seqs[i], 1) == 1);
+        assert(compilerSequence(game.commandes, textes[i], &seqs[i]) == 1);
+    }
+    assert(evaluerLot(&game, seqs, NB, res) == 1);
+
+    for (int i = 0; i < NB; ++i) {
+        Podium* b = clonePodium(game.podium_b);
+        Podium* r = clonePodium(game.podium_r);
+        int attendu = executerLigneCommandes(game.commandes, textes[i], b, r);
+        if (attendu == 1) {
+            assert(res[i].echec < 0);
+            assert(res[i].finale == empaqueterPodiums(b, r));
+            assert(res[i].reussite == situationAtteinte(&game, b, r));
+        }
+        else {
+            assert(attendu == 2 && res[i].echec >= 0 && !res[i].reussite);
+        }
+        freeClonePodium(b);
+        freeClonePodium(r);
+        detruireSequence(&seqs[i]);
+    }
+
+    Sequence seq;
+    assert(initSequence(&seq, 1) == 1);
+    assert(compilerSequence(game.commandes, "KIX", &seq) == 2);
+    assert(compilerSequence(game.commandes, "KIXX", &seq) == 0);
+    detruireSequence(&seq);
+    detruireGame(&game);
+}
+
+/* Compare l'excuteur par sries  la boucle nave sur une chane donne */
+static void verifierExecuteur(Game* game, const char* texte) {
+    Podium* b = clonePodium(game->podium_b);
+    Podium* r = clonePodium(game->podium_r);
+    CleEtat cle = empaqueterPodiums(b, r);
+    int attendu = executerLigneCommandes(game->commandes, texte, b, r);
+    int obtenu = executerLigneCle(game->commandes, texte, &cle, (int)game->animaux->nbElements);
+    assert(attendu == obtenu);
+    if (attendu == 1) {
+        assert(cle == empaqueterPodiums(b, r));
+    }
+    freeClonePodium(b);
+    freeClonePodium(r);
+}
+
+/* Tests pour le cache de rsultats (rsultats identiques, succs, viction CLOCK) */
+static void test_cache() {
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 3) == 0);
+    int n = (int)game.animaux->nbElements;
+    CleEtat depart = empaqueterPodiums(game.podium_b, game.podium_r);
+
+    CacheCompositions cache;
+    assert(initCache(&cache, 4));
+    const char* chaines[] = { "NIMA", "SOSO", "KILO", "NINININI", "MAKIXX", "LOLOLO", "SOX" };
+    for (int tour = 0; tour < 3; ++tour) {
+        for (int i = 0; i < 7; ++i) {
+            CleEtat a = depart, b = depart;
+            assert(executerLigneCache(&cache, game.commandes, chaines[i], &a, n)
+                == executerLigneCle(game.commandes, chaines[i], &b, n));
+            assert(a == b);
+        }
+    }
+    /* "SOX" (longueur impaire) n'est pas compile ; 6 chanes, 4 entres */
+    assert(cache.stats.consultations == 18);
+    assert(cache.stats.nb_entrees == 4);
+    assert(cache.stats.evictions == cache.stats.insertions - 4);
+
+    /* une entre consulte survit au passage suivant de l'aiguille */
+    CacheCompositions petit;
+    assert(initCache(&petit, 2));
+    CleEtat c = depart;
+    executerLigneCache(&petit, game.commandes, "NIMA", &c, n);
+    c = depart;
+    executerLigneCache(&petit, game.commandes, "SOSO", &c, n);
+    c = depart;
+    executerLigneCache(&petit, game.commandes, "NIMA", &c, n);
+    assert(petit.stats.succes == 1);
+    c = depart;
+    executerLigneCache(&petit, game.commandes, "KILO", &c, n);
+    c = depart;
+    executerLigneCache(&petit, game.commandes, "NIMA", &c, n);
+    assert(petit.stats.succes == 2);
+    assert(petit.stats.evictions == 1);
+
+    detruireCache(&petit);
+    detruireCache(&cache);
+    detruireGame(&game);
+}
+
+/* Distance exacte par un parcours en largeur vers l'avant (rfrence) */
+static int distanceNaive(CleEtat depart, CleEtat cible, int n) {
+    CleEtat file[4096];
+    int distances[4096];
+    int nb = 0;
+    file[nb] = depart;
+    distances[nb++] = 0;
+    for (int k = 0; k < nb; ++k) {
+        if (file[k] == cible) return distances[k];
+        for (int op = 0; op < NB_OPS; ++op) {
+            CleEtat suivante = file[k];
+            if (!appliquerCommandeCle(&suivante, n, op)) continue;
+            int vue = 0;
+            for (int j = 0; j < nb && !vue; ++j) vue = file[j] == suivante;
+            if (!vue) {
+                file[nb] = suivante;
+                distances[nb++] = distances[k] + 1;
+            }
+        }
+    }
+    return DISTANCE_INFINIE;
+}
+
+/* Tests pour les distances  la cible et le rejet anticip */
+static void test_distance() {
+    static const char* codes[] = { "KI", "LO", "SO", "NI", "MA" };
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 3) == 0);
+    int n = (int)game.animaux->nbElements;
+
+    TableDistances table, partielle;
+    assert(initTableDistances(&table, 1 << 12));
+    assert(initTableDistances(&partielle, 4));
+    calculerDistances(&table, game.cle_cible, n, game.commandes, DISTANCE_INFINIE);
+    calculerDistances(&partielle, game.cle_cible, n, game.commandes, DISTANCE_INFINIE);
+    assert(table.complete && !partielle.complete);
+    for (int64_t i = 0; i < table.nb_etats; ++i) {
+        CleEtat s = table.file[i];
+        int exacte = distanceNaive(s, game.cle_cible, n);
+        assert(distanceMinimale(&table, s) == exacte);
+        assert(distanceMinimale(&partielle, s) <= exacte);
+        for (int op = 0; op < NB_OPS; ++op) {
+            CleEtat t = s;
+            if (appliquerCommandeCle(&t, n, op)) {
+                assert(appliquerCommandeInverseCle(&t, n, op) && t == s);
+            }
+        }
+    }
+
+    /* l'lagage ne perd aucune chane gagnante et ne gagne jamais  tort */
+    assert(choisirRejet(&game, REJET_PREFIXE));
+    CleEtat depart = empaqueterPodiums(game.podium_b, game.podium_r);
+    assert(game.distance_depart == distanceNaive(depart, game.cle_cible, n));
+    Aleatoire alea;
+    initAleatoire(&alea, 11);
+    char texte[2 * 12 + 1];
+    int gagnantes = 0;
+    for (int essai = 0; essai < 20000; ++essai) {
+        int longueur = (int)aleatoireBorne(&alea, 12);
+        for (int k = 0; k < longueur; ++k) {
+            memcpy(&texte[2 * k], codes[aleatoireBorne(&alea, 5)], 2);
+        }
+        texte[2 * longueur] = '\0';
+        CleEtat a = depart, b = depart;
+        int elaguee = executerLigneElaguee(&game.distances, game.commandes, texte, &a, n);
+        int complete = executerLigneCle(game.commandes, texte, &b, n);
+        int gagne = complete == 1 && b == game.cle_cible;
+        assert(elaguee == complete);
+        assert(gagne == (elaguee == 1 && a == game.cle_cible));
+        if (gagne) {
+            assert(longueur >= game.distance_depart);
+            ++gagnantes;
+        }
+    }
+    assert(gagnantes > 0);
+
+    /* une chaine courte invalide garde son verdict : le joueur n'est pas bloque */
+    int impossible = -1;
+    for (int op = 0; op < NB_OPS && impossible < 0; ++op) {
+        CleEtat t = depart;
+        if (!appliquerCommandeCle(&t, n, op) && verifierCommande(game.commandes, (char*)codes[op])) impossible = op;
+    }
+    assert(impossible >= 0 && game.distance_depart >= 2);
+    game.sortie = sortieNulle();
+    for (int mode = REJET_COURT; mode <= REJET_PREFIXE; ++mode) {
+        assert(choisirRejet(&game, (ModeRejet)mode));
+        char inconnue[] = "alice XX";
+        traiterLigne(&game, inconnue);
+        char illegale[16];
+        sprintf(illegale, "alice %s", codes[impossible]);
+        traiterLigne(&game, illegale);
+        assert(peutJouer(game.joueurs, noms[0]) == 1);
+        assert(empaqueterPodiums(game.podium_b, game.podium_r) == depart);
+    }
+
+    detruireTableDistances(&partielle);
+    detruireTableDistances(&table);
+    detruireGame(&game);
+}
+
+/* Coups reus du moteur de robots */
+typedef struct {
+    mtx_t verrou;
+    int nb;
+    int salle;
+    uint64_t tour;
+    char ligne[128];
+} CoupsRecus;
+
+static void recevoirCoup(void* contexte, int salle, uint64_t tour, const char* ligne) {
+    CoupsRecus* recus = (CoupsRecus*)contexte;
+    mtx_lock(&recus->verrou);
+    ++recus->nb;
+    recus->salle = salle;
+    recus->tour = tour;
+    strncpy(recus->ligne, ligne, sizeof(recus->ligne) - 1);
+    mtx_unlock(&recus->verrou);
+}
+
+/* Tests pour les robots (coup optimal, coup au hasard, envoi aprs le budget) */
+static void test_robot() {
+    char* noms[] = { "alice", "robot" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 3) == 0);
+    int n = (int)game.animaux->nbElements;
+    CleEtat depart = empaqueterPodiums(game.podium_b, game.podium_r);
+    int optimale = distanceNaive(depart, game.cle_cible, n);
+
+    TableDistances table;
+    assert(initTableDistances(&table, MAX_ETATS_DISTANCE));
+    Aleatoire alea;
+    initAleatoire(&alea, 2);
+    Sequence coup;
+    initSequence(&coup, 0);
+    assert(calculerCoupRobot(&table, &alea, optimale, depart, game.cle_cible, n, game.commandes, &coup) == 1);
+    assert(coup.nbElements == optimale);
+    CleEtat cle = depart;
+    assert(executerSequenceCle(&cle, n, coup.elements, coup.nbElements) == -1 && cle == game.cle_cible);
+    if (optimale > 1) {
+        assert(calculerCoupRobot(&table, &alea, optimale - 1, depart, game.cle_cible, n, game.commandes, &coup) == 0);
+    }
+    assert(calculerCoupRobot(&table, &alea, 0, depart, game.cle_cible, n, game.commandes, &coup) == 0);
+    assert(coup.nbElements >= 1);
+
+    /* le coup arrive par la fonction d'envoi, pas avant le budget */
+    CoupsRecus recus = { 0 };
+    mtx_init(&recus.verrou, mtx_plain);
+    MoteurRobots moteur;
+    assert(demarrerRobots(&moteur, 2, game.commandes, recevoirCoup, &recus, 7));
+    Robot robot = { obtenirJoueurParNom(game.joueurs, "robot")->nom, 8, 30 };
+    uint64_t debut = maintenantMs();
+    solliciterRobot(&moteur, 12, &robot, depart, game.cle_cible, n, 3, debut, NULL);
+    int nb = 0;
+    while (nb == 0) {
+        thrd_sleep(&(struct timespec){ .tv_nsec = 1000000 }, NULL);
+        mtx_lock(&recus.verrou);
+        nb = recus.nb;
+        mtx_unlock(&recus.verrou);
+    }
+    assert(maintenantMs() - debut >= 30);
+    arreterRobots(&moteur);
+    detruireRobots(&moteur);
+    assert(recus.nb == 1 && recus.salle == 12 && recus.tour == 3);
+    assert(strncmp(recus.ligne, "robot ", 6) == 0);
+    cle = depart;
+    assert(executerLigneCle(game.commandes, recus.ligne + 6, &cle, n) == 1 && cle == game.cle_cible);
+
+    mtx_destroy(&recus.verrou);
+    detruireSequence(&coup);
+    detruireTableDistances(&table);
+    detruireGame(&game);
+}
+
+/* Tests pour le journal (relecture des points et de la donne, fin incomplte) */
+static void test_journal() {
+    const char* chemin = "test_journal.tmp";
+    remove(chemin);
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 5) == 0);
+    int n = (int)game.animaux->nbElements;
+    Journal journal;
+    assert(ouvrirJournal(&journal, chemin, 2));
+    game.journal = &journal;
+
+    TableDistances table;
+    assert(initTableDistances(&table, MAX_ETATS_DISTANCE));
+    Sequence chemin_optimal;
+    initSequence(&chemin_optimal, 0);
+    for (int tour = 0; tour < 40; ++tour) {
+        calculerDistances(&table, game.cle_cible, n, game.commandes, DISTANCE_INFINIE);
+        if (!cheminOptimal(&table, empaqueterPodiums(game.podium_b, game.podium_r), &chemin_optimal)
+            || chemin_optimal.nbElements == 0) {
+            expirerTour(&game);
+            continue;
+        }
+        char ligne[64];
+        int longueur = sprintf(ligne, "%s ", noms[tour % 3 == 0]);
+        for (int64_t i = 0; i < chemin_optimal.nbElements; ++i) {
+            longueur += sprintf(&ligne[longueur], "%s", nomCommande(chemin_optimal.elements[i]));
+        }
+        traiterLigne(&game, ligne);
+        /* aprs une victoire, le gagnant reste bloqu jusqu' la redistribution suivante */
+        remetreTours(game.joueurs);
+    }
+    game.journal = NULL;
+    uint64_t nb_evenements = journal.nb_evenements;
+    assert(fermerJournal(&journal));
+    assert(journal.nb_synchronisations >= 1);
+
+    Game reprise;
+    assert(initGameConfigGraine(&reprise, "crazy.cfg", 2, noms, 99) == 0);
+    assert(reprendreJournal(&reprise, chemin, NULL) == (int64_t)nb_evenements);
+    for (int i = 0; i < 2; ++i) {
+        assert(obtenirJoueurParNom(reprise.joueurs, noms[i])->points == obtenirJoueurParNom(game.joueurs, noms[i])->points);
+    }
+    assert(obtenirJoueurParNom(reprise.joueurs, "alice")->points > 0);
+    assert(reprise.cle_cible == game.cle_cible);
+    assert(empaqueterPodiums(reprise.podium_b, reprise.podium_r) == empaqueterPodiums(game.podium_b, game.podium_r));
+
+    /* un enregistrement incomplet est ignor puis supprim  la rouverture */
+    FILE* f = fopen(chemin, "ab");
+    fwrite("\x01\x05\x00al", 1, 5, f);
+    fclose(f);
+    assert(lireJournal(chemin, NULL, NULL) == (int64_t)nb_evenements);
+    assert(ouvrirJournal(&journal, chemin, 0));
+    journaliserPoint(&journal, "bob", 3);
+    assert(fermerJournal(&journal));
+    assert(lireJournal(chemin, NULL, NULL) == (int64_t)nb_evenements + 1);
+
+    /* un journal d'une autre version n'est pas remplace par un journal vide */
+    f = fopen(chemin, "r+b");
+    fseek(f, 0, SEEK_END);
+    long taille = ftell(f);
+    fseek(f, 8, SEEK_SET);
+    fputc(VERSION_JOURNAL + 1, f);
+    fclose(f);
+    assert(!ouvrirJournal(&journal, chemin, 0));
+    f = fopen(chemin, "rb");
+    fseek(f, 8, SEEK_SET);
+    assert(fgetc(f) == VERSION_JOURNAL + 1);
+    fseek(f, 0, SEEK_END);
+    assert(ftell(f) == taille);
+    fclose(f);
+
+    detruireSequence(&chemin_optimal);
+    detruireTableDistances(&table);
+    detruireGame(&reprise);
+    detruireGame(&game);
+    remove(chemin);
+}
+
+/* joue des tours gagns (chemin optimal) par l'un ou l'autre joueur */
+static void jouerToursOptimaux(Game* game, char** noms, int nb_tours, int premier) {
+    int n = (int)game->animaux->nbElements;
+    TableDistances table;
+    assert(initTableDistances(&table, MAX_ETATS_DISTANCE));
+    Sequence chemin_optimal;
+    initSequence(&chemin_optimal, 0);
+    for (int tour = premier; tour < premier + nb_tours; ++tour) {
+        calculerDistances(&table, game->cle_cible, n, game->commandes, DISTANCE_INFINIE);
+        if (!cheminOptimal(&table, empaqueterPodiums(game->podium_b, game->podium_r), &chemin_optimal)
+            || chemin_optimal.nbElements == 0) {
+            expirerTour(game);
+            continue;
+        }
+        char ligne[64];
+        int longueur = sprintf(ligne, "%s ", noms[tour % 3 == 0]);
+        for (int64_t i = 0; i < chemin_optimal.nbElements; ++i) {
+            longueur += sprintf(&ligne[longueur], "%s", nomCommande(chemin_optimal.elements[i]));
+        }
+        traiterLigne(game, ligne);
+        remetreTours(game->joueurs);
+    }
+    detruireSequence(&chemin_optimal);
+    detruireTableDistances(&table);
+}
+
+static void verifierMemesScores(const Game* a, const Game* b, char** noms, int nb) {
+    for (int i = 0; i < nb; ++i) {
+        assert(obtenirJoueurParNom(a->joueurs, noms[i])->points == obtenirJoueurParNom(b->joueurs, noms[i])->points);
+    }
+    assert(a->cle_cible == b->cle_cible);
+    assert(empaqueterPodiums(a->podium_b, a->podium_r) == empaqueterPodiums(b->podium_b, b->podium_r));
+}
+
+/* Tests pour les instantans et les points de reprise */
+static void test_instantane() {
+    const char* chemin_instantane = "test_instantane.tmp";
+    const char* chemin_journal = "test_instantane_journal.tmp";
+    remove(chemin_instantane);
+    remove(chemin_journal);
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 11) == 0);
+    jouerToursOptimaux(&game, noms, 20, 0);
+    obtenirJoueurParNom(game.joueurs, "bob")->tour = 0;
+
+    /* aller-retour en mmoire : mme tat, mme donne suivante */
+    Tampon t;
+    initTampon(&t);
+    assert(ecrireInstantane(&game, NULL, &t));
+    Game copie;
+    PositionJournal position;
+    assert(restaurerInstantane(&copie, &game, (const uint8_t*)t.donnees, t.taille, &position) == 0);
+    assert(position.generation == UINT32_MAX);
+    verifierMemesScores(&copie, &game, noms, 2);
+    for (int i = 0; i < 2; ++i) {
+        const Joueur* a = obtenirJoueur(copie.joueurs, i);
+        const Joueur* b = obtenirJoueur(game.joueurs, i);
+        assert(strcmp(a->nom.texte, b->nom.texte) == 0 && a->tour == b->tour && a->nb_coups == b->nb_coups);
+    }
+    assert(copie.numero_tour == game.numero_tour);
+    assert(empaqueterPodiums(copie.target_b, copie.target_r) == game.cle_cible);
+    nouveauTour(&copie);
+    nouveauTour(&game);
+    verifierMemesScores(&copie, &game, noms, 2);
+    detruireGame(&copie);
+
+    /* un octet altr ou un instantan tronqu sont refuss */
+    t.donnees[t.taille / 2] ^= 0x10;
+    assert(restaurerInstantane(&copie, &game, (const uint8_t*)t.donnees, t.taille, NULL) == -1);
+    t.donnees[t.taille / 2] ^= 0x10;
+    assert(restaurerInstantane(&copie, &game, (const uint8_t*)t.donnees, t.taille - 1, NULL) == -1);
+    detruireTampon(&t);
+
+    /* instantan sans renouvellement (arrt juste aprs) : relecture depuis la position */
+    Journal journal;
+    assert(ouvrirJournal(&journal, chemin_journal, 1));
+    game.journal = &journal;
+    jouerToursOptimaux(&game, noms, 10, 20);
+    assert(sauvegarderInstantane(&game, &journal.fin, chemin_instantane));
+    jouerToursOptimaux(&game, noms, 10, 30);
+    game.journal = NULL;
+    assert(fermerJournal(&journal));
+    Game reprise;
+    assert(reprendrePartie(&reprise, &game, chemin_instantane, chemin_journal) > 0);
+    verifierMemesScores(&reprise, &game, noms, 2);
+    detruireGame(&reprise);
+
+    /* point de reprise : le journal renouvel ne contient que la suite */
+    assert(ouvrirJournal(&journal, chemin_journal, 1));
+    game.journal = &journal;
+    assert(pointDeReprise(&game, chemin_instantane, chemin_journal));
+    assert(journal.fin.generation == 1);
+    jouerToursOptimaux(&game, noms, 10, 40);
+    game.journal = NULL;
+    uint64_t nb_evenements = journal.nb_evenements;
+    assert(fermerJournal(&journal));
+    assert(lireJournal(chemin_journal, NULL, NULL) == (int64_t)nb_evenements);
+    assert(reprendrePartie(&reprise, &game, chemin_instantane, chemin_journal) == (int64_t)nb_evenements);
+    verifierMemesScores(&reprise, &game, noms, 2);
+    detruireGame(&reprise);
+
+    assert(reprendrePartie(&reprise, &game, "absent.tmp", chemin_journal) == -1);
+    detruireGame(&game);
+    remove(chemin_instantane);
+    remove(chemin_journal);
+}
+
+static void attendreMilli(long ms) {
+    struct timespec duree = { ms / 1000, (ms % 1000) * 1000000L };
+    thrd_sleep(&duree, NULL);
+}
+
+static void ecrireTexte(const char* chemin, const char* texte) {
+    FILE* f = fopen(chemin, "w");
+    assert(f);
+    fputs(texte, f);
+    fclose(f);
+}
+
+/* Tests pour le rechargement  chaud de la configuration */
+static void test_rechargement() {
+    const char* chemin = "test_rechargement.cfg";
+    const char* paquet = "test_rechargement.cfg.paquet";
+    ecrireTexte(chemin, "OURS ELEPHANT PIGEON\nKI LO SO NI MA\n");
+    Rechargeur r;
+    assert(demarrerRechargeur(&r, chemin, 10));
+    ConfigPartagee* ancienne = acquerirConfig(&r);
+    assert(ancienne->generation == 0 && generationConfig(&r) == 0);
+
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGamePartagee(&game, &ancienne->modele, 2, noms, 3) == 0);
+    ajouterPointJoueur(game.joueurs, obtenirJoueurParNom(game.joueurs, "bob"));
+
+    /* la modification du fichier est vue par le fil de surveillance */
+    ecrireTexte(chemin, "OURS ELEPHANT PIGEON LION\nKI LO SO\n");
+    for (int i = 0; i < 500 && generationConfig(&r) == 0; ++i) {
+        attendreMilli(10);
+    }
+    assert(generationConfig(&r) == 1);
+    ConfigPartagee* nouvelle = acquerirConfig(&r);
+    assert(nouvelle->modele.animaux->nbElements == 4 && nouvelle->modele.commandes->nbElements == 3);
+
+    /* la partie garde l'ancienne configuration jusqu' la distribution suivante */
+    changerModele(&game, &nouvelle->modele);
+    assert(game.animaux == ancienne->modele.animaux);
+    nouveauTour(&game);
+    assert(game.animaux == nouvelle->modele.animaux && game.cartes == nouvelle->modele.cartes);
+    assert(game.podium_b->nbElements + game.podium_r->nbElements == 4);
+    assert(game.cle_cible == empaqueterPodiums(game.target_b, game.target_r));
+    assert(obtenirJoueurParNom(game.joueurs, "bob")->points == 1);
+
+    /* un fichier invalide laisse la configuration publie en place */
+    ecrireTexte(chemin, "OURS ELEPHANT\nKI XX\n");
+    for (int i = 0; i < 500; ++i) {
+        mtx_lock(&r.verrou);
+        uint64_t nb_echecs = r.nb_echecs;
+        mtx_unlock(&r.verrou);
+        if (nb_echecs > 0) break;
+        attendreMilli(10);
+    }
+    assert(r.nb_echecs >= 1 && generationConfig(&r) == 1);
+
+    /* la configuration remplace vit jusqu' son dernier utilisateur */
+    relacherConfig(ancienne);
+    ecrireTexte(chemin, "OURS ELEPHANT PIGEON\nKI LO SO NI MA\n");
+    assert(rechargerConfig(&r));
+    assert(generationConfig(&r) >= 2);
+    arreterRechargeur(&r);
+    assert(game.commandes->nbElements == 3);
+    detruireGame(&game);
+    relacherConfig(nouvelle);
+    remove(chemin);
+    remove(paquet);
+}
+
+/* Tests pour les histogrammes de latence */
+static void test_histogramme() {
+    Histogramme h;
+    initHistogramme(&h);
+    assert(centileHistogramme(&h, 50.0) == 0);
+    for (uint64_t v = 1; v <= 100000; ++v) {
+        enregistrerHistogramme(&h, v * 1000);
+    }
+    assert(h.nb == 100000 && h.min == 1000 && h.max == 100000000);
+    /* erreur relative sous 1 % */
+    uint64_t p50 = centileHistogramme(&h, 50.0);
+    uint64_t p99 = centileHistogramme(&h, 99.0);
+    uint64_t p999 = centileHistogramme(&h, 99.9);
+    assert(p50 >= 50000000 && p50 <= 50500000);
+    assert(p99 >= 99000000 && p99 <= 99990000);
+    assert(p999 >= 99900000 && p999 <= 100000000);
+    assert(centileHistogramme(&h, 100.0) == h.max && centileHistogramme(&h, 0.0) == h.min);
+
+    /* petites valeurs exactes, grandes valeurs bornes, fusion */
+    Histogramme petites;
+    initHistogramme(&petites);
+    for (uint64_t v = 0; v < 100; ++v) {
+        enregistrerHistogramme(&petites, v);
+    }
+    assert(centileHistogramme(&petites, 50.0) == 49);
+    enregistrerHistogramme(&petites, UINT64_MAX / 2);
+    assert(seauHistogramme(UINT64_MAX / 2) == NB_SEAUX_HISTOGRAMME - 1);
+    assert(centileHistogramme(&petites, 100.0) == UINT64_MAX / 2);
+    fusionnerHistogramme(&h, &petites);
+    assert(h.nb == 100101 && h.min == 0 && h.max == UINT64_MAX / 2);
+
+    /* mesures d'une partie : une par ligne, par donne et par coup jou */
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 4) == 0);
+    assert(activerMesures(&game));
+    char ligne1[] = "alice KI";
+    char ligne2[] = "personne KI";
+    traiterLigne(&game, ligne1);
+    traiterLigne(&game, ligne2);
+    assert(game.mesures->ligne.nb == 2);
+    assert(obtenirJoueurParNom(game.joueurs, "alice")->reflexion->nb == 1);
+    assert(obtenirJoueurParNom(game.joueurs, "bob")->reflexion->nb == 0);
+    uint64_t donnes = game.mesures->donne.nb;
+    nouveauTour(&game);
+    assert(game.mesures->donne.nb == donnes + 1);
+    game.sortie = sortieNulle();
+    afficherMesures(&game);
+    detruireGame(&game);
+}
+
+/* Tests pour la comptabilite de la memoire par sous-systeme */
+static void test_memoire() {
+    BilanMemoire avant[NB_SOUS_SYSTEMES];
+    for (int i = 0; i < NB_SOUS_SYSTEMES; ++i) {
+        avant[i] = bilanMemoire((SousSysteme)i);
+    }
+
+    char* p = allouerMemoire(MEMOIRE_AUTRE, 100);
+    assert(p);
+    BilanMemoire b = bilanMemoire(MEMOIRE_AUTRE);
+    assert(b.vivants == avant[MEMOIRE_AUTRE].vivants + 100);
+    assert(b.nb_allocations == avant[MEMOIRE_AUTRE].nb_allocations + 1);
+    p = reallouerMemoire(MEMOIRE_AUTRE, p, 100, 300);
+    assert(p);
+    b = bilanMemoire(MEMOIRE_AUTRE);
+    assert(b.vivants == avant[MEMOIRE_AUTRE].vivants + 300 && b.pic >= b.vivants);
+    libererMemoire(MEMOIRE_AUTRE, p, 300);
+    assert(bilanMemoire(MEMOIRE_AUTRE).vivants == avant[MEMOIRE_AUTRE].vivants);
+
+    /* une partie compte sa configuration, son paquet, ses joueurs et ses podiums */
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 6) == 0);
+    game.sortie = sortieNulle();
+    assert(bilanMemoire(MEMOIRE_CONFIG).vivants > avant[MEMOIRE_CONFIG].vivants);
+    assert(bilanMemoire(MEMOIRE_PAQUET).vivants > avant[MEMOIRE_PAQUET].vivants);
+    assert(bilanMemoire(MEMOIRE_JOUEURS).vivants > avant[MEMOIRE_JOUEURS].vivants);
+    assert(bilanMemoire(MEMOIRE_PODIUMS).vivants > avant[MEMOIRE_PODIUMS].vivants);
+    int64_t podiums = bilanMemoire(MEMOIRE_PODIUMS).nb_allocations;
+    Podium* copie = clonePodium(game.podium_b);
+    assert(bilanMemoire(MEMOIRE_PODIUMS).nb_allocations >= podiums + 2);
+    freeClonePodium(copie);
+    char ligne[] = "alice KI";
+    traiterLigne(&game, ligne);
+
+    /* tables du solveur */
+    int64_t tables = bilanMemoire(MEMOIRE_TABLES).vivants;
+    TableDistances table;
+    assert(initTableDistances(&table, 1000));
+    CacheCompositions cache;
+    assert(initCache(&cache, 2));
+    const char* chaines[] = { "NIMA", "SOSO", "KILO" };
+    for (int i = 0; i < 3; ++i) {
+        CleEtat c = empaqueterPodiums(game.podium_b, game.podium_r);
+        executerLigneCache(&cache, game.commandes, chaines[i], &c, (int)game.animaux->nbElements);
+    }
+    assert(bilanMemoire(MEMOIRE_TABLES).vivants > tables + 1000 * (int64_t)sizeof(CleEtat));
+    afficherMemoire(sortieNulle());
+    detruireCache(&cache);
+    detruireTableDistances(&table);
+    detruireGame(&game);
+
+    /* tout est rendu, les pics restent */
+    for (int i = 0; i < NB_SOUS_SYSTEMES; ++i) {
+        b = bilanMemoire((SousSysteme)i);
+        assert(b.vivants == avant[i].vivants);
+        assert(b.pic >= b.vivants && b.nb_allocations >= avant[i].nb_allocations);
+    }
+    assert(bilanMemoire(MEMOIRE_PAQUET).pic > avant[MEMOIRE_PAQUET].vivants);
+    assert(strcmp(nomSousSysteme(MEMOIRE_TABLES), "tables") == 0);
+}
+
+/* Tests pour la trace d'execution */
+static int filTrace(void* arg) {
+    (void)arg;
+    nommerFilTrace("auxiliaire \"2\"");
+    debutTrace("tache");
+    finTrace("tache");
+    return 0;
+}
+
+static char* lireTexte(const char* chemin) {
+    FILE* f = fopen(chemin, "rb");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long taille = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char* texte = malloc((size_t)taille + 1);
+    assert(fread(texte, 1, (size_t)taille, f) == (size_t)taille);
+    texte[taille] = '\0';
+    fclose(f);
+    return texte;
+}
+
+static int compterOccurrences(const char* texte, const char* motif) {
+    int nb = 0;
+    for (const char* c = strstr(texte, motif); c; c = strstr(c + 1, motif)) ++nb;
+    return nb;
+}
+
+static void test_trace() {
+    const char* chemin = "test_trace.json";
+    /* hors mode trace, rien n'est enregistre ni ecrit */
+    debutTrace("ignore");
+    assert(!ecrireTrace(chemin));
+
+    assert(demarrerTrace(60));
+    assert(!demarrerTrace(60));
+    nommerFilTrace("principal");
+    debutTrace("tour");
+    finTrace("tour");
+    thrd_t fil;
+    assert(thrd_create(&fil, filTrace, NULL) == thrd_success);
+    thrd_join(fil, NULL);
+    assert(ecrireTrace(chemin));
+    char* texte = lireTexte(chemin);
+    assert(strncmp(texte, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39) == 0);
+    assert(compterOccurrences(texte, "\"thread_name\"") == 2);
+    assert(strstr(texte, "\"name\":\"principal\"") && strstr(texte, "\"name\":\"auxiliaire \\\"2\\\"\""));
+    assert(compterOccurrences(texte, "\"name\":\"tour\",\"ph\":\"B\"") == 1);
+    assert(compterOccurrences(texte, "\"name\":\"tour\",\"ph\":\"E\"") == 1);
+    assert(compterOccurrences(texte, "\"name\":\"tache\"") == 2);
+    assert(!strstr(texte, "ignore"));
+    free(texte);
+
+    /* un tampon plein garde les evenements les plus recents (capacite arrondie a 64) */
+    for (int i = 0; i < 100; ++i) {
+        debutTrace("rempli");
+        finTrace("rempli");
+    }
+    assert(ecrireTrace(chemin));
+    texte = lireTexte(chemin);
+    assert(compterOccurrences(texte, "\"name\":\"rempli\"") == 64);
+    assert(!strstr(texte, "\"name\":\"tour\""));
+    free(texte);
+
+    arreterTrace();
+    assert(!ecrireTrace(chemin));
+    debutTrace("ignore");
+    /* une nouvelle session repart de tampons vides */
+    assert(demarrerTrace(8));
+    finTrace("seul");
+    assert(ecrireTrace(chemin));
+    texte = lireTexte(chemin);
+    assert(compterOccurrences(texte, "\"ph\":\"E\"") == 1 && !strstr(texte, "rempli"));
+    free(texte);
+    arreterTrace();
+    remove(chemin);
+}
+
+/* Tests pour le flux d'analyses des tours */
+static void ignorerReponse(void* contexte, int64_t client, int salle, const char* texte, size_t longueur) {
+    (void)contexte; (void)client; (void)salle; (void)texte; (void)longueur;
+}
+
+static void test_analyses() {
+    BilanTour b;
+    memset(&b, 0, sizeof(b));
+    b.partie = 2;
+    b.tour = 5;
+    b.carte = 1;
+    b.cible = 3;
+    b.nb_animaux = 3;
+    b.depart_b[0] = 0;
+    b.depart_b[1] = 2;
+    b.nb_depart_b = 2;
+    b.depart_r[0] = 1;
+    b.nb_depart_r = 1;
+    for (int i = 0; i < 3; ++i) b.arrivee_r[i] = (uint8_t)i;
+    b.nb_arrivee_r = 3;
+    b.distance = -1;
+    b.fin = FIN_GAGNE;
+    strcpy(b.gagnant, "a\"b");
+    b.longueur = 4;
+    b.duree_ms = 900;
+    b.nb_echecs = 2;
+    b.echecs_ms[0] = 100;
+    b.echecs_ms[1] = 250;
+    Tampon ligne;
+    initTampon(&ligne);
+    assert(ecrireBilanJson(&b, &ligne));
+    const char* attendu = "{\"partie\":2,\"tour\":5,\"carte\":1,\"cible\":3,\"depart\":{\"b\":[0,2],\"r\":[1]},"
+        "\"arrivee\":{\"b\":[],\"r\":[0,1,2]},\"distance\":null,\"fin\":\"gagne\",\"gagnant\":\"a\\\"b\","
+        "\"longueur\":4,\"duree_ms\":900,\"echecs\":2,\"echecs_ms\":[100,250]}\n";
+    assert(ligne.taille == strlen(attendu) && memcmp(ligne.donnees, attendu, ligne.taille) == 0);
+    detruireTampon(&ligne);
+
+    /* une partie : un echec qui clot le tour, des tours gagnes puis un tour ecoule */
+    const char* chemin = "test_analyses.jsonl";
+    remove(chemin);
+    Analyses analyses;
+    assert(ouvrirAnalyses(&analyses, chemin, 64));
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 8) == 0);
+    game.sortie = sortieNulle();
+    assert(choisirRejet(&game, REJET_COURT));
+    attacherAnalyses(&game, &analyses, 7);
+    assert(game.bilan.tour == game.numero_tour && game.bilan.distance >= 1);
+    char faux[] = "alice KI";
+    traiterLigne(&game, faux);
+    assert(obtenirJoueurParNom(game.joueurs, "bob")->points == 1);
+    jouerToursOptimaux(&game, noms, 3, 0);
+    expirerTour(&game);
+    detruireGame(&game);
+    assert(fermerAnalyses(&analyses));
+    assert(analyses.nb_ecrits == 5 && analyses.nb_perdus == 0);
+
+    char* texte = lireTexte(chemin);
+    assert(compterOccurrences(texte, "\n") == 5 && compterOccurrences(texte, "{\"partie\":7,") == 5);
+    assert(strstr(texte, "\"fin\":\"dernier\",\"gagnant\":\"bob\",\"longueur\":null,") < strchr(texte, '\n'));
+    assert(strstr(texte, "\"echecs\":1,\"echecs_ms\":[") < strchr(texte, '\n'));
+    assert(compterOccurrences(texte, "\"fin\":\"gagne\",\"gagnant\":\"") == 3);
+    assert(strstr(texte, "\"fin\":\"delai\",\"gagnant\":null,\"longueur\":null,"));
+    assert(!strstr(texte, "\"distance\":null"));
+    free(texte);
+
+    /* file saturee : les bilans en trop sont perdus et comptes */
+    assert(ouvrirAnalyses(&analyses, chemin, 1));
+    for (int i = 0; i < 1000; ++i) {
+        b.tour = (uint64_t)i;
+        publierBilan(&analyses, &b);
+    }
+    assert(fermerAnalyses(&analyses));
+    assert(analyses.nb_ecrits + analyses.nb_perdus == 1000);
+    texte = lireTexte(chemin);
+    assert(compterOccurrences(texte, "\n") == 5 + (int)analyses.nb_ecrits);
+    free(texte);
+
+    /* sans rejet anticipe, la distance est publiee sans changer le traitement des chaines */
+    remove(chemin);
+    assert(ouvrirAnalyses(&analyses, chemin, 64));
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 8) == 0);
+    game.sortie = sortieNulle();
+    attacherAnalyses(&game, &analyses, 6);
+    assert(game.rejet == REJET_AUCUN && game.bilan.distance >= 1);
+    detruireGame(&game);
+
+    /* salles du serveur : la distance de depart figure aussi dans leurs bilans */
+    Serveur serveur;
+    assert(initServeur(&serveur, "crazy.cfg", 1, 3, 0, ignorerReponse, NULL) == 0);
+    serveur.analyses = &analyses;
+    assert(envoyerLigneServeur(&serveur, "4 ouvrir alice bob", -1));
+    assert(envoyerLigneServeur(&serveur, "4 alice KI", -1));
+    assert(envoyerLigneServeur(&serveur, "4 bob KI", -1));
+    arreterServeur(&serveur);
+    assert(fermerAnalyses(&analyses));
+    texte = lireTexte(chemin);
+    assert(compterOccurrences(texte, "{\"partie\":4,") == 2);
+    assert(strstr(texte, "\"distance\":") && !strstr(texte, "\"distance\":null"));
+    free(texte);
+    remove(chemin);
+}
+
+/* situation sous la forme {"b":[...],"r":[...]} des requetes du solveur */
+static void ecrireSituationTest(char* texte, CleEtat cle, const Animaux* animaux) {
+    int n = (int)animaux->nbElements;
+    int split = (int)(cle & 0xF);
+    texte += sprintf(texte, "{\"b\":[");
+    for (int k = 0; k < n; ++k) {
+        if (k == split) texte += sprintf(texte, "],\"r\":[");
+        const char* nom = animaux->elements[(cle >> (4 + 4 * k)) & 0xF].nom_animal.texte;
+        texte += sprintf(texte, (k == 0 || k == split) ? "\"%s\"" : ",\"%s\"", nom);
+    }
+    if (split == n) texte += sprintf(texte, "],\"r\":[");
+    sprintf(texte, "]}");
+}
+
+/* Tests pour le solveur par lots */
+static void test_solveur() {
+    Game modele;
+    assert(chargerConfigGame(&modele, "crazy.cfg") == 0);
+    int n = (int)modele.animaux->nbElements;
+    assert(n == 3);
+    static const int permutations[6][3] = { {0,1,2}, {0,2,1}, {1,0,2}, {1,2,0}, {2,0,1}, {2,1,0} };
+    CleEtat situations[24];
+    for (int i = 0; i < 24; ++i) {
+        int carte[4] = { i / 6, permutations[i % 6][0], permutations[i % 6][1], permutations[i % 6][2] };
+        situations[i] = empaqueterCarte(carte, n);
+    }
+
+    /* chaque reponse est une plus courte sequence : sa longueur est celle d'une table calculee pour la cible
+       elle-meme (sans renommage) et elle mene du depart a la cible */
+    ContexteSolveur c;
+    assert(initContexteSolveur(&c, &modele, 0));
+    TableDistances directe;
+    assert(initTableDistances(&directe, MAX_ETATS_DISTANCE));
+    Sequence seq;
+    assert(initSequence(&seq, 16));
+    Tampon reponse;
+    initTampon(&reponse);
+    char depart[128], cible[128], requete[400], attendu[64];
+    int nb_resolues = 0, nb_inaccessibles = 0;
+    for (int j = 0; j < 24; ++j) {
+        calculerDistances(&directe, situations[j], n, modele.commandes, DISTANCE_INFINIE);
+        ecrireSituationTest(cible, situations[j], modele.animaux);
+        for (int i = 0; i < 24; ++i) {
+            ecrireSituationTest(depart, situations[i], modele.animaux);
+            sprintf(requete, " {\"id\":%d, \"note\":[1,{\"x\":null}], \"depart\":%s,\"cible\":%s} ", 24 * j + i, depart, cible);
+            reponse.taille = 0;
+            assert(resoudreRequete(&c, requete, strlen(requete), &reponse));
+            assert(ajouterTampon(&reponse, "", 1));
+            int d = distanceMinimale(&directe, situations[i]);
+            if (d == DISTANCE_INFINIE) {
+                sprintf(attendu, "{\"id\":%d,\"longueur\":null,\"sequence\":null}\n", 24 * j + i);
+                assert(strcmp(reponse.donnees, attendu) == 0);
+                ++nb_inaccessibles;
+                continue;
+            }
+            sprintf(attendu, "{\"id\":%d,\"longueur\":%d,\"sequence\":\"", 24 * j + i, d);
+            assert(strncmp(reponse.donnees, attendu, strlen(attendu)) == 0);
+            char* commandes = reponse.donnees + strlen(attendu);
+            *strchr(commandes, '"') = '\0';
+            assert((int)strlen(commandes) == 2 * d);
+            assert(compilerSequence(modele.commandes, commandes, &seq) == 1);
+            CleEtat cle = situations[i];
+            assert(executerSequenceCle(&cle, n, seq.elements, seq.nbElements) == -1 && cle == situations[j]);
+            ++nb_resolues;
+        }
+    }
+    assert(nb_resolues > 24 && c.bilan.nb_resolues == nb_resolues && c.bilan.nb_inaccessibles == nb_inaccessibles);
+    /* une table par split de cible, pas une par cible */
+    assert(c.bilan.nb_tables == n + 1);
+
+    /* requetes refusees ; l'identifiant est recopie tel quel */
+    const char* refusees[][2] = {
+        { "{\"id\":\"a\\\"b\",\"depart\":{\"b\":[\"LION\"],\"r\":[]},\"cible\":{}}",
+          "{\"id\":\"a\\\"b\",\"erreur\":\"animal inconnu\"}\n" },
+        { "{\"depart\":{\"b\":[\"OURS\",\"OURS\"],\"r\":[\"PIGEON\"]}}", "{\"erreur\":\"animal repete\"}\n" },
+        { "{\"id\":3,\"depart\":{\"b\":[\"OURS\"],\"r\":[\"PIGEON\"]}}", "{\"id\":3,\"erreur\":\"podiums incomplets\"}\n" },
+        { "{\"id\":4,\"depart\":{\"b\":[\"OURS\"],\"r\":[\"PIGEON\",\"ELEPHANT\"]}}",
+          "{\"id\":4,\"erreur\":\"depart ou cible manquant\"}\n" },
+        { "{\"id\":5,", "{\"id\":5,\"erreur\":\"requete mal formee\"}\n" },
+        { "", "{\"erreur\":\"requete mal formee\"}\n" },
+    };
+    for (int i = 0; i < 6; ++i) {
+        reponse.taille = 0;
+        assert(resoudreRequete(&c, refusees[i][0], strlen(refusees[i][0]), &reponse));
+        assert(reponse.taille == strlen(refusees[i][1]) && memcmp(reponse.donnees, refusees[i][1], reponse.taille) == 0);
+    }
+    assert(c.bilan.nb_erreurs == 6);
+    detruireContexteSolveur(&c);
+
+    /* flux : plusieurs lots sur plusieurs fils, reponses dans l'ordre des requetes (derniere ligne sans saut) */
+    const char* chemin_entree = "test_solveur.jsonl";
+    const char* chemin_sortie = "test_solveur_reponses.jsonl";
+    int nb_requetes = 3 * LIGNES_PAR_LOT_SOLVEUR * 4 + 17;
+    FILE* f = fopen(chemin_entree, "wb");
+    assert(f);
+    for (int k = 0; k < nb_requetes; ++k) {
+        ecrireSituationTest(depart, situations[(k * 7) % 24], modele.animaux);
+        ecrireSituationTest(cible, situations[(k * 5 + 3) % 24], modele.animaux);
+        fprintf(f, k + 1 < nb_requetes ? "{\"id\":%d,\"depart\":%s,\"cible\":%s}\r\n" : "{\"id\":%d,\"depart\":%s,\"cible\":%s}",
+            k, depart, cible);
+    }
+    fclose(f);
+    FILE* entree = fopen(chemin_entree, "rb");
+    FILE* sortie = fopen(chemin_sortie, "wb");
+    assert(entree && sortie);
+    ParametresSolveur parametres = { 3, 0 };
+    BilanSolveur bilan;
+    assert(resoudreFlux(&modele, &parametres, entree, sortie, &bilan) == 0);
+    fclose(entree);
+    fclose(sortie);
+    assert(bilan.nb_requetes == nb_requetes && bilan.nb_erreurs == 0);
+    assert(bilan.nb_resolues + bilan.nb_inaccessibles == nb_requetes);
+    assert(bilan.nb_tables >= n + 1 && bilan.nb_tables <= 3 * (n + 1));
+    char* texte = lireTexte(chemin_sortie);
+    assert(compterOccurrences(texte, "\n") == nb_requetes);
+    char* ligne = texte;
+    for (int k = 0; k < nb_requetes; ++k) {
+        sprintf(attendu, "{\"id\":%d,\"", k);
+        assert(strncmp(ligne, attendu, strlen(attendu)) == 0);
+        ligne = strchr(ligne, '\n') + 1;
+    }
+    free(texte);
+
+    /* entree vide : aucune reponse */
+    entree = fopen(chemin_entree, "wb");
+    fclose(entree);
+    entree = fopen(chemin_entree, "rb");
+    sortie = fopen(chemin_sortie, "wb");
+    assert(resoudreFlux(&modele, &parametres, entree, sortie, &bilan) == 0 && bilan.nb_requetes == 0);
+    fclose(entree);
+    fclose(sortie);
+    remove(chemin_entree);
+    remove(chemin_sortie);
+
+    detruireTampon(&reponse);
+    detruireSequence(&seq);
+    detruireTableDistances(&directe);
+    detruireGame(&modele);
+}
+
+/* reponses du serveur, chacune precedee de sa salle, de son client et du travailleur qui l'a produite */
+typedef struct {
+    mtx_t verrou;
+    Tampon texte;
+    const Serveur* serveur;
+} CaptureServeur;
+
+static void capturerReponse(void* contexte, int64_t client, int salle, const char* texte, size_t longueur) {
+    CaptureServeur* c = (CaptureServeur*)contexte;
+    int travailleur = -1;
+    for (int i = 0; i < c->serveur->nb_travailleurs; ++i) {
+        if (thrd_equal(thrd_current(), c->serveur->travailleurs[i].fil)) travailleur = i;
+    }
+    char entete[96];
+    int n = snprintf(entete, sizeof(entete), "[salle %d client %lld travailleur %d]\n", salle, (long long)client, travailleur);
+    mtx_lock(&c->verrou);
+    assert(ajouterTampon(&c->texte, entete, (size_t)n));
+    assert(ajouterTampon(&c->texte, texte, longueur));
+    mtx_unlock(&c->verrou);
+}
+
+/* Tests pour le serveur multi-salles */
+static void test_serveur() {
+    Serveur serveur;
+    CaptureServeur capture;
+    mtx_init(&capture.verrou, mtx_plain);
+    initTampon(&capture.texte);
+    capture.serveur = &serveur;
+    assert(initServeur(&serveur, "crazy.cfg", 2, 5, 0, capturerReponse, &capture) == 0);
+
+    /* identifiants refuses avant d'atteindre un travailleur */
+    assert(!envoyerLigneServeur(&serveur, "2147483649 ouvrir a b", 1));
+    assert(!envoyerLigneServeur(&serveur, "-1 ouvrir a b", 1));
+    assert(!envoyerLigneServeur(&serveur, "ouvrir a b", 1));
+    assert(!envoyerLigneServeur(&serveur, "", 1));
+
+    assert(envoyerLigneServeur(&serveur, "1 ouvrir alice bob", 7));
+    assert(envoyerLigneServeur(&serveur, "2 ouvrir carol dave", 8));
+    assert(envoyerLigneServeur(&serveur, "1 ouvrir x y", 7));
+    assert(envoyerLigneServeur(&serveur, "3 alice KI", 9));
+    assert(envoyerLigneServeur(&serveur, "2147483647 fermer", 9));
+    assert(envoyerLigneServeur(&serveur, "1 fermer", 7));
+    /* la salle 2 est fermee a l'arret, sans client */
+    arreterServeur(&serveur);
+    assert(ajouterTampon(&capture.texte, "", 1));
+    const char* texte = capture.texte.donnees;
+
+    /* chaque salle est traitee par le travailleur de rang id % nb_travailleurs */
+    assert(compterOccurrences(texte, "[salle 1 client 7 travailleur 1]\nKI (B->R) ") == 1);
+    assert(compterOccurrences(texte, "[salle 2 client 8 travailleur 0]\nKI (B->R) ") == 1);
+    assert(strstr(texte, "[salle 1 client 7 travailleur 1]\nLa salle 1 est deja ouverte\n"));
+    assert(strstr(texte, "[salle 3 client 9 travailleur 1]\nLa salle 3 n'existe pas\n"));
+    assert(strstr(texte, "[salle 2147483647 client 9 travailleur 1]\nLa salle 2147483647 n'existe pas\n"));
+    assert(strstr(texte, "[salle 1 client 7 travailleur 1]\nalice 0\nbob 0\n"));
+    assert(strstr(texte, "[salle 2 client -1 travailleur 0]\ncarol 0\ndave 0\n"));
+    assert(compterOccurrences(texte, "[salle ") == 7);
+
+    detruireTampon(&capture.texte);
+    mtx_destroy(&capture.verrou);
+}
+
+/* Tests pour les coups des robots arrives apres la fin de leur tour */
+static void test_serveur_robots() {
+    Serveur serveur;
+    CaptureServeur capture;
+    mtx_init(&capture.verrou, mtx_plain);
+    initTampon(&capture.texte);
+    capture.serveur = &serveur;
+    assert(initServeur(&serveur, "crazy.cfg", 1, 5, 0, capturerReponse, &capture) == 0);
+
+    /* a joue un coup optimal apres 50 ms et gagne chaque tour ; le coup de b,
+       envoye 300 ms apres le debut de son tour, arrive toujours trop tard */
+    assert(envoyerLigneServeur(&serveur, "7 ouvrir +a:8:50 +b:8:300", 1));
+    thrd_sleep(&(struct timespec){ .tv_nsec = 450000000 }, NULL);
+    assert(envoyerLigneServeur(&serveur, "7 fermer", 1));
+    arreterServeur(&serveur);
+    assert(ajouterTampon(&capture.texte, "", 1));
+    const char* texte = capture.texte.donnees;
+
+    assert(compterOccurrences(texte, "a gagne un point\n") >= 2);
+    assert(!strstr(texte, "b ne peut plus jouer"));
+    assert(!strstr(texte, "b gagne un point"));
+    assert(strstr(texte, "\nb 0\n"));
+
+    detruireTampon(&capture.texte);
+    mtx_destroy(&capture.verrou);
+}
+
+#ifdef __linux__
+static const char* const chemin_reseau_test = "test_reseau.sock";
+
+static int lancerReseauTest(void* arg) {
+    (void)arg;
+    return lancerReseau(chemin_reseau_test, "crazy.cfg", 2, 0);
+}
+
+/* connexion a la socket du frontal, en attendant qu'il ecoute */
+static int connecterReseauTest(void) {
+    struct sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, chemin_reseau_test);
+    for (int essai = 0; essai < 500; ++essai) {
+        int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        assert(fd >= 0);
+        if (connect(fd, (struct sockaddr*)&adresse, sizeof(adresse)) == 0) return fd;
+        close(fd);
+        struct timespec pause = { 0, 10 * 1000000L };
+        thrd_sleep(&pause, NULL);
+    }
+    return -1;
+}
+
+/* Tests pour le frontal reseau */
+static void test_reseau() {
+    remove(chemin_reseau_test);
+    thrd_t fil;
+    assert(thrd_create(&fil, lancerReseauTest, NULL) == thrd_success);
+
+    /* client qui ferme son sens d'ecriture aussitot ses lignes envoyees : il recoit toutes
+       ses reponses, puis la fin de flux */
+    int fd = connecterReseauTest();
+    assert(fd >= 0);
+    const char* lignes = "11 ouvrir alice bob\n12 ouvrir carol dave\n11 alice KI\nabc\n13 alice KI\n11 fermer\n12 fermer";
+    size_t envoye = 0;
+    while (envoye < strlen(lignes)) {
+        ssize_t n = send(fd, lignes + envoye, strlen(lignes) - envoye, MSG_NOSIGNAL);
+        assert(n > 0);
+        envoye += (size_t)n;
+    }
+    assert(shutdown(fd, SHUT_WR) == 0);
+    Tampon recu;
+    initTampon(&recu);
+    for (;;) {
+        struct pollfd p = { fd, POLLIN, 0 };
+        assert(poll(&p, 1, 5000) == 1);
+        char tampon[4096];
+        ssize_t n = recv(fd, tampon, sizeof(tampon), 0);
+        assert(n >= 0);
+        if (n == 0) break;
+        assert(ajouterTampon(&recu, tampon, (size_t)n));
+    }
+    close(fd);
+    assert(ajouterTampon(&recu, "", 1));
+    const char* texte = recu.donnees;
+    /* la ligne sans salle est refusee par le frontal ; la derniere ligne, sans saut de ligne, est ignoree */
+    assert(strstr(texte, "La salle -1 n'existe pas\n"));
+    assert(compterOccurrences(texte, "[salle ") == 5);
+    assert(compterOccurrences(texte, "[salle 11]\nKI (B->R) ") == 1);
+    assert(compterOccurrences(texte, "[salle 12]\nKI (B->R) ") == 1);
+    assert(strstr(texte, "[salle 13]\nLa salle 13 n'existe pas\n"));
+    /* resultats de la salle 11 (les cartes dependent de l'horloge : un point au plus en un coup) */
+    assert(strstr(texte, "\nalice 0\n") || strstr(texte, "\nalice 1\n"));
+    assert(strstr(texte, "\nbob 0\n") || strstr(texte, "\nbob 1\n"));
+    assert(!strstr(texte, "carol "));
+    detruireTampon(&recu);
+
+    /* harnais de charge : chaque ligne recoit sa reponse */
+    assert(chargeReseau(chemin_reseau_test, 4, 200) == 0);
+
+    /* arret comme sur Ctrl-C : le signal reveille la boucle sans autre evenement */
+    raise(SIGTERM);
+    int code = -1;
+    thrd_join(fil, &code);
+    assert(code == 0);
+    signal(SIGTERM, SIG_DFL);
+}
+#endif
+
+/* Tests pour le fichier de paquet projet */
+static void test_paquet() {
+    const char* chemin = "test_paquet.tmp";
+    remove(chemin);
+    Game game;
+    assert(chargerConfigGame(&game, "crazy.cfg") == 0);
+    int n = (int)game.animaux->nbElements;
+
+    Cartes generees, projetees;
+    assert(chargerPaquet(&generees, game.animaux, chemin) == 0);
+    assert(chargerPaquet(&projetees, game.animaux, chemin) == 1);
+    assert(projetees.projection != NULL && projetees.largeur == n + 1);
+    assert(nbCartes(&projetees) == nbCartes(&generees) && nbCartes(&projetees) == nbCartes(game.cartes));
+    assert(memcmp(projetees.valeurs.elements, generees.valeurs.elements,
+        sizeof(int) * (size_t)generees.valeurs.nbElements) == 0);
+    detruireCartes(&projetees);
+
+    /* un autre nombre d'animaux ou un fichier tronqu sont refuss */
+    assert(!projeterPaquet(&projetees, n + 1, chemin));
+    FILE* f = fopen(chemin, "r+b");
+    assert(f);
+    fseek(f, 0, SEEK_END);
+    long taille = ftell(f);
+    fclose(f);
+    char* contenu = malloc((size_t)taille);
+    f = fopen(chemin, "rb");
+    assert(fread(contenu, 1, (size_t)taille, f) == (size_t)taille);
+    fclose(f);
+    f = fopen(chemin, "wb");
+    fwrite(contenu, 1, (size_t)taille - sizeof(int), f);
+    fclose(f);
+    assert(!projeterPaquet(&projetees, n, chemin));
+    /* puis rcrits au chargement suivant */
+    assert(chargerPaquet(&projetees, game.animaux, chemin) == 0);
+    detruireCartes(&projetees);
+    assert(projeterPaquet(&projetees, n, chemin));
+    detruireCartes(&projetees);
+
+    free(contenu);
+    detruireCartes(&generees);
+    detruireGame(&game);
+    remove(chemin);
+}
+
+/* Tests pour la prdistribution (mmes donnes et mmes distances qu'en synchrone) */
+static void test_predistribution() {
+    char* noms[] = { "alice", "bob" };
+    Game sync, spec;
+    assert(initGameConfigGraine(&sync, "crazy.cfg", 2, noms, 21) == 0);
+    assert(initGameConfigGraine(&spec, "crazy.cfg", 2, noms, 21) == 0);
+    assert(choisirRejet(&sync, REJET_COURT) && choisirRejet(&spec, REJET_COURT));
+    Predistribution p;
+    assert(demarrerPredistribution(&p, (int)spec.animaux->nbElements, spec.commandes));
+    assert(attacherPredistribution(&spec, &p));
+
+    for (int tour = 0; tour < 300; ++tour) {
+        /* dtache puis rattache en cours de partie : la suite des donnes ne change pas */
+        if (tour == 100) detacherPredistribution(&spec);
+        if (tour == 150) assert(attacherPredistribution(&spec, &p));
+        nouveauTour(&sync);
+        nouveauTour(&spec);
+        assert(spec.cle_cible == sync.cle_cible);
+        assert(empaqueterPodiums(spec.podium_b, spec.podium_r) == empaqueterPodiums(sync.podium_b, sync.podium_r));
+        assert(spec.distance_depart == sync.distance_depart);
+        assert(distanceMinimale(&spec.distances, empaqueterPodiums(spec.podium_b, spec.podium_r)) == spec.distance_depart);
+    }
+
+    /* depart remplace pendant l'analyse (journal, instantane) : l'analyse de meme cible n'est pas adoptee */
+    int n = (int)spec.animaux->nbElements;
+    CleEtat cible = empaqueterCarte(obtenirCarte(spec.cartes, spec.cible_suivante), n);
+    int distance = distanceNaive(empaqueterCarte(obtenirCarte(spec.cartes, spec.carte_suivante), n), cible, n);
+    int autre = -1;
+    for (int64_t i = 0; i < nbCartes(spec.cartes) && autre < 0; ++i) {
+        int d = distanceNaive(empaqueterCarte(obtenirCarte(spec.cartes, i), n), cible, n);
+        if (d != distance && d != DISTANCE_INFINIE) autre = (int)i;
+    }
+    assert(autre >= 0);
+    spec.carte_suivante = sync.carte_suivante = autre;
+    sync.cible_suivante = spec.cible_suivante;
+    nouveauTour(&sync);
+    nouveauTour(&spec);
+    assert(empaqueterPodiums(spec.podium_b, spec.podium_r) == empaqueterPodiums(sync.podium_b, sync.podium_r));
+    assert(spec.distance_depart == sync.distance_depart);
+
+    /* la partie se dtache d'elle-mme  sa destruction */
+    detruireGame(&spec);
+    arreterPredistribution(&p);
+    detruireGame(&sync);
+}
+
+/* Tests pour le simulateur de tournois */
+static void test_simulation() {
+    Game modele;
+    assert(chargerConfigGame(&modele, "crazy.cfg") == 0);
+    ParametresSimulation p = { 3, 3001, 50, 3, { 0, 2, 255 }, 11 };
+    ResultatSimulation r, r2;
+    assert(simuler(&modele, &p, &r) == 0);
+    assert(r.nb_tours == 3001);
+    /* 1000 ou 1001 tours par fil : 20 parties termines chacun */
+    assert(r.nb_parties == 60);
+    int64_t longueurs = 0, optimales = 0, points = 0, victoires = 0;
+    for (int k = 0; k < TAILLE_HISTOGRAMME; ++k) {
+        longueurs += r.longueurs[k];
+        optimales += r.optimales[k];
+    }
+    assert(longueurs == r.nb_tours && optimales == r.nb_tours);
+    /* trois animaux : toutes les distances sont connues */
+    assert(r.optimales[TAILLE_HISTOGRAMME - 1] == 0);
+    for (int i = 0; i < p.nb_strategies; ++i) {
+        points += r.points[i];
+        victoires += r.victoires[i];
+    }
+    /* au plus un point par tour, aucun pour les tours redistribus */
+    assert(points > 0 && points <= r.nb_tours - r.nb_expirations);
+    assert(victoires >= r.nb_parties);
+    assert(r.points[2] > r.points[0]);
+
+    /* mme graine, mme nombre de fils : mmes rsultats */
+    assert(simuler(&modele, &p, &r2) == 0);
+    assert(memcmp(r.points, r2.points, sizeof(r.points)) == 0);
+    assert(memcmp(r.longueurs, r2.longueurs, sizeof(r.longueurs)) == 0);
+    assert(r.nb_expirations == r2.nb_expirations);
+    detruireGame(&modele);
+}
+
+/* Tests pour l'excuteur par sries (sries, blocs rpts, chanes longues) */
+static void test_executeur() {
+    static const char* codes[] = { "KI", "LO", "SO", "NI", "MA" };
+    char* noms[] = { "alice", "bob" };
+    Game game;
+    assert(initGameConfigGraine(&game, "crazy.cfg", 2, noms, 3) == 0);
+
+    enum { REPETITIONS = 20000 };
+    char* texte = malloc(2 * 8 * 2 * REPETITIONS + 8);
+    Aleatoire alea;
+    initAleatoire(&alea, 5);
+    for (int essai = 0; essai < 200; ++essai) {
+        /* un bloc alatoire (sries de 1  3) rpt, plus un reste */
+        char bloc[2 * 8 + 1];
+        int longueur = 1 + (int)aleatoireBorne(&alea, 8);
+        for (int k = 0; k < longueur; ++k) {
+            memcpy(&bloc[2 * k], codes[aleatoireBorne(&alea, 5)], 2);
+        }
+        int repetitions = 1 + (int)aleatoireBorne(&alea, essai < 20 ? REPETITIONS : 50);
+        int reste = (int)aleatoireBorne(&alea, (uint64_t)longueur);
+        char* p = texte;
+        for (int i = 0; i < repetitions; ++i, p += 2 * longueur) {
+            memcpy(p, bloc, 2 * longueur);
+        }
+        memcpy(p, bloc, 2 * reste);
+        p[2 * reste] = '\0';
+        verifierExecuteur(&game, texte);
+    }
+
+    /* deux blocs rpts  la suite : deux segments */
+    for (int essai = 0; essai < 100; ++essai) {
+        char* p = texte;
+        for (int segment = 0; segment < 2; ++segment) {
+            char bloc[2 * 4];
+            int longueur = 1 + (int)aleatoireBorne(&alea, 4);
+            for (int k = 0; k < longueur; ++k) {
+                memcpy(&bloc[2 * k], codes[aleatoireBorne(&alea, 5)], 2);
+            }
+            int repetitions = 1 + (int)aleatoireBorne(&alea, 2 * REPETITIONS);
+            for (int i = 0; i < repetitions; ++i, p += 2 * longueur) {
+                memcpy(p, bloc, 2 * longueur);
+            }
+        }
+        *p = '\0';
+        verifierExecuteur(&game, texte);
+    }
+
+    /* une longue srie de NI, puis une commande inconnue aprs une commande impossible */
+    for (int i = 0; i < 100001; ++i) memcpy(&texte[2 * i], "NI", 2);
+    texte[2 * 100001] = '\0';
+    verifierExecuteur(&game, texte);
+    verifierExecuteur(&game, "KIKIKIKIXX");
+    verifierExecuteur(&game, "SOXX");
+    verifierExecuteur(&game, "KIL");
+
+    free(texte);
+    detruireGame(&game);
+}
+
+/* Tests pour le gnrateur alatoire (reproductibilit + bornes) */
+static void test_aleatoire() {
+    Aleatoire a1, a2;
+    initAleatoire(&a1, 42);
+    initAleatoire(&a2, 42);
+    for (int i = 0; i < 100; ++i) {
+        assert(aleatoireSuivant(&a1) == aleatoireSuivant(&a2));
+    }
+
+    /* dpasse RAND_MAX : paquet de 10 animaux */
+    for (int i = 0; i < 1000; ++i) {
+        assert(aleatoireBorne(&a1, 39916800ULL) < 39916800ULL);
+    }
+
+    int* perm = shuffleAnimaux(5, &a1);
+    int vus = 0;
+    for (int i = 0; i < 5; ++i) {
+        vus |= 1 << perm[i];
+    }
+    assert(vus == 0x1F);
+    free(perm);
+}
+
+/* Tests pour la roue de minuterie (armement, expiration, annulation) */
+static void compterExpiration(void* contexte) {
+    ++*(int*)contexte;
+}
+
+static void test_minuterie() {
+    RoueMinuterie roue;
+    Echeance e1, e2;
+    int nb = 0;
+
+    initRoue(&roue, 10, 1000);
+    initEcheance(&e1, compterExpiration, &nb);
+    initEcheance(&e2, compterExpiration, &nb);
+    assert(delaiRoue(&roue, 1000) == -1);
+
+    armerEcheance(&roue, &e1, 1500);
+    armerEcheance(&roue, &e2, 1000 + 10 * NB_CRANS + 50); /* plus d'un tour de roue */
+    assert(delaiRoue(&roue, 1000) == 500);
+
+    assert(avancerRoue(&roue, 1499) == 0);
+    assert(avancerRoue(&roue, 1500) == 1 && nb == 1);
+    assert(delaiRoue(&roue, 1500) == 10 * NB_CRANS + 50 - 500);
+
+    armerEcheance(&roue, &e1, 2000);
+    annulerEcheance(&roue, &e1);
+    assert(avancerRoue(&roue, 100000) == 1 && nb == 2);
+    assert(roue.nb_armees == 0);
+
+    /* avancement dans le cran de l'echeance, avant elle : elle expire au suivant */
+    initRoue(&roue, 10, 1000);
+    armerEcheance(&roue, &e1, 1015);
+    assert(avancerRoue(&roue, 1012) == 0);
+    assert(delaiRoue(&roue, 1012) == 3);
+    assert(avancerRoue(&roue, 1016) == 1 && nb == 3);
+    assert(roue.nb_armees == 0);
+}
+
 int main(void) {
 
     test_animal();
     printf("test_animal OK\n");
+    test_arene();
+    printf("test_arene OK\n");
+    test_noms();
+    printf("test_noms OK\n");
 
+    test_vecteurtype();
+    printf("test_vecteurtype OK\n");
     test_podium();
     printf("test_podium OK\n");
 
+    test_etat();
+    printf("test_etat OK\n");
     test_joueur();
     printf("test_joueur OK\n");
 
     test_commandes();
     printf("test_commandes OK\n");
 
+    test_lot();
+    printf("test_lot OK (%s)\n", instructionsLot());
+    test_executeur();
+    printf("test_executeur OK\n");
+    test_cache();
+    printf("test_cache OK\n");
+    test_distance();
+    printf("test_distance OK\n");
+    test_robot();
+    printf("test_robot OK\n");
+    test_simulation();
+    printf("test_simulation OK\n");
+    test_predistribution();
+    printf("test_predistribution OK\n");
+    test_paquet();
+    printf("test_paquet OK\n");
+    test_journal();
+    printf("test_journal OK\n");
+    test_instantane();
+    printf("test_instantane OK\n");
+    test_rechargement();
+    printf("test_rechargement OK\n");
+    test_histogramme();
+    printf("test_histogramme OK\n");
+    test_trace();
+    printf("test_trace OK\n");
+    test_memoire();
+    printf("test_memoire OK\n");
+    test_analyses();
+    printf("test_analyses OK\n");
+    test_solveur();
+    printf("test_solveur OK\n");
+    test_serveur();
+    printf("test_serveur OK\n");
+    test_serveur_robots();
+    printf("test_serveur_robots OK\n");
+#ifdef __linux__
+    test_reseau();
+    printf("test_reseau OK\n");
+#endif
+    test_aleatoire();
+    printf("test_aleatoire OK\n");
+
+    test_minuterie();
+    printf("test_minuterie OK\n");
+
     printf("Tous les tests reussis.\n");
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+
+#include "trace.h"
+#include "minuterie.h"
+#include "vecteur.h"
+
+typedef struct {
+	uint64_t ns;
+	const char* nom;
+	char phase;
+} EvenementTrace;
+
+/* tampon circulaire d’un thread : seul son propriétaire écrit */
+typedef struct {
+	int id;
+	char nom[48];                     /* protégé par le verrou de la trace */
+	atomic_uint_fast64_t tete;        /* nombre d’événements écrits depuis le début */
+	uint64_t masque;
+	EvenementTrace evenements[];
+} FilTrace;
+
+atomic_int trace_active = 0;
+
+static mtx_t verrou_trace;           /* protège `fils` et les noms */
+static Vecteur fils;                 /* FilTrace* de chaque thread ayant tracé */
+static uint64_t capacite_trace;
+static uint64_t origine_trace;       /* maintenantNs() au démarrage */
+static atomic_uint session_trace = 0; /* change à chaque démarrage : les tampons d’une session précédente sont libérés */
+
+static thread_local FilTrace* fil_courant = NULL;
+static thread_local unsigned session_fil = 0;
+
+
+/* tampon du thread courant, créé à son premier événement */
+static FilTrace* filCourant(void) {
+	unsigned session = atomic_load_explicit(&session_trace, memory_order_acquire);
+	if (fil_courant && session_fil == session) return fil_courant;
+
+	FilTrace* f = (FilTrace*)malloc(sizeof(FilTrace) + sizeof(EvenementTrace) * (size_t)capacite_trace);
+	if (!f) return NULL;
+	atomic_init(&f->tete, 0);
+	f->masque = capacite_trace - 1;
+	mtx_lock(&verrou_trace);
+	f->id = fils.nbElements + 1;
+	snprintf(f->nom, sizeof(f->nom), "fil %d", f->id);
+	int ajoute = ajouter(&fils, f);
+	mtx_unlock(&verrou_trace);
+	if (!ajoute) {
+		free(f);
+		return NULL;
+	}
+	fil_courant = f;
+	session_fil = session;
+	return f;
+}
+
+void enregistrerTrace(const char* nom, char phase) {
+	FilTrace* f = filCourant();
+	if (!f) return;
+	uint64_t position = atomic_load_explicit(&f->tete, memory_order_relaxed);
+	EvenementTrace* e = &f->evenements[position & f->masque];
+	e->ns = maintenantNs();
+	e->nom = nom;
+	e->phase = phase;
+	atomic_store_explicit(&f->tete, position + 1, memory_order_release);
+}
+
+int demarrerTrace(int64_t capacite) {
+	if (atomic_load(&trace_active)) return 0;
+	capacite_trace = 1;
+	while ((int64_t)capacite_trace < capacite) capacite_trace *= 2;
+	mtx_init(&verrou_trace, mtx_plain);
+	initVecteur(&fils, 8);
+	origine_trace = maintenantNs();
+	atomic_fetch_add(&session_trace, 1);
+	atomic_store(&trace_active, 1);
+	return 1;
+}
+
+void nommerFilTrace(const char* nom) {
+	if (!atomic_load_explicit(&trace_active, memory_order_relaxed)) return;
+	FilTrace* f = filCourant();
+	if (!f) return;
+	mtx_lock(&verrou_trace);
+	snprintf(f->nom, sizeof(f->nom), "%s", nom);
+	mtx_unlock(&verrou_trace);
+}
+
+/* le nom d’un thread est libre : guillemets et barres obliques inverses sont échappés */
+static void ecrireChaineJson(FILE* f, const char* texte) {
+	fputc('"', f);
+	for (const char* c = texte; *c; ++c) {
+		if (*c == '"' || *c == '\\') fputc('\\', f);
+		if ((unsigned char)*c >= 0x20) fputc(*c, f);
+	}
+	fputc('"', f);
+}
+
+int ecrireTrace(const char* chemin) {
+	if (!atomic_load(&trace_active)) return 0;
+	FILE* sortie = fopen(chemin, "w");
+	if (!sortie) return 0;
+
+	fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", sortie);
+	int premier = 1;
+	mtx_lock(&verrou_trace);
+	for (int i = 0; i < fils.nbElements; ++i) {
+		FilTrace* f = (FilTrace*)obtenir(&fils, i);
+		fprintf(sortie, "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":",
+			premier ? "" : ",", f->id);
+		ecrireChaineJson(sortie, f->nom);
+		fputs("}}", sortie);
+		premier = 0;
+
+		/* événements encore présents dans le tampon, du plus ancien au plus récent */
+		uint64_t fin = atomic_load_explicit(&f->tete, memory_order_acquire);
+		uint64_t capacite = f->masque + 1;
+		uint64_t debut = fin > capacite ? fin - capacite : 0;
+		for (uint64_t p = debut; p < fin; ++p) {
+			const EvenementTrace* e = &f->evenements[p & f->masque];
+			uint64_t ns = e->ns > origine_trace ? e->ns - origine_trace : 0;
+			fprintf(sortie, ",\n{\"name\":\"%s\",\"ph\":\"%c\",\"pid\":1,\"tid\":%d,\"ts\":%llu.%03u}",
+				e->nom, e->phase, f->id, (unsigned long long)(ns / 1000), (unsigned)(ns % 1000));
+		}
+	}
+	mtx_unlock(&verrou_trace);
+	fputs("\n]}\n", sortie);
+	return fclose(sortie) == 0;
+}
+
+void arreterTrace(void) {
+	if (!atomic_load(&trace_active)) return;
+	atomic_store(&trace_active, 0);
+	for (int i = 0; i < fils.nbElements; ++i) {
+		free(obtenir(&fils, i));
+	}
+	detruireVecteur(&fils);
+	mtx_destroy(&verrou_trace);
+}
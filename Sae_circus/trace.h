@@ -0,0 +1,88 @@
+/**
+ * @file trace.h
+ * @brief Traces d’exécution au format Chrome (chrome://tracing, Perfetto).
+ *
+ * En mode trace, chaque thread enregistre des événements de début et de fin
+ * (`debutTrace` / `finTrace`) dans son propre tampon circulaire : l’écriture
+ * n’a ni verrou ni allocation, seul le thread propriétaire écrit et il publie sa
+ * position par une opération atomique. Quand le tampon est plein, les événements
+ * les plus anciens sont remplacés. `ecrireTrace` écrit ensuite tous les tampons
+ * en JSON, un fil d’exécution par thread, nommé par `nommerFilTrace`.
+ *
+ * Hors mode trace, un point de trace ne coûte qu’une lecture atomique.
+ *
+ * Les noms d’événements doivent rester valides jusqu’à l’écriture (chaînes
+ * littérales) et ne pas contenir de caractère à échapper.
+ */
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdint.h>
+
+/** @brief Nombre d’événements conservés par thread, par défaut. */
+enum { CAPACITE_TRACE_DEFAUT = 1 << 16 };
+
+/** @brief `1` pendant le mode trace (à ne lire qu’à travers `debutTrace` et `finTrace`). */
+extern atomic_int trace_active;
+
+/**
+ * @brief Enregistre un événement dans le tampon du thread courant.
+ *
+ * @param[in] nom Nom de l’événement.
+ * @param[in] phase `'B'` pour un début, `'E'` pour une fin.
+ */
+void enregistrerTrace(const char* nom, char phase);
+
+/**
+ * @brief Marque le début d’une tâche du thread courant.
+ *
+ * @param[in] nom Nom de la tâche (chaîne littérale).
+ */
+static inline void debutTrace(const char* nom) {
+    if (atomic_load_explicit(&trace_active, memory_order_relaxed)) enregistrerTrace(nom, 'B');
+}
+
+/**
+ * @brief Marque la fin de la dernière tâche commencée par le thread courant.
+ *
+ * @param[in] nom Nom de la tâche (le même qu’au début).
+ */
+static inline void finTrace(const char* nom) {
+    if (atomic_load_explicit(&trace_active, memory_order_relaxed)) enregistrerTrace(nom, 'E');
+}
+
+/**
+ * @brief Démarre le mode trace.
+ *
+ * À appeler avant de démarrer les threads à tracer.
+ *
+ * @param[in] capacite Nombre d’événements conservés par thread (arrondi à une puissance de deux).
+ * @return `1` si le mode trace démarre, `0` s’il est déjà actif.
+ */
+int demarrerTrace(int64_t capacite);
+
+/**
+ * @brief Nomme le thread courant dans la trace (sans effet hors mode trace).
+ *
+ * @param[in] nom Nom du thread (copié, tronqué à 47 octets).
+ */
+void nommerFilTrace(const char* nom);
+
+/**
+ * @brief Écrit les événements conservés au format JSON de Chrome.
+ *
+ * À appeler quand les threads tracés sont arrêtés ou au repos : un événement en
+ * cours d’écriture par un autre thread n’est pas écrit.
+ *
+ * @param[in] chemin Fichier à écrire.
+ * @return `1` si l’écriture réussit, `0` sinon.
+ */
+int ecrireTrace(const char* chemin);
+
+/**
+ * @brief Quitte le mode trace et libère les tampons.
+ *
+ * À appeler quand plus aucun thread ne trace.
+ */
+void arreterTrace(void);
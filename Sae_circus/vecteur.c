@@ -1,5 +1,6 @@
 #include <assert.h> 
 #include <stdlib.h> 
+#include <string.h>
 #include "vecteur.h"
 
 int initVecteur(Vecteur* v, int capacite) {
@@ -39,8 +40,7 @@ void modifier(Vecteur* v, int i, void* it) {
 
 void supprimer(Vecteur* v, int i) {
 	assert(i >= 0 && i < v->nbElements);
-	for (++i; i < v->nbElements; ++i)
-		v->elements[i - 1] = v->elements[i];
+	memmove(v->elements + i, v->elements + i + 1, sizeof(void*) * (v->nbElements - i - 1));
 	--v->nbElements;
 }
 
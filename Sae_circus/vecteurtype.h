@@ -0,0 +1,121 @@
+/**
+ * @file vecteurtype.h
+ * @brief Vecteurs typés, générés par macro, qui stockent leurs éléments par valeur.
+ *
+ * `VECTEUR_DEF(VecteurInt, int)` définit le type `VecteurInt` et les fonctions
+ * `initVecteurInt`, `reserverVecteurInt`, `ajouterVecteurInt`, etc. Contrairement
+ * à `Vecteur`, aucun élément n’est alloué séparément : les éléments sont contigus
+ * dans `elements`, et les tailles sont sur 64 bits.
+ *
+ * Un pointeur obtenu par `obtenir<Nom>` reste valide tant que le vecteur n’est
+ * ni agrandi ni modifié par une suppression.
+ *
+ * La mémoire des éléments est comptée au sous-système du vecteur (`memoire.h`),
+ * `MEMOIRE_AUTRE` sauf initialisation par `initPour<Nom>`.
+ */
+
+#pragma once
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "memoire.h"
+
+/**
+ * @brief Définit un vecteur typé `Nom` d’éléments de type `T` et ses fonctions.
+ *
+ * Fonctions générées (toutes `static inline`) :
+ * - `int init<Nom>(Nom* v, int64_t capacite)` : vecteur vide (capacité 0 permise) ;
+ * - `int initPour<Nom>(Nom* v, int64_t capacite, SousSysteme s)` : idem, mémoire comptée à `s` ;
+ * - `int reserver<Nom>(Nom* v, int64_t capacite)` : garantit une capacité minimale ;
+ * - `int ajouter<Nom>(Nom* v, T it)` : ajoute en fin ;
+ * - `int ajouterPlusieurs<Nom>(Nom* v, const T* src, int64_t n)` : ajoute `n` éléments en fin ;
+ * - `T* obtenir<Nom>(const Nom* v, int64_t i)` : adresse du i-ème élément ;
+ * - `void supprimer<Nom>(Nom* v, int64_t i)` : supprime en conservant l’ordre (`memmove`) ;
+ * - `void supprimerEchange<Nom>(Nom* v, int64_t i)` : supprime en O(1) en y plaçant le dernier ;
+ * - `void vider<Nom>(Nom* v)` : supprime tous les éléments sans rendre la mémoire ;
+ * - `void detruire<Nom>(Nom* v)` : libère la mémoire.
+ *
+ * Les fonctions qui peuvent allouer retournent `0` en cas de manque de mémoire et `1` sinon.
+ */
+#define VECTEUR_DEF(Nom, T)                                                         \
+typedef struct {                                                                    \
+    T* elements;         /**< Tableau (dynamique) de taille `capacite`. */         \
+    int64_t nbElements;  /**< Nombre d’éléments présents. */                       \
+    int64_t capacite;    /**< Nombre d’éléments pouvant être stockés sans réallocation. */ \
+    SousSysteme sous_systeme; /**< Sous-système auquel `elements` est compté. */   \
+} Nom;                                                                              \
+                                                                                    \
+static inline int reserver##Nom(Nom* v, int64_t capacite) {                         \
+    if (capacite <= v->capacite) return 1;                                          \
+    int64_t nouvelle = v->capacite > 0 ? v->capacite : 1;                           \
+    while (nouvelle < capacite) nouvelle *= 2;                                      \
+    T* tab = (T*)reallouerMemoire(v->sous_systeme, v->elements,                     \
+        sizeof(T) * (size_t)v->capacite, sizeof(T) * (size_t)nouvelle);             \
+    if (tab == NULL) return 0;                                                      \
+    v->elements = tab;                                                              \
+    v->capacite = nouvelle;                                                         \
+    return 1;                                                                       \
+}                                                                                   \
+                                                                                    \
+static inline int initPour##Nom(Nom* v, int64_t capacite, SousSysteme s) {          \
+    assert(capacite >= 0);                                                          \
+    v->elements = NULL;                                                             \
+    v->nbElements = 0;                                                              \
+    v->capacite = 0;                                                                \
+    v->sous_systeme = s;                                                            \
+    return reserver##Nom(v, capacite);                                              \
+}                                                                                   \
+                                                                                    \
+static inline int init##Nom(Nom* v, int64_t capacite) {                             \
+    return initPour##Nom(v, capacite, MEMOIRE_AUTRE);                               \
+}                                                                                   \
+                                                                                    \
+static inline int ajouter##Nom(Nom* v, T it) {                                      \
+    if (v->nbElements == v->capacite && !reserver##Nom(v, v->nbElements + 1))       \
+        return 0;                                                                   \
+    v->elements[v->nbElements++] = it;                                              \
+    return 1;                                                                       \
+}                                                                                   \
+                                                                                    \
+static inline int ajouterPlusieurs##Nom(Nom* v, const T* src, int64_t n) {          \
+    assert(n >= 0);                                                                 \
+    if (n == 0) return 1;                                                           \
+    if (!reserver##Nom(v, v->nbElements + n)) return 0;                             \
+    memcpy(v->elements + v->nbElements, src, sizeof(T) * (size_t)n);                \
+    v->nbElements += n;                                                             \
+    return 1;                                                                       \
+}                                                                                   \
+                                                                                    \
+static inline T* obtenir##Nom(const Nom* v, int64_t i) {                            \
+    assert(i >= 0 && i < v->nbElements);                                            \
+    return &v->elements[i];                                                         \
+}                                                                                   \
+                                                                                    \
+static inline void supprimer##Nom(Nom* v, int64_t i) {                              \
+    assert(i >= 0 && i < v->nbElements);                                            \
+    memmove(v->elements + i, v->elements + i + 1,                                   \
+        sizeof(T) * (size_t)(v->nbElements - i - 1));                               \
+    --v->nbElements;                                                                \
+}                                                                                   \
+                                                                                    \
+static inline void supprimerEchange##Nom(Nom* v, int64_t i) {                       \
+    assert(i >= 0 && i < v->nbElements);                                            \
+    v->elements[i] = v->elements[--v->nbElements];                                  \
+}                                                                                   \
+                                                                                    \
+static inline void vider##Nom(Nom* v) {                                             \
+    v->nbElements = 0;                                                              \
+}                                                                                   \
+                                                                                    \
+static inline void detruire##Nom(Nom* v) {                                          \
+    libererMemoire(v->sous_systeme, v->elements, sizeof(T) * (size_t)v->capacite);  \
+    v->elements = NULL;                                                             \
+    v->nbElements = 0;                                                              \
+    v->capacite = 0;                                                                \
+}
+
+/** @brief Vecteur d’entiers (podiums, cartes). */
+VECTEUR_DEF(VecteurInt, int)